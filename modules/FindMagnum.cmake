@@ -62,6 +62,8 @@
 #  MAGNUM_BUILD_DEPRECATED      - Defined if compiled with deprecated APIs
 #   included
 #  MAGNUM_BUILD_STATIC          - Defined if compiled as static libraries
+#  MAGNUM_BUILD_SIMD            - Defined if compiled with SIMD implementation
+#   of Math operations
 #  MAGNUM_TARGET_GLES           - Defined if compiled for OpenGL ES
 #  MAGNUM_TARGET_GLES2          - Defined if compiled for OpenGL ES 2.0
 #  MAGNUM_TARGET_GLES3          - Defined if compiled for OpenGL ES 3.0
@@ -140,6 +142,10 @@ string(FIND "${_magnumConfigure}" "#define MAGNUM_BUILD_STATIC" _BUILD_STATIC)
 if(NOT _BUILD_STATIC EQUAL -1)
     set(MAGNUM_BUILD_STATIC 1)
 endif()
+string(FIND "${_magnumConfigure}" "#define MAGNUM_BUILD_SIMD" _BUILD_SIMD)
+if(NOT _BUILD_SIMD EQUAL -1)
+    set(MAGNUM_BUILD_SIMD 1)
+endif()
 string(FIND "${_magnumConfigure}" "#define MAGNUM_TARGET_GLES" _TARGET_GLES)
 if(NOT _TARGET_GLES EQUAL -1)
     set(MAGNUM_TARGET_GLES 1)
@@ -28,9 +28,12 @@
  * @brief Class Magnum::AbstractResourceLoader
  */
 
+#include <chrono>
+#include <limits>
 #include <string>
 
 #include "ResourceManager.h"
+#include "Implementation/ResourceLoadQueue.h"
 
 namespace Magnum {
 
@@ -60,6 +63,42 @@ resource was not found.
 
 You can also implement name() to provide meaningful names for resource keys.
 
+@section AbstractResourceLoader-async Asynchronous loading
+
+Instead of loading the data directly in doLoad(), you can pass a job to
+loadAsync(). The job is executed on worker thread and returns function which
+is then executed on the thread calling update(), which is where set() should
+be called and where e.g. OpenGL objects can be created. If the job returns
+empty function, the resource is marked as not found. The job itself must not
+access the loader or the manager.
+@code
+class TextureResourceLoader: public AbstractResourceLoader<Texture2D> {
+    void doLoad(ResourceKey key) override {
+        const std::string filename = name(key);
+        loadAsync(key, [this, key, filename]() -> std::function<void()> {
+            // Read and decode the file on worker thread...
+            std::shared_ptr<Trade::ImageData2D> image = ...;
+            if(!image) return nullptr;
+
+            // ... and upload it on the main thread
+            return [this, key, image]() {
+                Texture2D* texture = new Texture2D;
+                texture->setImage(0, TextureFormat::RGBA8, *image);
+                set(key, texture, ResourceDataState::Final, ResourcePolicy::ReferenceCounted);
+            };
+        });
+    }
+};
+@endcode
+
+Then call update() every frame with a time budget to limit how much time is
+spent finishing the loads. Queued jobs are executed in order of reference
+count of the resources, so the resources needed by many objects are loaded
+first, and jobs of resources which are not referenced anymore are cancelled.
+@code
+manager.loader<Texture2D>()->update(0.002f);
+@endcode
+
 Example implementation for synchronous mesh loader:
 @code
 class MeshResourceLoader: public AbstractResourceLoader<Mesh> {
@@ -101,7 +140,7 @@ template<class T> class AbstractResourceLoader {
     friend class Implementation::ResourceManagerData<T>;
 
     public:
-        explicit AbstractResourceLoader(): manager(nullptr), _requestedCount(0), _loadedCount(0), _notFoundCount(0) {}
+        explicit AbstractResourceLoader(): manager(nullptr), _requestedCount(0), _loadedCount(0), _notFoundCount(0), _cancelledCount(0) {}
 
         virtual ~AbstractResourceLoader();
 
@@ -128,6 +167,39 @@ template<class T> class AbstractResourceLoader {
          */
         std::size_t loadedCount() const { return _loadedCount; }
 
+        /**
+         * @brief Count of cancelled resources
+         *
+         * Count of resources requested by calling loadAsync(), but cancelled
+         * in update() because nothing referenced them anymore.
+         */
+        std::size_t cancelledCount() const { return _cancelledCount; }
+
+        /**
+         * @brief Count of pending asynchronous loads
+         *
+         * Count of jobs passed to loadAsync() which weren't yet finished in
+         * update().
+         */
+        std::size_t pendingCount() const { return _queue.pendingCount(); }
+
+        /** @brief Count of worker threads for asynchronous loading */
+        UnsignedInt workerCount() const { return _queue.workerCount(); }
+
+        /**
+         * @brief Set count of worker threads for asynchronous loading
+         * @return Reference to self (for method chaining)
+         *
+         * Waits for currently running jobs to finish. If set to `0`, the jobs
+         * are executed directly in loadAsync(), finishing the loads is still
+         * done in update(). Default is `1`. The workers are started on first
+         * call to loadAsync().
+         */
+        AbstractResourceLoader<T>& setWorkerCount(UnsignedInt count) {
+            _queue.setWorkerCount(count);
+            return *this;
+        }
+
         /**
          * @brief %Resource name corresponding to given key
          *
@@ -149,20 +221,36 @@ template<class T> class AbstractResourceLoader {
          */
         void load(ResourceKey key);
 
+        /**
+         * @brief Finish asynchronous loads
+         * @param timeBudget    Max time spent in seconds
+         * @return Count of finished loads
+         *
+         * Cancels queued jobs of resources which are not referenced anymore
+         * and updates priorities of the rest, then executes completion
+         * functions of finished jobs until @p timeBudget is exceeded. At least
+         * one completion is executed, if available. Should be called
+         * periodically from the thread which owns the resource manager.
+         * @see loadAsync(), cancelledCount(), pendingCount()
+         */
+        std::size_t update(Float timeBudget = std::numeric_limits<Float>::infinity());
+
     protected:
         /**
          * @brief Set loaded resource to resource manager
          *
          * Also increments count of loaded resources. Parameter @p state must
          * be either @ref ResourceDataState::Mutable or @ref ResourceDataState::Final.
-         * See @ref ResourceManager::set() for more information.
+         * The @p size is memory used by the resource in bytes, needed for
+         * @ref ResourcePolicy::Cached resources to be evicted properly. See
+         * @ref ResourceManager::set() for more information.
          * @see loadedCount()
          */
-        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy);
+        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0);
 
         /** @overload */
-        template<class U> void set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy) {
-            set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy);
+        template<class U> void set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy, size);
         }
 
         /**
@@ -189,6 +277,19 @@ template<class T> class AbstractResourceLoader {
          */
         void setNotFound(ResourceKey key);
 
+        /**
+         * @brief Load resource asynchronously
+         * @param key       %Resource key
+         * @param job       Function executed on worker thread. Returns
+         *      function executed in update() or empty function if the
+         *      resource was not found.
+         *
+         * Meant to be called from doLoad(). See
+         * @ref AbstractResourceLoader-async "class documentation" for more
+         * information.
+         */
+        void loadAsync(ResourceKey key, std::function<std::function<void()>()> job);
+
     #ifndef DOXYGEN_GENERATING_OUTPUT
     private:
     #else
@@ -209,10 +310,14 @@ template<class T> class AbstractResourceLoader {
         virtual void doLoad(ResourceKey key) = 0;
 
     private:
+        void cancel(ResourceKey key);
+
         Implementation::ResourceManagerData<T>* manager;
         std::size_t _requestedCount,
             _loadedCount,
-            _notFoundCount;
+            _notFoundCount,
+            _cancelledCount;
+        Implementation::ResourceLoadQueue _queue;
 };
 
 template<class T> AbstractResourceLoader<T>::~AbstractResourceLoader() {
@@ -224,22 +329,58 @@ template<class T> std::string AbstractResourceLoader<T>::doName(ResourceKey) con
 template<class T> void AbstractResourceLoader<T>::load(ResourceKey key) {
     ++_requestedCount;
     /** @todo What policy for loading resources? */
-    manager->set(key, nullptr, ResourceDataState::Loading, ResourcePolicy::Resident);
+    manager->set(key, nullptr, ResourceDataState::Loading, ResourcePolicy::Resident, 0);
 
     doLoad(key);
 }
 
-template<class T> void AbstractResourceLoader<T>::set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy) {
+template<class T> void AbstractResourceLoader<T>::set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size) {
     CORRADE_ASSERT(state == ResourceDataState::Mutable || state == ResourceDataState::Final,
         "AbstractResourceLoader::set(): state must be either Mutable or Final", );
     ++_loadedCount;
-    manager->set(key, data, state, policy);
+    manager->set(key, data, state, policy, size);
 }
 
 template<class T> inline void AbstractResourceLoader<T>::setNotFound(ResourceKey key) {
     ++_notFoundCount;
     /** @todo What policy for notfound resources? */
-    manager->set(key, nullptr, ResourceDataState::NotFound, ResourcePolicy::Resident);
+    manager->set(key, nullptr, ResourceDataState::NotFound, ResourcePolicy::Resident, 0);
+}
+
+template<class T> void AbstractResourceLoader<T>::loadAsync(const ResourceKey key, std::function<std::function<void()>()> job) {
+    _queue.push(key, manager->referenceCount(key), std::move(job));
+}
+
+template<class T> std::size_t AbstractResourceLoader<T>::update(const Float timeBudget) {
+    /* Prioritize by reference count, cancel jobs of unreferenced resources */
+    for(const ResourceKey key: _queue.reprioritize([this](ResourceKey key) {
+        return manager->referenceCount(key);
+    })) cancel(key);
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    std::size_t count = 0;
+    ResourceKey key;
+    std::function<void()> completion;
+    while(_queue.pop(key, completion)) {
+        ++count;
+
+        /* The resource is not needed anymore */
+        if(!manager->referenceCount(key)) cancel(key);
+        else if(!completion) setNotFound(key);
+        else completion();
+
+        if(std::chrono::duration<Float>(std::chrono::high_resolution_clock::now() - start).count() >= timeBudget)
+            break;
+    }
+
+    return count;
+}
+
+template<class T> void AbstractResourceLoader<T>::cancel(const ResourceKey key) {
+    ++_cancelledCount;
+
+    /* Remove the resource, so it gets requested again on next get() */
+    manager->remove(key);
 }
 
 }
@@ -87,4 +87,39 @@ Containers::Array<unsigned char> AbstractImporter::data() {
     return doData();
 }
 
+std::size_t AbstractImporter::dataSize() const {
+    CORRADE_ASSERT(features() & Feature::Stream,
+        "Audio::AbstractImporter::dataSize(): feature not supported", {});
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::dataSize(): no file opened", {});
+    return doDataSize();
+}
+
+std::size_t AbstractImporter::doDataSize() const {
+    CORRADE_ASSERT(false, "Audio::AbstractImporter::dataSize(): feature advertised but not implemented", {});
+    return {};
+}
+
+std::size_t AbstractImporter::read(Containers::ArrayReference<unsigned char> buffer) {
+    CORRADE_ASSERT(features() & Feature::Stream,
+        "Audio::AbstractImporter::read(): feature not supported", {});
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::read(): no file opened", {});
+    return doRead(buffer);
+}
+
+std::size_t AbstractImporter::doRead(Containers::ArrayReference<unsigned char>) {
+    CORRADE_ASSERT(false, "Audio::AbstractImporter::read(): feature advertised but not implemented", {});
+    return {};
+}
+
+void AbstractImporter::seek(const std::size_t position) {
+    CORRADE_ASSERT(features() & Feature::Stream,
+        "Audio::AbstractImporter::seek(): feature not supported", );
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::seek(): no file opened", );
+    doSeek(position);
+}
+
+void AbstractImporter::doSeek(std::size_t) {
+    CORRADE_ASSERT(false, "Audio::AbstractImporter::seek(): feature advertised but not implemented", );
+}
+
 }}
@@ -28,6 +28,7 @@
  * @brief Class Magnum::Audio::AbstractImporter
  */
 
+#include <Containers/EnumSet.h>
 #include <PluginManager/AbstractPlugin.h>
 
 #include "Magnum.h"
@@ -46,7 +47,9 @@ importer plugins.
 
 Plugin implements function doFeatures(), doIsOpened(), one of or both
 doOpenData() and doOpenFile() functions, function doClose() and data access
-functions doFormat(), doFrequency() and doData().
+functions doFormat(), doFrequency() and doData(). If @ref Feature::Stream is
+supported, the plugin also implements streaming functions doDataSize(),
+doRead() and doSeek().
 
 You don't need to do most of the redundant sanity checks, these things are
 checked by the implementation:
@@ -55,11 +58,13 @@ checked by the implementation:
     was closed, function doClose() is called only if there is any file opened.
 -   Function doOpenData() is called only if @ref Feature::OpenData is
     supported.
+-   Functions doDataSize(), doRead() and doSeek() are called only if
+    @ref Feature::Stream is supported.
 -   All `do*()` implementations working on opened file are called only if
     there is any file opened.
 */
 class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractPlugin {
-    CORRADE_PLUGIN_INTERFACE("cz.mosra.magnum.Audio.AbstractImporter/0.1")
+    CORRADE_PLUGIN_INTERFACE("cz.mosra.magnum.Audio.AbstractImporter/0.2")
 
     public:
         /**
@@ -69,7 +74,13 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractPlugin
          */
         enum class Feature: UnsignedByte {
             /** Opening files from raw data using openData() */
-            OpenData = 1 << 0
+            OpenData = 1 << 0,
+
+            /**
+             * Decoding the data in chunks using read() and seek()
+             * @see @ref Audio-AbstractImporter-streaming
+             */
+            Stream = 1 << 1
         };
 
         /**
@@ -121,11 +132,62 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractPlugin
         /** @brief Sample frequency */
         UnsignedInt frequency() const;
 
-        /** @brief Sample data */
+        /**
+         * @brief Sample data
+         *
+         * Decodes the whole file at once.
+         * @see @ref read()
+         */
         Containers::Array<unsigned char> data();
 
         /*@}*/
 
+        /**
+         * @{ @name Streaming
+         *
+         * @anchor Audio-AbstractImporter-streaming
+         * Available only if @ref Feature::Stream is supported. Instead of
+         * decoding the whole file at once with @ref data(), the data can be
+         * decoded in chunks of given size on demand, so the playback can start
+         * immediately and the memory usage stays bounded regardless of file
+         * length.
+         */
+
+        /**
+         * @brief Size of decoded sample data
+         *
+         * Size of the whole data in bytes, i.e. the same as size of array
+         * returned by @ref data().
+         * @see @ref features()
+         */
+        std::size_t dataSize() const;
+
+        /**
+         * @brief Decode next chunk of sample data
+         * @param buffer    Buffer to decode the data into
+         * @return Count of bytes written into the buffer
+         *
+         * Decodes at most `buffer.size()` bytes, always whole samples for all
+         * channels, and advances the read position by the returned amount.
+         * Returns `0` if at the end of the data or if the buffer is too small
+         * to contain single sample for all channels.
+         * @see @ref features(), @ref seek()
+         */
+        std::size_t read(Containers::ArrayReference<unsigned char> buffer);
+
+        /**
+         * @brief Seek to given position in decoded data
+         * @param position  Position in bytes
+         *
+         * The position is rounded down to whole samples for all channels and
+         * clamped to @ref dataSize(). Calling `seek(0)` rewinds to the
+         * beginning, which is useful e.g. for looping.
+         * @see @ref features(), @ref read()
+         */
+        void seek(std::size_t position);
+
+        /*@}*/
+
     #ifndef DOXYGEN_GENERATING_OUTPUT
     private:
     #else
@@ -159,8 +221,19 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractPlugin
 
         /** @brief Implementation for data() */
         virtual Containers::Array<unsigned char> doData() = 0;
+
+        /** @brief Implementation for dataSize() */
+        virtual std::size_t doDataSize() const;
+
+        /** @brief Implementation for read() */
+        virtual std::size_t doRead(Containers::ArrayReference<unsigned char> buffer);
+
+        /** @brief Implementation for seek() */
+        virtual void doSeek(std::size_t position);
 };
 
+CORRADE_ENUMSET_OPERATORS(AbstractImporter::Features)
+
 }}
 
 #endif
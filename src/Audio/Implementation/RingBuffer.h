@@ -0,0 +1,98 @@
+#ifndef Magnum_Audio_Implementation_RingBuffer_h
+#define Magnum_Audio_Implementation_RingBuffer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <Containers/Array.h>
+
+#include "Magnum.h"
+
+namespace Magnum { namespace Audio { namespace Implementation {
+
+/* Lock-free ring buffer for single producer and single consumer thread. The
+   positions are increasing indefinitely and masked on access, so the buffer
+   can be completely full. Capacity is rounded up to power of two. */
+class RingBuffer {
+    public:
+        explicit RingBuffer(std::size_t capacity): _data(roundUp(capacity)), _writePosition(0), _readPosition(0) {}
+
+        std::size_t capacity() const { return _data.size(); }
+
+        /* Consumer side */
+        std::size_t readAvailable() const {
+            return _writePosition.load(std::memory_order_acquire) - _readPosition.load(std::memory_order_relaxed);
+        }
+
+        /* Copies at most out.size() bytes, returns count of copied bytes */
+        std::size_t read(Containers::ArrayReference<unsigned char> out) {
+            const std::size_t position = _readPosition.load(std::memory_order_relaxed);
+            const std::size_t size = std::min(out.size(), _writePosition.load(std::memory_order_acquire) - position);
+            const std::size_t offset = position & (_data.size() - 1);
+            const std::size_t first = std::min(size, _data.size() - offset);
+            std::memcpy(out.begin(), _data.begin() + offset, first);
+            std::memcpy(out.begin() + first, _data.begin(), size - first);
+            _readPosition.store(position + size, std::memory_order_release);
+            return size;
+        }
+
+        /* Producer side */
+        std::size_t writeAvailable() const {
+            return _data.size() - (_writePosition.load(std::memory_order_relaxed) - _readPosition.load(std::memory_order_acquire));
+        }
+
+        /* Largest contiguous free region, fill it and then call commit() to
+           make the data available to the consumer */
+        Containers::ArrayReference<unsigned char> writeRegion() {
+            const std::size_t position = _writePosition.load(std::memory_order_relaxed);
+            const std::size_t offset = position & (_data.size() - 1);
+            return {_data.begin() + offset, std::min(writeAvailable(), _data.size() - offset)};
+        }
+
+        void commit(std::size_t size) {
+            _writePosition.store(_writePosition.load(std::memory_order_relaxed) + size, std::memory_order_release);
+        }
+
+        /* Neither side may access the buffer during this */
+        void clear() {
+            _writePosition.store(0, std::memory_order_relaxed);
+            _readPosition.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        static std::size_t roundUp(std::size_t capacity) {
+            std::size_t size = 1;
+            while(size < capacity) size <<= 1;
+            return size;
+        }
+
+        Containers::Array<unsigned char> _data;
+        std::atomic<std::size_t> _writePosition, _readPosition;
+};
+
+}}}
+
+#endif
@@ -42,8 +42,8 @@ namespace Magnum { namespace Audio {
 /**
 @brief %Source
 
-Manages positional audio source.
-@todo Expose convenient API for buffer queuing
+Manages positional audio source. For playing long sounds using queued buffers
+see @ref Stream.
 */
 class MAGNUM_AUDIO_EXPORT Source {
     public:
@@ -0,0 +1,219 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Stream.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <Utility/Assert.h>
+
+#include "Audio/AbstractImporter.h"
+#include "Audio/Implementation/RingBuffer.h"
+
+namespace Magnum { namespace Audio {
+
+struct Stream::Decoder {
+    explicit Decoder(std::size_t capacity): ring(capacity), looping(false), running(false), finished(false) {}
+
+    void run(AbstractImporter& importer);
+
+    Implementation::RingBuffer ring;
+    std::atomic<bool> looping, running, finished;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::thread thread;
+};
+
+void Stream::Decoder::run(AbstractImporter& importer) {
+    while(running.load(std::memory_order_acquire)) {
+        /* All reads and writes are whole samples and the capacity is power of
+           two, so any nonempty region can contain at least one sample */
+        const Containers::ArrayReference<unsigned char> region = ring.writeRegion();
+
+        /* Ring buffer is full, wait until the main thread consumes something.
+           The notification is sent without holding the lock, so it can get
+           lost, the timeout makes sure it doesn't wait forever. */
+        if(region.empty()) {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait_for(lock, std::chrono::milliseconds(10), [this]() {
+                return !running.load(std::memory_order_acquire) || ring.writeAvailable();
+            });
+            continue;
+        }
+
+        if(const std::size_t size = importer.read(region)) {
+            ring.commit(size);
+            continue;
+        }
+
+        /* End of data */
+        if(looping.load(std::memory_order_relaxed) && importer.dataSize()) {
+            importer.seek(0);
+            continue;
+        }
+
+        finished.store(true, std::memory_order_release);
+        break;
+    }
+}
+
+namespace {
+    std::size_t sampleSize(const Buffer::Format format) {
+        switch(format) {
+            case Buffer::Format::Mono8: return 1;
+            case Buffer::Format::Mono16:
+            case Buffer::Format::Stereo8: return 2;
+            case Buffer::Format::Stereo16: return 4;
+        }
+
+        CORRADE_ASSERT_UNREACHABLE();
+    }
+}
+
+Stream::Stream(AbstractImporter& importer, const UnsignedInt bufferCount, const std::size_t bufferSize): _importer(importer), _buffers(bufferCount), _decoder(new Decoder(bufferCount*bufferSize*2)), _format(), _frequency(0), _state(State::Stopped) {
+    CORRADE_ASSERT(importer.isOpened(),
+        "Audio::Stream: no file opened", );
+    CORRADE_ASSERT(importer.features() & AbstractImporter::Feature::Stream,
+        "Audio::Stream: the importer doesn't support streaming", );
+    CORRADE_ASSERT(bufferCount,
+        "Audio::Stream: at least one buffer is needed", );
+
+    _format = importer.format();
+    _frequency = importer.frequency();
+
+    const std::size_t size = sampleSize(_format);
+    CORRADE_ASSERT(bufferSize >= size,
+        "Audio::Stream: buffer size must be at least one sample for all channels", );
+    _chunk = Containers::Array<unsigned char>(bufferSize/size*size);
+
+    _freeBuffers.reserve(bufferCount);
+    for(const Buffer& buffer: _buffers) _freeBuffers.push_back(buffer.id());
+}
+
+Stream::~Stream() { stop(); }
+
+bool Stream::isLooping() const {
+    return _decoder->looping.load(std::memory_order_relaxed);
+}
+
+Stream& Stream::setLooping(const bool looping) {
+    _decoder->looping.store(looping, std::memory_order_relaxed);
+    return *this;
+}
+
+bool Stream::isPlaying() const { return _state == State::Playing; }
+
+void Stream::play() {
+    if(_state == State::Playing) return;
+
+    if(!_decoder->thread.joinable()) {
+        _decoder->finished.store(false, std::memory_order_relaxed);
+        _decoder->running.store(true, std::memory_order_release);
+        _decoder->thread = std::thread(&Decoder::run, _decoder.get(), std::ref(_importer));
+    }
+
+    /* The source is started or resumed in update() */
+    _state = State::Playing;
+}
+
+void Stream::pause() {
+    if(_state != State::Playing) return;
+
+    _source.pause();
+    _state = State::Paused;
+}
+
+void Stream::stop() {
+    _source.stop();
+    stopDecoder();
+
+    /* Unqueue everything, stopped source has all buffers processed */
+    _source.setBuffer(nullptr);
+    _freeBuffers.clear();
+    for(const Buffer& buffer: _buffers) _freeBuffers.push_back(buffer.id());
+
+    _decoder->ring.clear();
+    if(_importer.isOpened()) _importer.seek(0);
+    _state = State::Stopped;
+}
+
+void Stream::stopDecoder() {
+    if(!_decoder->thread.joinable()) return;
+
+    _decoder->running.store(false, std::memory_order_release);
+    _decoder->condition.notify_one();
+    _decoder->thread.join();
+}
+
+void Stream::update() {
+    if(_state != State::Playing) return;
+
+    /* Reclaim played buffers */
+    ALint processed;
+    alGetSourcei(_source.id(), AL_BUFFERS_PROCESSED, &processed);
+    if(processed > 0) {
+        const std::size_t offset = _freeBuffers.size();
+        _freeBuffers.resize(offset + processed);
+        alSourceUnqueueBuffers(_source.id(), processed, _freeBuffers.data() + offset);
+    }
+
+    /* Refill them with decoded data, never wait for the decoder. Only whole
+       chunks are queued so the source isn't fed with tiny buffers, shorter
+       one only with the rest of the data at the end. The decoder commits
+       everything before reporting the end, so the flag is checked first. */
+    bool consumed = false;
+    while(!_freeBuffers.empty()) {
+        const bool finished = _decoder->finished.load(std::memory_order_acquire);
+        if(_decoder->ring.readAvailable() < _chunk.size() && !finished) break;
+
+        const std::size_t size = _decoder->ring.read(_chunk);
+        if(!size) break;
+
+        alBufferData(_freeBuffers.back(), ALenum(_format), _chunk.begin(), size, _frequency);
+        alSourceQueueBuffers(_source.id(), 1, &_freeBuffers.back());
+        _freeBuffers.pop_back();
+        consumed = true;
+    }
+    if(consumed) _decoder->condition.notify_one();
+
+    if(_source.state() == Source::State::Playing) return;
+
+    /* Source not started yet, paused or starved, (re)start it if there is
+       anything to play */
+    ALint queued;
+    alGetSourcei(_source.id(), AL_BUFFERS_QUEUED, &queued);
+    if(queued) {
+        _source.play();
+        return;
+    }
+
+    /* Everything decoded and played */
+    if(_decoder->finished.load(std::memory_order_acquire) && !_decoder->ring.readAvailable())
+        stop();
+}
+
+}}
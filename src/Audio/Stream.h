@@ -0,0 +1,179 @@
+#ifndef Magnum_Audio_Stream_h
+#define Magnum_Audio_Stream_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::Audio::Stream
+ */
+
+#include <memory>
+#include <vector>
+
+#include "Audio/Buffer.h"
+#include "Audio/Source.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Streaming playback
+
+Plays long sounds without decoding them whole into memory. The data are
+decoded on a background thread using importer with
+@ref AbstractImporter::Feature::Stream into a lock-free ring buffer, from
+which the main thread refills fixed set of buffers queued on the source. The
+memory usage is thus constant regardless of sound length and starting the
+playback doesn't block the main thread on decoding. Example usage:
+@code
+std::unique_ptr<Audio::AbstractImporter> importer = manager.instance("WavAudioImporter");
+importer->openFile("music.wav");
+
+Audio::Stream music(*importer);
+music.setLooping(true)
+    .play();
+
+// Each frame
+music.update();
+@endcode
+
+The importer must not be used by anything else while the stream is playing.
+Properties like position or gain are set on the underlying @ref source(),
+but the playback should be controlled only through this class.
+*/
+class MAGNUM_AUDIO_EXPORT Stream {
+    public:
+        /**
+         * @brief Constructor
+         * @param importer      Importer with opened file. Must support
+         *      @ref AbstractImporter::Feature::Stream.
+         * @param bufferCount   Count of buffers queued on the source
+         * @param bufferSize    Size of each buffer in bytes
+         *
+         * The decoder thread keeps ahead by twice the size of all queued
+         * buffers. Latency of starting the playback and resilience against
+         * main thread stalls depend on buffer count and size, with defaults
+         * and 16-bit stereo at 44.1 kHz the queue lasts about 280 ms.
+         */
+        explicit Stream(AbstractImporter& importer, UnsignedInt bufferCount = 3, std::size_t bufferSize = 16384);
+
+        /** @brief Copying is not allowed */
+        Stream(const Stream&) = delete;
+
+        /** @brief Moving is not allowed */
+        Stream(Stream&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Stops the playback and the decoder thread.
+         */
+        ~Stream();
+
+        /** @brief Copying is not allowed */
+        Stream& operator=(const Stream&) = delete;
+
+        /** @brief Moving is not allowed */
+        Stream& operator=(Stream&&) = delete;
+
+        /** @brief Underlying source */
+        Source& source() { return _source; }
+
+        /** @brief Whether the stream is looping */
+        bool isLooping() const;
+
+        /**
+         * @brief Set looping
+         * @return Reference to self (for method chaining)
+         *
+         * Looping stream seeks to the beginning when all data are decoded.
+         * Default is `false`.
+         */
+        Stream& setLooping(bool looping);
+
+        /**
+         * @brief Whether the stream is playing
+         *
+         * Returns `true` after @ref play() until the end of data is played
+         * or @ref pause() or @ref stop() is called. Note that the source
+         * itself might not be playing yet if no data are decoded so far.
+         */
+        bool isPlaying() const;
+
+        /**
+         * @brief Play
+         *
+         * Starts the decoder thread, if not already running. The source
+         * starts playing in @ref update() once first data are decoded.
+         * Paused stream is resumed.
+         */
+        void play();
+
+        /**
+         * @brief Pause
+         *
+         * The decoder thread continues to fill the ring buffer.
+         */
+        void pause();
+
+        /**
+         * @brief Stop
+         *
+         * Stops the source and the decoder thread, unqueues all buffers and
+         * rewinds the importer to the beginning.
+         */
+        void stop();
+
+        /**
+         * @brief Update the stream
+         *
+         * Should be called every frame. Unqueues buffers which were already
+         * played, refills them with decoded data and queues them back. Only
+         * full buffers are queued, except for the last one at the end of
+         * data. If the source ran out of data (e.g. because of a long
+         * frame), it is restarted. Never blocks on decoding.
+         * @see @fn_al{SourceUnqueueBuffers}, @fn_al{SourceQueueBuffers}
+         */
+        void update();
+
+    private:
+        struct Decoder;
+
+        void stopDecoder();
+
+        AbstractImporter& _importer;
+        Source _source;
+        std::vector<Buffer> _buffers;
+        std::vector<ALuint> _freeBuffers;
+        Containers::Array<unsigned char> _chunk;
+        std::unique_ptr<Decoder> _decoder;
+        Buffer::Format _format;
+        UnsignedInt _frequency;
+        enum class State: UnsignedByte {
+            Stopped, Playing, Paused
+        } _state;
+};
+
+}}
+
+#endif
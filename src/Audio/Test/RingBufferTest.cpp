@@ -0,0 +1,144 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <thread>
+#include <TestSuite/Tester.h>
+
+#include "Audio/Implementation/RingBuffer.h"
+
+namespace Magnum { namespace Audio { namespace Test {
+
+class RingBufferTest: public TestSuite::Tester {
+    public:
+        explicit RingBufferTest();
+
+        void construct();
+        void readWrite();
+        void wrapAround();
+        void concurrent();
+};
+
+RingBufferTest::RingBufferTest() {
+    addTests({&RingBufferTest::construct,
+              &RingBufferTest::readWrite,
+              &RingBufferTest::wrapAround,
+              &RingBufferTest::concurrent});
+}
+
+void RingBufferTest::construct() {
+    Implementation::RingBuffer ring(100);
+    CORRADE_COMPARE(ring.capacity(), 128);
+    CORRADE_COMPARE(ring.readAvailable(), 0);
+    CORRADE_COMPARE(ring.writeAvailable(), 128);
+    CORRADE_COMPARE(ring.writeRegion().size(), 128);
+}
+
+void RingBufferTest::readWrite() {
+    Implementation::RingBuffer ring(8);
+
+    Containers::ArrayReference<unsigned char> region = ring.writeRegion();
+    for(std::size_t i = 0; i != 8; ++i) region[i] = i;
+    ring.commit(8);
+    CORRADE_COMPARE(ring.readAvailable(), 8);
+    CORRADE_COMPARE(ring.writeAvailable(), 0);
+    CORRADE_VERIFY(ring.writeRegion().empty());
+
+    unsigned char out[5]{};
+    CORRADE_COMPARE(ring.read(out), 5);
+    CORRADE_COMPARE(out[0], 0);
+    CORRADE_COMPARE(out[4], 4);
+    CORRADE_COMPARE(ring.readAvailable(), 3);
+    CORRADE_COMPARE(ring.writeAvailable(), 5);
+
+    /* Reads only what's available */
+    CORRADE_COMPARE(ring.read(out), 3);
+    CORRADE_COMPARE(out[2], 7);
+    CORRADE_COMPARE(ring.read(out), 0);
+
+    ring.clear();
+    CORRADE_COMPARE(ring.writeRegion().size(), 8);
+}
+
+void RingBufferTest::wrapAround() {
+    Implementation::RingBuffer ring(8);
+    ring.commit(6);
+    unsigned char out[8]{};
+    CORRADE_COMPARE(ring.read({out, 6}), 6);
+
+    /* Writable region ends at the end of the storage */
+    Containers::ArrayReference<unsigned char> region = ring.writeRegion();
+    CORRADE_COMPARE(region.size(), 2);
+    region[0] = 10;
+    region[1] = 11;
+    ring.commit(2);
+
+    region = ring.writeRegion();
+    CORRADE_COMPARE(region.size(), 6);
+    region[0] = 12;
+    ring.commit(1);
+
+    /* Read is contiguous across the wrap */
+    CORRADE_COMPARE(ring.read(out), 3);
+    CORRADE_COMPARE(out[0], 10);
+    CORRADE_COMPARE(out[1], 11);
+    CORRADE_COMPARE(out[2], 12);
+}
+
+void RingBufferTest::concurrent() {
+    Implementation::RingBuffer ring(64);
+    constexpr std::size_t count = 1 << 20;
+
+    std::thread producer([&ring]() {
+        std::size_t value = 0;
+        while(value != count) {
+            const Containers::ArrayReference<unsigned char> region = ring.writeRegion();
+            const std::size_t size = std::min(region.size(), count - value);
+            if(!size) std::this_thread::yield();
+            for(std::size_t i = 0; i != size; ++i)
+                region[i] = (value + i) & 0xff;
+            ring.commit(size);
+            value += size;
+        }
+    });
+
+    std::size_t value = 0;
+    bool ordered = true;
+    unsigned char out[48];
+    while(value != count) {
+        const std::size_t size = ring.read(out);
+        if(!size) std::this_thread::yield();
+        for(std::size_t i = 0; i != size; ++i)
+            ordered = ordered && out[i] == ((value + i) & 0xff);
+        value += size;
+    }
+
+    producer.join();
+    CORRADE_VERIFY(ordered);
+    CORRADE_COMPARE(ring.readAvailable(), 0);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::RingBufferTest)
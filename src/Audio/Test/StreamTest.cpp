@@ -0,0 +1,233 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <TestSuite/Tester.h>
+
+#include "Audio/AbstractImporter.h"
+#include "Audio/Context.h"
+#include "Audio/Stream.h"
+
+namespace Magnum { namespace Audio { namespace Test {
+
+class StreamTest: public TestSuite::Tester {
+    public:
+        explicit StreamTest();
+
+        void play();
+        void playToEnd();
+        void fullBuffers();
+        void looping();
+        void pause();
+        void stop();
+
+    private:
+        std::unique_ptr<Context> _context;
+};
+
+namespace {
+
+/* Generates given count of 8-bit mono samples, optionally only few of them
+   at a time to simulate slow decoding */
+class GeneratorImporter: public AbstractImporter {
+    public:
+        explicit GeneratorImporter(std::size_t size, std::size_t readSize = ~std::size_t{}): size(size), readSize(readSize), position(0), seekCount(0) {}
+
+        std::size_t size, readSize, position;
+        std::atomic<Int> seekCount;
+
+    private:
+        Features doFeatures() const override { return Feature::Stream; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        Buffer::Format doFormat() const override { return Buffer::Format::Mono8; }
+        UnsignedInt doFrequency() const override { return 8000; }
+        Containers::Array<unsigned char> doData() override { return nullptr; }
+
+        std::size_t doDataSize() const override { return size; }
+
+        std::size_t doRead(Containers::ArrayReference<unsigned char> buffer) override {
+            if(readSize < buffer.size())
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+            const std::size_t count = std::min({buffer.size(), readSize, size - position});
+            for(std::size_t i = 0; i != count; ++i)
+                buffer[i] = (position + i) & 0xff;
+            position += count;
+            return count;
+        }
+
+        void doSeek(std::size_t position) override {
+            this->position = std::min(position, size);
+            ++seekCount;
+        }
+};
+
+/* Calls update() until the condition is true or one second elapses */
+template<class T> bool updateUntil(Stream& stream, T condition) {
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while(!condition()) {
+        if(std::chrono::steady_clock::now() > end) return false;
+        stream.update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+ALint queuedBuffers(Source& source) {
+    ALint queued;
+    alGetSourcei(source.id(), AL_BUFFERS_QUEUED, &queued);
+    return queued;
+}
+
+}
+
+StreamTest::StreamTest() {
+    addTests({&StreamTest::play,
+              &StreamTest::playToEnd,
+              &StreamTest::fullBuffers,
+              &StreamTest::looping,
+              &StreamTest::pause,
+              &StreamTest::stop});
+
+    /* Don't make any noise with OpenAL Soft */
+    #ifndef CORRADE_TARGET_WINDOWS
+    setenv("ALSOFT_DRIVERS", "null", 0);
+    #endif
+    _context.reset(new Context);
+}
+
+void StreamTest::play() {
+    /* Ten seconds */
+    GeneratorImporter importer(80000);
+    Stream stream(importer, 3, 1024);
+    CORRADE_VERIFY(!stream.isPlaying());
+
+    stream.play();
+    CORRADE_VERIFY(stream.isPlaying());
+    CORRADE_VERIFY(updateUntil(stream, [&stream]() {
+        return stream.source().state() == Source::State::Playing;
+    }));
+    CORRADE_VERIFY(queuedBuffers(stream.source()) > 0);
+    CORRADE_VERIFY(queuedBuffers(stream.source()) <= 3);
+}
+
+void StreamTest::playToEnd() {
+    /* 50 milliseconds */
+    GeneratorImporter importer(400);
+    Stream stream(importer, 2, 128);
+    stream.play();
+
+    CORRADE_VERIFY(updateUntil(stream, [&stream]() { return !stream.isPlaying(); }));
+    CORRADE_COMPARE(queuedBuffers(stream.source()), 0);
+
+    /* Rewound for next playback */
+    CORRADE_COMPARE(importer.position, 0);
+}
+
+void StreamTest::fullBuffers() {
+    /* Decoding sixteen samples per millisecond */
+    GeneratorImporter importer(400, 16);
+    Stream stream(importer, 1, 128);
+    stream.play();
+
+    /* The only buffer isn't queued until it can be filled completely */
+    CORRADE_VERIFY(updateUntil(stream, [&stream]() {
+        return queuedBuffers(stream.source()) > 0;
+    }));
+    ALint buffer, size;
+    alGetSourcei(stream.source().id(), AL_BUFFER, &buffer);
+    alGetBufferi(buffer, AL_SIZE, &size);
+    CORRADE_COMPARE(size, 128);
+
+    /* The rest is queued in a shorter buffer at the end of data */
+    CORRADE_VERIFY(updateUntil(stream, [&stream]() { return !stream.isPlaying(); }));
+}
+
+void StreamTest::looping() {
+    /* 10 milliseconds */
+    GeneratorImporter importer(80);
+    Stream stream(importer, 2, 64);
+    stream.setLooping(true);
+    CORRADE_VERIFY(stream.isLooping());
+    stream.play();
+
+    CORRADE_VERIFY(updateUntil(stream, [&importer]() { return importer.seekCount > 2; }));
+    CORRADE_VERIFY(stream.isPlaying());
+}
+
+void StreamTest::pause() {
+    GeneratorImporter importer(80000);
+    Stream stream(importer, 3, 1024);
+    stream.play();
+    CORRADE_VERIFY(updateUntil(stream, [&stream]() {
+        return stream.source().state() == Source::State::Playing;
+    }));
+
+    stream.pause();
+    CORRADE_VERIFY(!stream.isPlaying());
+    CORRADE_COMPARE(stream.source().state(), Source::State::Paused);
+
+    /* Paused stream isn't resumed by update() */
+    stream.update();
+    CORRADE_COMPARE(stream.source().state(), Source::State::Paused);
+
+    stream.play();
+    CORRADE_VERIFY(updateUntil(stream, [&stream]() {
+        return stream.source().state() == Source::State::Playing;
+    }));
+}
+
+void StreamTest::stop() {
+    GeneratorImporter importer(80000);
+    Stream stream(importer, 3, 1024);
+    stream.play();
+    CORRADE_VERIFY(updateUntil(stream, [&stream]() {
+        return queuedBuffers(stream.source()) > 0;
+    }));
+
+    stream.stop();
+    CORRADE_VERIFY(!stream.isPlaying());
+    CORRADE_COMPARE(stream.source().state(), Source::State::Stopped);
+    CORRADE_COMPARE(queuedBuffers(stream.source()), 0);
+    CORRADE_COMPARE(importer.position, 0);
+
+    /* Can be played again */
+    stream.play();
+    CORRADE_VERIFY(updateUntil(stream, [&stream]() {
+        return stream.source().state() == Source::State::Playing;
+    }));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::StreamTest)
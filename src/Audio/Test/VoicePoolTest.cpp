@@ -0,0 +1,226 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <cstdlib>
+#include <memory>
+#include <TestSuite/Tester.h>
+
+#include "Audio/Buffer.h"
+#include "Audio/Context.h"
+#include "Audio/VoicePool.h"
+
+namespace Magnum { namespace Audio { namespace Test {
+
+class VoicePoolTest: public TestSuite::Tester {
+    public:
+        explicit VoicePoolTest();
+
+        void construct();
+        void virtualize();
+        void priority();
+        void steal();
+        void stealHysteresis();
+        void virtualFinished();
+        void virtualLooping();
+        void stop();
+
+    private:
+        std::unique_ptr<Context> _context;
+        Buffer _buffer;
+};
+
+VoicePoolTest::VoicePoolTest() {
+    addTests({&VoicePoolTest::construct,
+              &VoicePoolTest::virtualize,
+              &VoicePoolTest::priority,
+              &VoicePoolTest::steal,
+              &VoicePoolTest::stealHysteresis,
+              &VoicePoolTest::virtualFinished,
+              &VoicePoolTest::virtualLooping,
+              &VoicePoolTest::stop});
+
+    /* Don't make any noise with OpenAL Soft */
+    #ifndef CORRADE_TARGET_WINDOWS
+    setenv("ALSOFT_DRIVERS", "null", 0);
+    #endif
+    _context.reset(new Context);
+
+    /* One second of silence */
+    static const UnsignedByte data[8000]{};
+    _buffer.setData(Buffer::Format::Mono8, data, 8000);
+}
+
+void VoicePoolTest::construct() {
+    VoicePool pool(4);
+    CORRADE_VERIFY(pool.sourceCount() <= 4);
+    CORRADE_COMPARE(pool.voiceCount(), 0);
+    CORRADE_COMPARE(pool.realVoiceCount(), 0);
+
+    /* Default-constructed handle is not playing */
+    CORRADE_VERIFY(!pool.isPlaying(VoicePool::Voice()));
+    CORRADE_VERIFY(!pool.isVirtual(VoicePool::Voice()));
+}
+
+void VoicePoolTest::virtualize() {
+    VoicePool pool(2);
+    if(pool.sourceCount() != 2) CORRADE_SKIP("Cannot create enough sources.");
+
+    VoicePool::Voice far = pool.play(_buffer, {30.0f, 0.0f, 0.0f});
+    VoicePool::Voice near = pool.play(_buffer, {1.0f, 0.0f, 0.0f});
+    VoicePool::Voice quiet = pool.play(_buffer, {2.0f, 0.0f, 0.0f}, 0.01f);
+    CORRADE_COMPARE(pool.voiceCount(), 3);
+
+    /* All voices are virtual before first update */
+    CORRADE_VERIFY(pool.isVirtual(far));
+    CORRADE_VERIFY(pool.isVirtual(near));
+    CORRADE_COMPARE(pool.realVoiceCount(), 0);
+
+    pool.update({}, 0.0f);
+    CORRADE_COMPARE(pool.voiceCount(), 3);
+    CORRADE_COMPARE(pool.realVoiceCount(), 2);
+    CORRADE_VERIFY(!pool.isVirtual(far));
+    CORRADE_VERIFY(!pool.isVirtual(near));
+    CORRADE_VERIFY(pool.isVirtual(quiet));
+    CORRADE_VERIFY(pool.isPlaying(quiet));
+}
+
+void VoicePoolTest::priority() {
+    VoicePool pool(1);
+    if(pool.sourceCount() != 1) CORRADE_SKIP("Cannot create enough sources.");
+
+    VoicePool::Voice important = pool.play(_buffer, {100.0f, 0.0f, 0.0f}, 0.5f, 1);
+    VoicePool::Voice loud = pool.play(_buffer, {}, 1.0f, 0);
+
+    pool.update({}, 0.0f);
+    CORRADE_VERIFY(!pool.isVirtual(important));
+    CORRADE_VERIFY(pool.isVirtual(loud));
+}
+
+void VoicePoolTest::steal() {
+    VoicePool pool(1);
+    if(pool.sourceCount() != 1) CORRADE_SKIP("Cannot create enough sources.");
+
+    VoicePool::Voice a = pool.play(_buffer, {1.0f, 0.0f, 0.0f}, 1.0f, 0, true);
+    VoicePool::Voice b = pool.play(_buffer, {10.0f, 0.0f, 0.0f}, 1.0f, 0, true);
+    pool.update({}, 0.0f);
+    CORRADE_VERIFY(!pool.isVirtual(a));
+    CORRADE_VERIFY(pool.isVirtual(b));
+
+    /* Listener moved closer to the other voice, it steals the source */
+    pool.update({10.0f, 0.0f, 0.0f}, 0.0f);
+    CORRADE_VERIFY(pool.isVirtual(a));
+    CORRADE_VERIFY(!pool.isVirtual(b));
+    CORRADE_COMPARE(pool.realVoiceCount(), 1);
+
+    /* Voice moved, steals it back */
+    pool.setPosition(a, {10.0f, 0.0f, 0.0f})
+        .setGain(b, 0.5f);
+    pool.update({10.0f, 0.0f, 0.0f}, 0.0f);
+    CORRADE_VERIFY(!pool.isVirtual(a));
+    CORRADE_VERIFY(pool.isVirtual(b));
+    CORRADE_COMPARE(pool.voiceCount(), 2);
+}
+
+void VoicePoolTest::stealHysteresis() {
+    VoicePool pool(1);
+    if(pool.sourceCount() != 1) CORRADE_SKIP("Cannot create enough sources.");
+
+    VoicePool::Voice a = pool.play(_buffer, {2.0f, 0.0f, 0.0f}, 1.0f, 0, true);
+    VoicePool::Voice b = pool.play(_buffer, {-2.1f, 0.0f, 0.0f}, 1.0f, 0, true);
+    pool.update({}, 0.0f);
+    CORRADE_VERIFY(!pool.isVirtual(a));
+    CORRADE_VERIFY(pool.isVirtual(b));
+
+    /* The other voice is now slightly more audible, but not enough to steal
+       the source */
+    pool.update({-0.1f, 0.0f, 0.0f}, 0.0f);
+    CORRADE_VERIFY(!pool.isVirtual(a));
+    CORRADE_VERIFY(pool.isVirtual(b));
+
+    /* Now it is */
+    pool.update({-1.0f, 0.0f, 0.0f}, 0.0f);
+    CORRADE_VERIFY(pool.isVirtual(a));
+    CORRADE_VERIFY(!pool.isVirtual(b));
+}
+
+void VoicePoolTest::virtualFinished() {
+    VoicePool pool(1);
+    if(pool.sourceCount() != 1) CORRADE_SKIP("Cannot create enough sources.");
+
+    pool.play(_buffer, {}, 1.0f, 1, true);
+    VoicePool::Voice voice = pool.play(_buffer, {}, 0.5f);
+    pool.update({}, 0.5f);
+    CORRADE_VERIFY(pool.isVirtual(voice));
+
+    /* Virtual voice ends after the buffer duration */
+    pool.update({}, 0.25f);
+    CORRADE_VERIFY(pool.isPlaying(voice));
+    pool.update({}, 0.5f);
+    CORRADE_VERIFY(!pool.isPlaying(voice));
+    CORRADE_COMPARE(pool.voiceCount(), 1);
+}
+
+void VoicePoolTest::virtualLooping() {
+    VoicePool pool(1);
+    if(pool.sourceCount() != 1) CORRADE_SKIP("Cannot create enough sources.");
+
+    pool.play(_buffer, {}, 1.0f, 1, true);
+    VoicePool::Voice voice = pool.play(_buffer, {}, 0.5f, 0, true);
+    pool.update({}, 0.0f);
+    CORRADE_VERIFY(pool.isVirtual(voice));
+
+    pool.update({}, 2.5f);
+    CORRADE_VERIFY(pool.isPlaying(voice));
+    CORRADE_COMPARE(pool.voiceCount(), 2);
+}
+
+void VoicePoolTest::stop() {
+    VoicePool pool(1);
+    if(pool.sourceCount() != 1) CORRADE_SKIP("Cannot create enough sources.");
+
+    VoicePool::Voice a = pool.play(_buffer, {}, 1.0f, 0, true);
+    VoicePool::Voice b = pool.play(_buffer, {}, 0.5f, 0, true);
+    pool.update({}, 0.0f);
+    CORRADE_VERIFY(!pool.isVirtual(a));
+
+    /* The other voice gets the source right away */
+    pool.stop(a);
+    CORRADE_VERIFY(!pool.isPlaying(a));
+    CORRADE_COMPARE(pool.realVoiceCount(), 0);
+    pool.update({}, 0.0f);
+    CORRADE_VERIFY(!pool.isVirtual(b));
+    CORRADE_COMPARE(pool.realVoiceCount(), 1);
+
+    /* Stale handle doesn't affect voice reusing the same slot */
+    VoicePool::Voice c = pool.play(_buffer);
+    CORRADE_VERIFY(c != a);
+    pool.stop(a);
+    CORRADE_VERIFY(pool.isPlaying(c));
+    CORRADE_COMPARE(pool.voiceCount(), 2);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::VoicePoolTest)
@@ -0,0 +1,331 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "VoicePool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <Utility/Assert.h>
+
+#include "Audio/Buffer.h"
+
+namespace Magnum { namespace Audio {
+
+namespace {
+    enum: UnsignedByte {
+        DirtyPosition = 1 << 0,
+        DirtyGain = 1 << 1,
+        DirtyPitch = 1 << 2
+    };
+
+    /* Voices which already have a source are considered this much more
+       audible when selecting real voices, so voices with nearly the same
+       audibility don't swap sources every frame */
+    constexpr Float RealVoiceBias = 1.25f;
+}
+
+struct VoicePool::VoiceData {
+    Vector3 position;
+    Float gain, pitch;
+
+    /* Playback position and buffer duration in seconds */
+    Float time, duration;
+    Float audibility;
+
+    ALuint buffer;
+    UnsignedInt generation;
+    Int priority;
+
+    /* Index into _sources or -1 if virtual */
+    Int source;
+
+    bool playing, looping;
+    UnsignedByte dirty;
+};
+
+VoicePool::VoicePool(const UnsignedInt sourceCount): _voiceCount(0), _referenceDistance(1.0f), _rolloffFactor(1.0f), _maxDistance(std::numeric_limits<Float>::max()) {
+    /* Create the sources one by one, so we end up with as many as the device
+       supports */
+    _sources.reserve(sourceCount);
+    alGetError();
+    for(UnsignedInt i = 0; i != sourceCount; ++i) {
+        ALuint id;
+        alGenSources(1, &id);
+        if(alGetError() != AL_NO_ERROR) break;
+        _sources.push_back(id);
+    }
+
+    /* Take the sources from the front first */
+    _freeSources.reserve(_sources.size());
+    for(UnsignedInt i = _sources.size(); i != 0; --i)
+        _freeSources.push_back(i - 1);
+}
+
+VoicePool::~VoicePool() {
+    if(_sources.empty()) return;
+    alSourceStopv(_sources.size(), _sources.data());
+    alDeleteSources(_sources.size(), _sources.data());
+}
+
+VoicePool& VoicePool::setReferenceDistance(const Float distance) {
+    _referenceDistance = distance;
+    for(ALuint id: _sources) alSourcef(id, AL_REFERENCE_DISTANCE, distance);
+    return *this;
+}
+
+VoicePool& VoicePool::setRolloffFactor(const Float factor) {
+    _rolloffFactor = factor;
+    for(ALuint id: _sources) alSourcef(id, AL_ROLLOFF_FACTOR, factor);
+    return *this;
+}
+
+VoicePool& VoicePool::setMaxDistance(const Float distance) {
+    _maxDistance = distance;
+    for(ALuint id: _sources) alSourcef(id, AL_MAX_DISTANCE, distance);
+    return *this;
+}
+
+VoicePool::Voice VoicePool::play(Buffer& buffer, const Vector3& position, const Float gain, const Int priority, const bool looping) {
+    UnsignedInt index;
+    if(_freeVoices.empty()) {
+        index = _voices.size();
+        _voices.emplace_back();
+        _voices.back().generation = 0;
+    } else {
+        index = _freeVoices.back();
+        _freeVoices.pop_back();
+    }
+
+    /* Buffer duration, needed for tracking virtual voices */
+    ALint size, bits, channels, frequency;
+    alGetBufferi(buffer.id(), AL_SIZE, &size);
+    alGetBufferi(buffer.id(), AL_BITS, &bits);
+    alGetBufferi(buffer.id(), AL_CHANNELS, &channels);
+    alGetBufferi(buffer.id(), AL_FREQUENCY, &frequency);
+
+    VoiceData& voice = _voices[index];
+    voice.position = position;
+    voice.gain = gain;
+    voice.pitch = 1.0f;
+    voice.time = 0.0f;
+    voice.duration = bits > 0 && channels > 0 && frequency > 0 ?
+        Float(size/(bits/8*channels))/frequency : 0.0f;
+    voice.audibility = 0.0f;
+    voice.buffer = buffer.id();
+    voice.priority = priority;
+    voice.source = -1;
+    voice.playing = true;
+    voice.looping = looping;
+    voice.dirty = 0;
+
+    ++_voiceCount;
+    return Voice(index, voice.generation);
+}
+
+VoicePool::VoiceData* VoicePool::data(const Voice voice) {
+    if(voice._index >= _voices.size()) return nullptr;
+    VoiceData& data = _voices[voice._index];
+    return data.playing && data.generation == voice._generation ? &data : nullptr;
+}
+
+const VoicePool::VoiceData* VoicePool::data(const Voice voice) const {
+    return const_cast<VoicePool*>(this)->data(voice);
+}
+
+void VoicePool::release(const UnsignedInt index) {
+    VoiceData& voice = _voices[index];
+    if(voice.source != -1) {
+        _freeSources.push_back(voice.source);
+        voice.source = -1;
+    }
+
+    voice.playing = false;
+    ++voice.generation;
+    _freeVoices.push_back(index);
+    --_voiceCount;
+}
+
+VoicePool& VoicePool::stop(const Voice voice) {
+    VoiceData* const d = data(voice);
+    if(!d) return *this;
+
+    /* The source is stopped in next update() */
+    if(d->source != -1) _pendingStop.push_back(_sources[d->source]);
+    release(voice._index);
+    return *this;
+}
+
+bool VoicePool::isPlaying(const Voice voice) const {
+    return data(voice);
+}
+
+bool VoicePool::isVirtual(const Voice voice) const {
+    const VoiceData* const d = data(voice);
+    return d && d->source == -1;
+}
+
+VoicePool& VoicePool::setPosition(const Voice voice, const Vector3& position) {
+    if(VoiceData* const d = data(voice)) {
+        d->position = position;
+        d->dirty |= DirtyPosition;
+    }
+    return *this;
+}
+
+VoicePool& VoicePool::setGain(const Voice voice, const Float gain) {
+    if(VoiceData* const d = data(voice)) {
+        d->gain = gain;
+        d->dirty |= DirtyGain;
+    }
+    return *this;
+}
+
+VoicePool& VoicePool::setPitch(const Voice voice, const Float pitch) {
+    if(VoiceData* const d = data(voice)) {
+        d->pitch = pitch;
+        d->dirty |= DirtyPitch;
+    }
+    return *this;
+}
+
+Float VoicePool::audibility(const VoiceData& voice, const Vector3& listenerPosition) const {
+    /* Inverse distance clamped model, same as OpenAL default */
+    const Float distance = std::min(std::max((voice.position - listenerPosition).length(), _referenceDistance), _maxDistance);
+    const Float denominator = _referenceDistance + _rolloffFactor*(distance - _referenceDistance);
+    return denominator > 0.0f ? voice.gain*_referenceDistance/denominator : voice.gain;
+}
+
+void VoicePool::update(const Vector3& listenerPosition, const Float duration) {
+    /* Advance playback position, remove finished voices and collect the rest
+       as candidates for real sources */
+    _candidates.clear();
+    for(UnsignedInt i = 0; i != _voices.size(); ++i) {
+        VoiceData& voice = _voices[i];
+        if(!voice.playing) continue;
+
+        voice.time += duration*voice.pitch;
+
+        /* Real voice finished, the source is already stopped so it can be
+           reused right away */
+        if(voice.source != -1) {
+            const ALuint id = _sources[voice.source];
+            ALint state;
+            alGetSourcei(id, AL_SOURCE_STATE, &state);
+            if(state == AL_STOPPED) {
+                alSourcei(id, AL_BUFFER, 0);
+                release(i);
+                continue;
+            }
+        }
+
+        if(voice.time >= voice.duration) {
+            if(voice.looping)
+                voice.time = voice.duration > 0.0f ? std::fmod(voice.time, voice.duration) : 0.0f;
+
+            /* Virtual voice finished */
+            else if(voice.source == -1) {
+                release(i);
+                continue;
+            }
+        }
+
+        voice.audibility = audibility(voice, listenerPosition);
+        if(voice.source != -1) voice.audibility *= RealVoiceBias;
+        _candidates.push_back(i);
+    }
+
+    /* Select the most important voices, they will be the first realCount
+       candidates */
+    const std::size_t realCount = std::min(_candidates.size(), _sources.size());
+    if(realCount < _candidates.size()) {
+        std::nth_element(_candidates.begin(), _candidates.begin() + realCount, _candidates.end(),
+            [this](const UnsignedInt a, const UnsignedInt b) {
+                const VoiceData& first = _voices[a];
+                const VoiceData& second = _voices[b];
+                return first.priority > second.priority ||
+                      (first.priority == second.priority && first.audibility > second.audibility);
+            });
+    }
+
+    /* Steal sources from the rest, continue from where the source ended */
+    for(auto it = _candidates.begin() + realCount; it != _candidates.end(); ++it) {
+        VoiceData& voice = _voices[*it];
+        if(voice.source == -1) continue;
+
+        const ALuint id = _sources[voice.source];
+        alGetSourcef(id, AL_SEC_OFFSET, &voice.time);
+        _pendingStop.push_back(id);
+        _freeSources.push_back(voice.source);
+        voice.source = -1;
+    }
+
+    /* Stop all stolen and explicitly stopped sources at once */
+    if(!_pendingStop.empty()) {
+        alSourceStopv(_pendingStop.size(), _pendingStop.data());
+        for(ALuint id: _pendingStop) alSourcei(id, AL_BUFFER, 0);
+        _pendingStop.clear();
+    }
+
+    /* Give sources to newly real voices, apply pending changes to the rest */
+    for(auto it = _candidates.begin(); it != _candidates.begin() + realCount; ++it) {
+        VoiceData& voice = _voices[*it];
+
+        if(voice.source == -1) {
+            CORRADE_INTERNAL_ASSERT(!_freeSources.empty());
+            voice.source = _freeSources.back();
+            _freeSources.pop_back();
+
+            const ALuint id = _sources[voice.source];
+            alSourcei(id, AL_BUFFER, voice.buffer);
+            alSourcei(id, AL_LOOPING, voice.looping);
+            alSourcefv(id, AL_POSITION, voice.position.data());
+            alSourcef(id, AL_GAIN, voice.gain);
+            alSourcef(id, AL_PITCH, voice.pitch);
+            alSourcef(id, AL_SEC_OFFSET, voice.time);
+            _pendingPlay.push_back(id);
+
+        } else if(voice.dirty) {
+            const ALuint id = _sources[voice.source];
+            if(voice.dirty & DirtyPosition) alSourcefv(id, AL_POSITION, voice.position.data());
+            if(voice.dirty & DirtyGain) alSourcef(id, AL_GAIN, voice.gain);
+            if(voice.dirty & DirtyPitch) alSourcef(id, AL_PITCH, voice.pitch);
+        }
+
+        voice.dirty = 0;
+    }
+
+    /* Virtual voices have everything tracked on the CPU */
+    for(auto it = _candidates.begin() + realCount; it != _candidates.end(); ++it)
+        _voices[*it].dirty = 0;
+
+    /* Start all new sources at once */
+    if(!_pendingPlay.empty()) {
+        alSourcePlayv(_pendingPlay.size(), _pendingPlay.data());
+        _pendingPlay.clear();
+    }
+}
+
+}}
@@ -0,0 +1,270 @@
+#ifndef Magnum_Audio_VoicePool_h
+#define Magnum_Audio_VoicePool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::Audio::VoicePool
+ */
+
+#include <vector>
+#include <al.h>
+
+#include "Math/Vector3.h"
+#include "Magnum.h"
+#include "Audio/Audio.h"
+#include "Audio/magnumAudioVisibility.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Pool of voices with source virtualization
+
+Plays any number of sounds (voices) using bounded pool of OpenAL sources. Each
+voice is either real, i.e. playing on an OpenAL source, or virtual, in which
+case only its playback position, gain and priority are tracked on the CPU.
+Each frame, @ref update() selects the most important voices (with highest
+priority and, among voices with the same priority, the most audible ones) to
+be real and virtualizes the rest, stealing sources of the least audible
+voices if the pool is full. Voices which are already real are preferred by a
+small margin, so voices with nearly the same audibility don't swap sources
+every frame. Virtualized voice continues from its current position once it
+gets a real source again.
+
+All state changes are batched and applied to the sources in @ref update(),
+newly started and stolen voices are started and stopped with single
+@fn_al{SourcePlayv} and @fn_al{SourceStopv} call. Example usage:
+@code
+Audio::VoicePool pool(32);
+
+// Fire a one-shot effect
+pool.play(explosionBuffer, {10.0f, 0.0f, 2.0f});
+
+// Move looping sound with its emitter
+Audio::VoicePool::Voice engine = pool.play(engineBuffer, car.position(), 1.0f, 1, true);
+pool.setPosition(engine, car.position());
+
+// Each frame
+pool.update(listenerPosition, timeline.previousFrameDuration());
+@endcode
+
+Audibility is estimated from voice gain and distance to the listener using
+the same inverse clamped distance model as OpenAL uses by default, the pool
+sets distance model parameters for all its sources using
+@ref setReferenceDistance(), @ref setRolloffFactor() and @ref setMaxDistance().
+The buffers must stay alive for as long as any voice is playing them.
+*/
+class MAGNUM_AUDIO_EXPORT VoicePool {
+    public:
+        /**
+         * @brief %Voice handle
+         *
+         * Default-constructed handle doesn't refer to any voice. Handle of
+         * voice which already finished or was stopped is invalid and
+         * operations on it are ignored.
+         */
+        class Voice {
+            friend class VoicePool;
+
+            public:
+                /** @brief Constructor */
+                constexpr explicit Voice(): _index(~UnsignedInt{}), _generation(0) {}
+
+                /** @brief Equality comparison */
+                constexpr bool operator==(Voice other) const {
+                    return _index == other._index && _generation == other._generation;
+                }
+
+                /** @brief Non-equality comparison */
+                constexpr bool operator!=(Voice other) const {
+                    return !operator==(other);
+                }
+
+            private:
+                constexpr explicit Voice(UnsignedInt index, UnsignedInt generation): _index(index), _generation(generation) {}
+
+                UnsignedInt _index, _generation;
+        };
+
+        /**
+         * @brief Constructor
+         * @param sourceCount   Max count of OpenAL sources
+         *
+         * Creates OpenAL sources for the pool. If the device doesn't support
+         * that many sources, the pool uses as many as can be created, see
+         * @ref sourceCount().
+         * @see @fn_al{GenSources}
+         */
+        explicit VoicePool(UnsignedInt sourceCount);
+
+        /** @brief Copying is not allowed */
+        VoicePool(const VoicePool&) = delete;
+
+        /** @brief Moving is not allowed */
+        VoicePool(VoicePool&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Stops all voices and deletes the OpenAL sources.
+         * @see @fn_al{DeleteSources}
+         */
+        ~VoicePool();
+
+        /** @brief Copying is not allowed */
+        VoicePool& operator=(const VoicePool&) = delete;
+
+        /** @brief Moving is not allowed */
+        VoicePool& operator=(VoicePool&&) = delete;
+
+        /** @brief Count of OpenAL sources in the pool */
+        UnsignedInt sourceCount() const { return _sources.size(); }
+
+        /** @brief Count of playing voices, both real and virtual */
+        std::size_t voiceCount() const { return _voiceCount; }
+
+        /** @brief Count of voices playing on OpenAL source */
+        std::size_t realVoiceCount() const {
+            return _sources.size() - _freeSources.size();
+        }
+
+        /**
+         * @brief Set reference distance for all sources
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `1.0f`.
+         * @see @ref Source::setReferenceDistance()
+         */
+        VoicePool& setReferenceDistance(Float distance);
+
+        /**
+         * @brief Set rolloff factor for all sources
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `1.0f`.
+         * @see @ref Source::setRolloffFactor()
+         */
+        VoicePool& setRolloffFactor(Float factor);
+
+        /**
+         * @brief Set max distance for all sources
+         * @return Reference to self (for method chaining)
+         *
+         * Default is max representable value.
+         * @see @ref Source::setMaxDistance()
+         */
+        VoicePool& setMaxDistance(Float distance);
+
+        /**
+         * @brief Play a buffer
+         * @param buffer    Buffer to play
+         * @param position  Position of the voice
+         * @param gain      Gain of the voice
+         * @param priority  Voices with higher priority are preferred over
+         *      voices with lower priority regardless of their audibility
+         * @param looping   Whether the voice loops
+         * @return Handle of the new voice
+         *
+         * The voice starts playing on next @ref update().
+         */
+        Voice play(Buffer& buffer, const Vector3& position = {}, Float gain = 1.0f, Int priority = 0, bool looping = false);
+
+        /**
+         * @brief Stop a voice
+         * @return Reference to self (for method chaining)
+         *
+         * The voice handle is invalid after this call.
+         */
+        VoicePool& stop(Voice voice);
+
+        /** @brief Whether the voice is playing */
+        bool isPlaying(Voice voice) const;
+
+        /**
+         * @brief Whether the voice is virtual
+         *
+         * Returns `true` also if the voice was just started and there was no
+         * @ref update() since then. Returns `false` if the voice is not
+         * playing.
+         */
+        bool isVirtual(Voice voice) const;
+
+        /**
+         * @brief Set voice position
+         * @return Reference to self (for method chaining)
+         *
+         * Applied on next @ref update().
+         */
+        VoicePool& setPosition(Voice voice, const Vector3& position);
+
+        /**
+         * @brief Set voice gain
+         * @return Reference to self (for method chaining)
+         *
+         * Applied on next @ref update().
+         */
+        VoicePool& setGain(Voice voice, Float gain);
+
+        /**
+         * @brief Set voice pitch
+         * @return Reference to self (for method chaining)
+         *
+         * Applied on next @ref update(). Default is `1.0f`.
+         */
+        VoicePool& setPitch(Voice voice, Float pitch);
+
+        /**
+         * @brief Update the voices
+         * @param listenerPosition  Listener position
+         * @param duration          Time elapsed since previous update in
+         *      seconds
+         *
+         * Advances playback position of virtual voices and removes finished
+         * voices, selects voices which should be real, starts the new ones,
+         * stops the stolen ones and applies all pending changes to the
+         * sources.
+         */
+        void update(const Vector3& listenerPosition, Float duration);
+
+    private:
+        struct VoiceData;
+
+        VoiceData* data(Voice voice);
+        const VoiceData* data(Voice voice) const;
+        void release(UnsignedInt index);
+        Float audibility(const VoiceData& voice, const Vector3& listenerPosition) const;
+
+        std::vector<ALuint> _sources;
+        std::vector<UnsignedInt> _freeSources;
+        std::vector<VoiceData> _voices;
+        std::vector<UnsignedInt> _freeVoices;
+        std::vector<ALuint> _pendingStop, _pendingPlay;
+        std::vector<UnsignedInt> _candidates;
+        std::size_t _voiceCount;
+        Float _referenceDistance, _rolloffFactor, _maxDistance;
+};
+
+}}
+
+#endif
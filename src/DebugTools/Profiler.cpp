@@ -25,18 +25,191 @@
 #include "Profiler.h"
 
 #include <algorithm>
+#include <fstream>
+#include <mutex>
 #include <numeric>
+#include <ostream>
+#include <thread>
 #include <Utility/Assert.h>
 
+#if defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
+
 #include "Magnum.h"
+#include "Query.h"
 
 using namespace std::chrono;
 
 namespace Magnum { namespace DebugTools {
 
-Profiler::Section Profiler::addSection(const std::string& name) {
+namespace Implementation {
+
+namespace {
+    /* Timestamp counter on x86, steady clock ticks elsewhere. Both are
+       converted to real time using calibration against steady clock, so the
+       unit doesn't matter. */
+    inline UnsignedLong timestamp() {
+        #if defined(__i386__) || defined(__x86_64__) || (defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64)))
+        return __rdtsc();
+        #else
+        return steady_clock::now().time_since_epoch().count();
+        #endif
+    }
+
+    /* Unique profiler ID, so thread-local cache doesn't point to buffer of
+       already destroyed profiler on the same address */
+    std::atomic<UnsignedInt> profilerIdCounter{0};
+
+    #ifndef CORRADE_GCC46_COMPATIBILITY
+    thread_local
+    #else
+    __thread
+    #endif
+    UnsignedInt currentProfilerId = 0;
+
+    #ifndef CORRADE_GCC46_COMPATIBILITY
+    thread_local
+    #else
+    __thread
+    #endif
+    ProfilerThreadBuffer* currentThreadBuffer = nullptr;
+}
+
+struct ZoneEvent {
+    const char* name;
+    UnsignedLong begin, end;
+};
+
+/* Buffer generation in upper 32 bits and count of events in lower 32 bits,
+   so both can be updated with a single atomic operation */
+constexpr UnsignedLong packCount(const UnsignedInt generation, const std::size_t count) {
+    return UnsignedLong(generation) << 32 | count;
+}
+constexpr UnsignedInt generationOf(const UnsignedLong packed) { return packed >> 32; }
+constexpr std::size_t countOf(const UnsignedLong packed) { return packed & 0xffffffffu; }
+
+/* Events are written only from the owning thread, `size` is published with
+   release semantics so the events can be read from any other thread. The
+   event storage is never reallocated, enable() only resets the counts and
+   increases the generation, so zones opened before can't be recorded. */
+struct ProfilerThreadBuffer {
+    explicit ProfilerThreadBuffer(std::thread::id thread, std::size_t capacity): thread(thread), capacity(capacity), events(new ZoneEvent[capacity]), size(0), dropped(0) {}
+
+    const std::thread::id thread;
+    const std::size_t capacity;
+    const std::unique_ptr<ZoneEvent[]> events;
+    std::atomic<UnsignedLong> size, dropped;
+};
+
+struct ProfilerZoneState {
+    explicit ProfilerZoneState(): id(++profilerIdCounter), capacity(65536), calibrationTicks(0) {}
+
+    ProfilerThreadBuffer* threadBuffer();
+
+    std::atomic<UnsignedInt> id;
+    std::size_t capacity;
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<ProfilerThreadBuffer>> threads;
+
+    /* Buffers with different capacity than currently set, kept until the
+       profiler is destroyed as zones on other threads can still refer to
+       them */
+    std::vector<std::unique_ptr<ProfilerThreadBuffer>> retired;
+
+    UnsignedLong calibrationTicks;
+    steady_clock::time_point calibrationTime;
+};
+
+ProfilerThreadBuffer* ProfilerZoneState::threadBuffer() {
+    /* Fast path, no locking */
+    if(currentProfilerId == id.load(std::memory_order_acquire)) return currentThreadBuffer;
+
+    /* Find buffer for this thread or create new one */
+    std::lock_guard<std::mutex> lock(mutex);
+    const std::thread::id thread = std::this_thread::get_id();
+    auto found = std::find_if(threads.begin(), threads.end(), [thread](const std::unique_ptr<ProfilerThreadBuffer>& b) { return b->thread == thread; });
+    if(found == threads.end()) {
+        threads.emplace_back(new ProfilerThreadBuffer(thread, capacity));
+        found = threads.end()-1;
+    }
+
+    currentProfilerId = id.load(std::memory_order_relaxed);
+    return currentThreadBuffer = found->get();
+}
+
+/* Ring of per-frame query pools, queries are reused once their results are
+   read */
+struct ProfilerGpuState {
+    struct Frame {
+        explicit Frame(): used(0) {}
+
+        std::vector<TimeQuery> queries;
+        std::vector<Profiler::Section> sections;
+        std::size_t used;
+    };
+
+    explicit ProfilerGpuState(std::size_t latency): frames(latency), current(0), running(false) {}
+
+    std::vector<Frame> frames;
+    std::size_t current;
+    bool running;
+};
+
+namespace {
+    Profiler::Statistics statistics(std::vector<nanoseconds>& samples) {
+        Profiler::Statistics s{};
+        s.frameCount = samples.size();
+        if(samples.empty()) return s;
+
+        std::sort(samples.begin(), samples.end());
+
+        /* Nearest-rank percentile */
+        auto percentile = [&samples](const std::size_t p) {
+            return samples[std::max<std::size_t>((p*samples.size() + 99)/100, 1) - 1];
+        };
+        s.median = percentile(50);
+        s.percentile95 = percentile(95);
+        s.percentile99 = percentile(99);
+        s.max = samples.back();
+
+        nanoseconds sum{};
+        for(nanoseconds sample: samples) sum += sample;
+        s.mean = sum/samples.size();
+
+        double squaredSum = 0.0;
+        for(nanoseconds sample: samples) {
+            const double difference = (sample - s.mean).count();
+            squaredSum += difference*difference;
+        }
+        s.variance = squaredSum/samples.size();
+
+        return s;
+    }
+
+    void writeJsonString(std::ostream& out, const char* string) {
+        out << '"';
+        for(const char* c = string; *c; ++c) {
+            if(*c == '"' || *c == '\\') out << '\\' << *c;
+            else if(static_cast<unsigned char>(*c) < 0x20) out << ' ';
+            else out << *c;
+        }
+        out << '"';
+    }
+}
+
+}
+
+Profiler::Profiler(): enabled(false), measureDuration(60), currentFrame(0), frameCount(0), sections{"Other"}, sectionFlags{SectionFlags()}, currentSection(otherSection), zoneState(new Implementation::ProfilerZoneState), _gpuLatency(3), gpuFrameCount(0), _droppedGpuFrameCount(0) {}
+
+Profiler::~Profiler() = default;
+
+Profiler::Section Profiler::addSection(const std::string& name, const SectionFlags flags) {
     CORRADE_ASSERT(!enabled, "Profiler: cannot add section when profiling is enabled", 0);
     sections.push_back(name);
+    sectionFlags.push_back(flags);
     return sections.size()-1;
 }
 
@@ -45,14 +218,71 @@ void Profiler::setMeasureDuration(std::size_t frames) {
     measureDuration = frames;
 }
 
+void Profiler::setGpuLatency(const std::size_t frames) {
+    CORRADE_ASSERT(!enabled, "Profiler: cannot set GPU latency when profiling is enabled", );
+    CORRADE_ASSERT(frames, "Profiler: GPU latency must be at least one frame", );
+    _gpuLatency = frames;
+}
+
 void Profiler::enable() {
-    enabled = true;
-    frameData.assign(measureDuration*sections.size(), high_resolution_clock::duration::zero());
+    /* One more frame in the ring for the frame being currently measured */
+    frameData.assign((measureDuration+1)*sections.size(), high_resolution_clock::duration::zero());
     totalData.assign(sections.size(), high_resolution_clock::duration::zero());
+    currentFrame = 0;
     frameCount = 0;
+
+    /* Prepare GPU query ring only if there are any GPU-timed sections,
+       reuse already created queries if possible */
+    if(std::find_if(sectionFlags.begin(), sectionFlags.end(), [](SectionFlags flags) { return !!(flags & SectionFlag::GpuTime); }) != sectionFlags.end()) {
+        if(!gpuState || gpuState->frames.size() != _gpuLatency)
+            gpuState.reset(new Implementation::ProfilerGpuState(_gpuLatency));
+        for(auto& frame: gpuState->frames) frame.used = 0;
+        gpuState->current = 0;
+        gpuState->running = false;
+
+        gpuFrameData.assign((measureDuration+1)*sections.size(), std::chrono::nanoseconds::zero());
+        gpuTotalData.assign(sections.size(), std::chrono::nanoseconds::zero());
+        gpuFrameValid.assign(measureDuration+1, false);
+    } else {
+        gpuState.reset();
+        gpuFrameData.clear();
+        gpuTotalData.clear();
+        gpuFrameValid.clear();
+    }
+    gpuFrameCount = 0;
+    _droppedGpuFrameCount = 0;
+
+    /* Clear recorded zones. Buffers with different capacity are retired,
+       threads create new ones on their next zone, as the changed ID
+       invalidates their cached buffer pointer. Zones which are currently
+       open on other threads see the generation change and won't record
+       anything. */
+    {
+        std::lock_guard<std::mutex> lock(zoneState->mutex);
+        for(auto& buffer: zoneState->threads) {
+            const UnsignedInt generation = Implementation::generationOf(buffer->size.load(std::memory_order_relaxed)) + 1;
+            buffer->dropped.store(Implementation::packCount(generation, 0), std::memory_order_relaxed);
+            buffer->size.store(Implementation::packCount(generation, 0), std::memory_order_release);
+            if(buffer->capacity != zoneState->capacity)
+                zoneState->retired.push_back(std::move(buffer));
+        }
+
+        const auto retired = std::remove(zoneState->threads.begin(), zoneState->threads.end(), nullptr);
+        if(retired != zoneState->threads.end()) {
+            zoneState->threads.erase(retired, zoneState->threads.end());
+            zoneState->id.store(++Implementation::profilerIdCounter, std::memory_order_release);
+        }
+    }
+
+    /* Start timestamp calibration */
+    zoneState->calibrationTime = steady_clock::now();
+    zoneState->calibrationTicks = Implementation::timestamp();
+
+    enabled = true;
 }
 
 void Profiler::disable() {
+    if(gpuState) endGpuQuery();
     enabled = false;
 }
 
@@ -61,18 +291,28 @@ void Profiler::start(Section section) {
     CORRADE_ASSERT(section < sections.size(), "Profiler: unknown section passed to start()", );
 
     save();
+    if(gpuState) endGpuQuery();
 
     currentSection = section;
+    if(gpuState && (sectionFlags[section] & SectionFlag::GpuTime)) beginGpuQuery();
 }
 
 void Profiler::stop() {
     if(!enabled) return;
 
     save();
+    if(gpuState) endGpuQuery();
 
     previousTime = high_resolution_clock::time_point();
 }
 
+void Profiler::addTime(const Section section, const std::chrono::nanoseconds duration) {
+    if(!enabled) return;
+    CORRADE_ASSERT(section < sections.size(), "Profiler: unknown section passed to addTime()", );
+
+    frameData[currentFrame*sections.size()+section] += duration_cast<high_resolution_clock::duration>(duration);
+}
+
 void Profiler::save() {
     auto now = high_resolution_clock::now();
 
@@ -84,11 +324,50 @@ void Profiler::save() {
     previousTime = now;
 }
 
+void Profiler::beginGpuQuery() {
+    Implementation::ProfilerGpuState::Frame& frame = gpuState->frames[gpuState->current];
+    if(frame.used == frame.queries.size()) {
+        frame.queries.emplace_back();
+        frame.sections.emplace_back();
+    }
+
+    frame.queries[frame.used].begin(TimeQuery::Target::TimeElapsed);
+    frame.sections[frame.used] = currentSection;
+    ++frame.used;
+    gpuState->running = true;
+}
+
+void Profiler::endGpuQuery() {
+    if(!gpuState->running) return;
+
+    Implementation::ProfilerGpuState::Frame& frame = gpuState->frames[gpuState->current];
+    frame.queries[frame.used-1].end();
+    gpuState->running = false;
+}
+
+void Profiler::readGpuQueries(const std::size_t frameIndex) {
+    Implementation::ProfilerGpuState::Frame& frame = gpuState->frames[gpuState->current];
+    if(!frame.used) return;
+
+    /* Queries finish in order, so if the last one isn't available, drop the
+       whole frame instead of stalling */
+    if(!frame.queries[frame.used-1].resultAvailable()) {
+        ++_droppedGpuFrameCount;
+        frame.used = 0;
+        return;
+    }
+
+    for(std::size_t i = 0; i != frame.used; ++i)
+        gpuFrameData[frameIndex*sections.size()+frame.sections[i]] += std::chrono::nanoseconds(frame.queries[i].result<UnsignedLong>());
+    gpuFrameValid[frameIndex] = true;
+    frame.used = 0;
+}
+
 void Profiler::nextFrame() {
     if(!enabled) return;
 
     /* Next frame index */
-    std::size_t nextFrame = (currentFrame+1) % measureDuration;
+    std::size_t nextFrame = (currentFrame+1) % (measureDuration+1);
 
     /* Add times of current frame to total */
     for(std::size_t i = 0; i != sections.size(); ++i)
@@ -100,6 +379,31 @@ void Profiler::nextFrame() {
         frameData[nextFrame*sections.size()+i] = high_resolution_clock::duration::zero();
     }
 
+    /* The same for GPU times, counting only frames with available results */
+    if(gpuState) {
+        for(std::size_t i = 0; i != sections.size(); ++i)
+            gpuTotalData[i] += gpuFrameData[currentFrame*sections.size()+i];
+        if(gpuFrameValid[currentFrame]) ++gpuFrameCount;
+
+        for(std::size_t i = 0; i != sections.size(); ++i) {
+            gpuTotalData[i] -= gpuFrameData[nextFrame*sections.size()+i];
+            gpuFrameData[nextFrame*sections.size()+i] = std::chrono::nanoseconds::zero();
+        }
+        if(gpuFrameValid[nextFrame]) --gpuFrameCount;
+        gpuFrameValid[nextFrame] = false;
+
+        /* Query running across frame boundary is split between both frames */
+        const bool running = gpuState->running;
+        endGpuQuery();
+
+        /* Advance to next query frame and read results of queries issued
+           gpuLatency() frames ago into the next frame */
+        gpuState->current = (gpuState->current+1) % gpuState->frames.size();
+        readGpuQueries(nextFrame);
+
+        if(running) beginGpuQuery();
+    }
+
     /* Advance to next frame */
     currentFrame = nextFrame;
 
@@ -114,9 +418,188 @@ void Profiler::printStatistics() {
 
     std::sort(totalSorted.begin(), totalSorted.end(), [this](std::size_t i, std::size_t j){return totalData[i] > totalData[j];});
 
+    const Statistics frame = frameStatistics();
     Debug() << "Statistics for last" << measureDuration << "frames:";
-    for(std::size_t i = 0; i != sections.size(); ++i)
-        Debug() << " " << sections[totalSorted[i]] << duration_cast<microseconds>(totalData[totalSorted[i]]).count()/frameCount << u8"µs";
+    Debug() << "  Frame" << duration_cast<microseconds>(frame.mean).count() << u8"µs, p99" << duration_cast<microseconds>(frame.percentile99).count() << u8"µs, max" << duration_cast<microseconds>(frame.max).count() << u8"µs";
+    for(std::size_t i = 0; i != sections.size(); ++i) {
+        const Section section = totalSorted[i];
+        const Statistics cpu = statistics(section);
+        if(sectionFlags[section] & SectionFlag::GpuTime) {
+            const Statistics gpu = gpuStatistics(section);
+            Debug() << " " << sections[section] << duration_cast<microseconds>(cpu.mean).count() << u8"µs, p99" << duration_cast<microseconds>(cpu.percentile99).count() << u8"µs, max" << duration_cast<microseconds>(cpu.max).count() << u8"µs, GPU" << duration_cast<microseconds>(gpu.mean).count() << u8"µs, p99" << duration_cast<microseconds>(gpu.percentile99).count() << u8"µs, max" << duration_cast<microseconds>(gpu.max).count() << u8"µs";
+        } else Debug() << " " << sections[section] << duration_cast<microseconds>(cpu.mean).count() << u8"µs, p99" << duration_cast<microseconds>(cpu.percentile99).count() << u8"µs, max" << duration_cast<microseconds>(cpu.max).count() << u8"µs";
+    }
+}
+
+Profiler::Statistics Profiler::statistics(const Section section) const {
+    CORRADE_ASSERT(section < sections.size(), "Profiler: unknown section passed to statistics()", {});
+
+    /* Measured frames are the ones before current frame */
+    std::vector<nanoseconds> samples;
+    samples.reserve(frameCount);
+    for(std::size_t i = 1; i <= frameCount; ++i) {
+        const std::size_t frame = (currentFrame+measureDuration+1-i) % (measureDuration+1);
+        samples.push_back(duration_cast<nanoseconds>(frameData[frame*sections.size()+section]));
+    }
+
+    return Implementation::statistics(samples);
+}
+
+Profiler::Statistics Profiler::gpuStatistics(const Section section) const {
+    CORRADE_ASSERT(section < sections.size(), "Profiler: unknown section passed to gpuStatistics()", {});
+
+    std::vector<nanoseconds> samples;
+    if(gpuState && (sectionFlags[section] & SectionFlag::GpuTime)) {
+        samples.reserve(gpuFrameCount);
+        for(std::size_t i = 1; i <= frameCount; ++i) {
+            const std::size_t frame = (currentFrame+measureDuration+1-i) % (measureDuration+1);
+            if(gpuFrameValid[frame])
+                samples.push_back(gpuFrameData[frame*sections.size()+section]);
+        }
+    }
+
+    return Implementation::statistics(samples);
+}
+
+Profiler::Statistics Profiler::frameStatistics() const {
+    std::vector<nanoseconds> samples;
+    samples.reserve(frameCount);
+    for(std::size_t i = 1; i <= frameCount; ++i) {
+        const std::size_t frame = (currentFrame+measureDuration+1-i) % (measureDuration+1);
+        high_resolution_clock::duration sum = high_resolution_clock::duration::zero();
+        for(std::size_t j = 0; j != sections.size(); ++j)
+            sum += frameData[frame*sections.size()+j];
+        samples.push_back(duration_cast<nanoseconds>(sum));
+    }
+
+    return Implementation::statistics(samples);
+}
+
+std::chrono::nanoseconds Profiler::averageTime(const Section section) const {
+    CORRADE_ASSERT(section < sections.size(), "Profiler: unknown section passed to averageTime()", {});
+    if(!frameCount) return {};
+    return duration_cast<nanoseconds>(totalData[section])/frameCount;
+}
+
+std::chrono::nanoseconds Profiler::averageGpuTime(const Section section) const {
+    CORRADE_ASSERT(section < sections.size(), "Profiler: unknown section passed to averageGpuTime()", {});
+    if(!gpuFrameCount) return {};
+    return gpuTotalData[section]/gpuFrameCount;
+}
+
+std::size_t Profiler::zoneCapacity() const {
+    return zoneState->capacity;
+}
+
+void Profiler::setZoneCapacity(std::size_t zones) {
+    CORRADE_ASSERT(!enabled, "Profiler: cannot set zone capacity when profiling is enabled", );
+
+    /* Zones opened concurrently on other threads might be creating buffers */
+    std::lock_guard<std::mutex> lock(zoneState->mutex);
+    zoneState->capacity = zones;
+}
+
+std::size_t Profiler::zoneCount() const {
+    std::lock_guard<std::mutex> lock(zoneState->mutex);
+    std::size_t count = 0;
+    for(const auto& buffer: zoneState->threads)
+        count += Implementation::countOf(buffer->size.load(std::memory_order_acquire));
+    return count;
+}
+
+std::size_t Profiler::droppedZoneCount() const {
+    std::lock_guard<std::mutex> lock(zoneState->mutex);
+    std::size_t count = 0;
+    for(const auto& buffer: zoneState->threads)
+        count += Implementation::countOf(buffer->dropped.load(std::memory_order_relaxed));
+    return count;
+}
+
+void Profiler::writeTrace(std::ostream& out) const {
+    /* Finish timestamp calibration. Make the interval at least a few
+       milliseconds long to have reasonable precision. */
+    steady_clock::time_point time = steady_clock::now();
+    if(time - zoneState->calibrationTime < milliseconds(10)) {
+        std::this_thread::sleep_until(zoneState->calibrationTime + milliseconds(10));
+        time = steady_clock::now();
+    }
+    const UnsignedLong ticks = Implementation::timestamp();
+    const double microsecondsPerTick = duration_cast<duration<double, std::micro>>(time - zoneState->calibrationTime).count()/(ticks - zoneState->calibrationTicks);
+
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out.setf(std::ios::fixed, std::ios::floatfield);
+    out.precision(3);
+
+    out << "{\"traceEvents\":[";
+
+    std::lock_guard<std::mutex> lock(zoneState->mutex);
+    bool first = true;
+    for(std::size_t i = 0; i != zoneState->threads.size(); ++i) {
+        const Implementation::ProfilerThreadBuffer& buffer = *zoneState->threads[i];
+
+        out << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << i << ",\"args\":{\"name\":\"Thread " << i << "\"}}";
+        first = false;
+
+        const std::size_t size = Implementation::countOf(buffer.size.load(std::memory_order_acquire));
+        for(std::size_t j = 0; j != size; ++j) {
+            const Implementation::ZoneEvent& event = buffer.events[j];
+            out << ",\n{\"name\":";
+            Implementation::writeJsonString(out, event.name);
+            out << ",\"cat\":\"zone\",\"ph\":\"X\",\"ts\":"
+                << (static_cast<double>(event.begin) - static_cast<double>(zoneState->calibrationTicks))*microsecondsPerTick
+                << ",\"dur\":" << (event.end - event.begin)*microsecondsPerTick
+                << ",\"pid\":0,\"tid\":" << i << '}';
+        }
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+bool Profiler::writeTrace(const std::string& filename) const {
+    std::ofstream out(filename, std::ofstream::binary);
+    if(!out.good()) {
+        Error() << "DebugTools::Profiler::writeTrace(): cannot write to file" << filename;
+        return false;
+    }
+
+    writeTrace(out);
+    return true;
+}
+
+Profiler::Zone::Zone(Profiler& profiler, const char* name): _buffer(nullptr), _generation(0), _name(name), _begin(0) {
+    if(!profiler.enabled.load(std::memory_order_relaxed)) return;
+
+    _buffer = profiler.zoneState->threadBuffer();
+    _generation = Implementation::generationOf(_buffer->size.load(std::memory_order_relaxed));
+    _begin = Implementation::timestamp();
+}
+
+Profiler::Zone::~Zone() {
+    if(!_buffer) return;
+
+    const UnsignedLong end = Implementation::timestamp();
+
+    /* The profiler was enabled again since the zone was opened */
+    UnsignedLong size = _buffer->size.load(std::memory_order_relaxed);
+    if(Implementation::generationOf(size) != _generation) return;
+
+    /* If enable() resets the counts meanwhile, the exchange fails and nothing
+       is recorded */
+    if(Implementation::countOf(size) == _buffer->capacity) {
+        UnsignedLong dropped = _buffer->dropped.load(std::memory_order_relaxed);
+        if(Implementation::generationOf(dropped) == _generation)
+            _buffer->dropped.compare_exchange_strong(dropped, dropped + 1, std::memory_order_relaxed);
+        return;
+    }
+
+    /* Writing the event past the reset count is harmless, as only this thread
+       writes the events */
+    _buffer->events[Implementation::countOf(size)] = {_name, _begin, end};
+    _buffer->size.compare_exchange_strong(size, size + 1, std::memory_order_release, std::memory_order_relaxed);
 }
 
 }}
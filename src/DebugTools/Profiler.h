@@ -28,16 +28,26 @@
  * @brief Class Magnum::DebugTools::Profiler
  */
 
+#include <atomic>
 #include <chrono>
 #include <initializer_list>
+#include <iosfwd>
+#include <memory>
 #include <string>
 #include <vector>
+#include <Containers/EnumSet.h>
 
-#include "Types.h"
+#include "Magnum.h"
 #include "magnumDebugToolsVisibility.h"
 
 namespace Magnum { namespace DebugTools {
 
+namespace Implementation {
+    struct ProfilerGpuState;
+    struct ProfilerZoneState;
+    struct ProfilerThreadBuffer;
+}
+
 /**
 @brief %Profiler
 
@@ -95,7 +105,69 @@ p.printStatistics();
 It's possible to start profiler only for certain parts of the code and then
 stop it again using stop(), if you are not interested in profiling the rest.
 
-@todo Some unit testing
+@section Profiler-statistics Statistics
+
+Averages hide occasional spikes in frame time. Apart from printing the
+statistics to debug output using printStatistics(), statistics() and
+frameStatistics() return also median, 95th and 99th percentile, maximum and
+variance over last measured frames, which can be used for example in
+automated performance tests:
+@code
+DebugTools::Profiler::Statistics s = p.frameStatistics();
+CORRADE_VERIFY(s.percentile99 < std::chrono::milliseconds(20));
+@endcode
+
+@section Profiler-gpu GPU time
+
+CPU time of sections with OpenGL calls says nothing about how long the GPU
+actually spent processing them. Sections added with @ref SectionFlag::GpuTime
+issue also a @ref TimeQuery with @ref TimeQuery::Target::TimeElapsed "TimeElapsed"
+target. To avoid stalling the pipeline, the results are read back only after
+gpuLatency() frames from a ring of reused query objects. If the results are
+still not available at that time, the data for given frame are dropped
+instead of waiting, see droppedGpuFrameCount(). The GPU time is then averaged
+the same way as CPU time and printed side by side with it in
+printStatistics(), or available through averageGpuTime().
+@code
+sections.draw = p.addSection("Drawing", DebugTools::Profiler::SectionFlag::GpuTime);
+@endcode
+
+@section Profiler-zones Hierarchical zones
+
+Apart from the flat sections above, the profiler can record nested scoped
+zones from any thread. Zones don't need to be registered upfront, they are
+identified only by name, which must be a string with static storage duration
+(e.g. a string literal). The zone is measured from its construction to its
+destruction:
+@code
+void Physics::step() {
+    DebugTools::Profiler::Zone zone(p, "Physics");
+
+    {
+        DebugTools::Profiler::Zone zone(p, "Broadphase");
+        // ...
+    }
+
+    {
+        DebugTools::Profiler::Zone zone(p, "Narrowphase");
+        // ...
+    }
+}
+@endcode
+
+Each thread records into its own preallocated buffer, so recording a zone
+doesn't take any lock and costs only two timestamp reads and a store. On x86
+the timestamps are taken from the CPU timestamp counter and converted to real
+time using a calibration against `std::chrono::steady_clock` done between
+enable() and the export, elsewhere the steady clock is used directly. The
+timestamp counter is expected to run at constant rate, which is the case on
+all reasonably recent x86 CPUs. If the per-thread buffer is full, further
+zones are dropped, see setZoneCapacity() and droppedZoneCount().
+
+Recorded zones can be exported using writeTrace() to the Chrome trace-event
+JSON format, which can be then opened in `chrome://tracing` or any other
+compatible viewer.
+
 @todo More time intervals
 */
 class MAGNUM_DEBUGTOOLS_EXPORT Profiler {
@@ -114,7 +186,53 @@ class MAGNUM_DEBUGTOOLS_EXPORT Profiler {
          */
         static const Section otherSection = 0;
 
-        explicit Profiler(): enabled(false), measureDuration(60), currentFrame(0), frameCount(0), sections{"Other"}, currentSection(otherSection) {}
+        /**
+         * @brief Section flag
+         *
+         * @see @ref SectionFlags, addSection()
+         */
+        enum class SectionFlag: UnsignedByte {
+            /**
+             * Measure also GPU time of the section.
+             * @requires_gl33 %Extension @extension{ARB,timer_query}
+             * @requires_es_extension %Extension @es_extension{EXT,disjoint_timer_query}
+             */
+            GpuTime = 1 << 0
+        };
+
+        /**
+         * @brief Section flags
+         *
+         * @see addSection()
+         */
+        typedef Containers::EnumSet<SectionFlag, UnsignedByte> SectionFlags;
+
+        class Zone;
+
+        /**
+         * @brief Duration statistics
+         *
+         * Percentiles are computed using nearest-rank method over the last
+         * measured frames.
+         * @see statistics(), gpuStatistics(), frameStatistics()
+         */
+        struct Statistics {
+            /** @brief Count of frames the statistics are computed from */
+            std::size_t frameCount;
+
+            std::chrono::nanoseconds mean,      /**< @brief Mean */
+                median,                         /**< @brief Median (50th percentile) */
+                percentile95,                   /**< @brief 95th percentile */
+                percentile99,                   /**< @brief 99th percentile */
+                max;                            /**< @brief Maximum */
+
+            /** @brief Variance in squared nanoseconds */
+            double variance;
+        };
+
+        explicit Profiler();
+
+        ~Profiler();
 
         /**
          * @brief Set measure duration
@@ -125,26 +243,45 @@ class MAGNUM_DEBUGTOOLS_EXPORT Profiler {
          */
         void setMeasureDuration(std::size_t frames);
 
+        /**
+         * @brief GPU query latency
+         *
+         * @see setGpuLatency()
+         */
+        std::size_t gpuLatency() const { return _gpuLatency; }
+
+        /**
+         * @brief Set GPU query latency
+         *
+         * Count of frames after which results of GPU time queries are read
+         * back. Default value is `3`.
+         * @attention This function cannot be called if profiling is enabled.
+         * @see @ref Profiler-gpu "GPU time"
+         */
+        void setGpuLatency(std::size_t frames);
+
         /**
          * @brief Add named section
          *
          * @attention This function cannot be called if profiling is enabled.
          * @see otherSection, start(Section), stop()
          */
-        Section addSection(const std::string& name);
+        Section addSection(const std::string& name, SectionFlags flags = SectionFlags());
 
         /**
          * @brief Whether profiling is enabled
          *
          * If the profiling is not enabled, calls to start() and stop() have
-         * no effect.
+         * no effect and no zones are recorded.
          */
-        bool isEnabled() { return enabled; }
+        bool isEnabled() const { return enabled; }
 
         /**
          * @brief Enable profiling
          *
-         * Clears already mesaured data.
+         * Clears already mesaured data, including recorded zones. Zones
+         * which are open on any thread while calling this function are not
+         * recorded.
          * @see disable(), isEnabled()
          */
         void enable();
@@ -181,6 +318,16 @@ class MAGNUM_DEBUGTOOLS_EXPORT Profiler {
          */
         void stop();
 
+        /**
+         * @brief Add time to given section
+         *
+         * Adds externally measured @p duration to CPU time of given section
+         * in current frame, for example time reported by third-party
+         * library. Doesn't affect currently measured section.
+         * @note Does nothing if profiling is disabled.
+         */
+        void addTime(Section section, std::chrono::nanoseconds duration);
+
         /**
          * @brief Save data from previous frame and advance to another
          *
@@ -192,21 +339,175 @@ class MAGNUM_DEBUGTOOLS_EXPORT Profiler {
         /**
          * @brief Print statistics
          *
-         * Prints statistics about previous frame ordered by duration.
+         * Prints statistics about previous frames ordered by average
+         * duration, together with 99th percentile and maximum.
          * @note Does nothing if profiling is disabled.
+         * @see statistics(), frameStatistics()
          */
         void printStatistics();
 
+        /**
+         * @brief CPU time statistics of given section
+         *
+         * Computed over last measured frames.
+         * @see setMeasureDuration(), averageTime()
+         */
+        Statistics statistics(Section section) const;
+
+        /**
+         * @brief GPU time statistics of given section
+         *
+         * Computed over last measured frames for which GPU query results
+         * were available. Returns zero statistics for sections without
+         * @ref SectionFlag::GpuTime.
+         * @see setMeasureDuration(), averageGpuTime()
+         */
+        Statistics gpuStatistics(Section section) const;
+
+        /**
+         * @brief Frame time statistics
+         *
+         * Frame time is sum of CPU times of all sections, computed over last
+         * measured frames.
+         * @see setMeasureDuration()
+         */
+        Statistics frameStatistics() const;
+
+        /**
+         * @brief Average CPU time of given section
+         *
+         * Averaged over last measured frames.
+         * @see setMeasureDuration()
+         */
+        std::chrono::nanoseconds averageTime(Section section) const;
+
+        /**
+         * @brief Average GPU time of given section
+         *
+         * Averaged over last measured frames for which GPU query results
+         * were available. Returns zero duration for sections without
+         * @ref SectionFlag::GpuTime.
+         * @see setMeasureDuration(), @ref Profiler-gpu "GPU time"
+         */
+        std::chrono::nanoseconds averageGpuTime(Section section) const;
+
+        /**
+         * @brief Count of frames with dropped GPU time
+         *
+         * Count of frames since last call to enable() for which the GPU query
+         * results weren't available after gpuLatency() frames.
+         */
+        std::size_t droppedGpuFrameCount() const { return _droppedGpuFrameCount; }
+
+        /**
+         * @brief Per-thread zone capacity
+         *
+         * @see setZoneCapacity()
+         */
+        std::size_t zoneCapacity() const;
+
+        /**
+         * @brief Set per-thread zone capacity
+         *
+         * Count of zones which can be recorded in each thread until next
+         * call to enable(). Default value is `65536`.
+         * @attention This function cannot be called if profiling is enabled.
+         */
+        void setZoneCapacity(std::size_t zones);
+
+        /** @brief Count of zones recorded since last call to enable() */
+        std::size_t zoneCount() const;
+
+        /**
+         * @brief Count of dropped zones
+         *
+         * Count of zones which didn't fit into per-thread buffers since last
+         * call to enable().
+         * @see setZoneCapacity()
+         */
+        std::size_t droppedZoneCount() const;
+
+        /**
+         * @brief Write recorded zones in Chrome trace-event format
+         *
+         * Writes all zones recorded since last call to enable() as complete
+         * events (`"ph":"X"`) with time in microseconds relative to the
+         * enable() call and one track per thread. Zones which are still open
+         * are not written.
+         */
+        void writeTrace(std::ostream& out) const;
+
+        /**
+         * @brief Write recorded zones in Chrome trace-event format to file
+         *
+         * Returns `false` if the file cannot be written, `true` otherwise.
+         * @see writeTrace(std::ostream&) const
+         */
+        bool writeTrace(const std::string& filename) const;
+
     private:
         void save();
+        void beginGpuQuery();
+        void endGpuQuery();
+        void readGpuQueries(std::size_t frame);
 
-        bool enabled;
+        std::atomic<bool> enabled;
         std::size_t measureDuration, currentFrame, frameCount;
         std::vector<std::string> sections;
+        std::vector<SectionFlags> sectionFlags;
         std::vector<std::chrono::high_resolution_clock::duration> frameData;
         std::vector<std::chrono::high_resolution_clock::duration> totalData;
         std::chrono::high_resolution_clock::time_point previousTime;
         Section currentSection;
+        std::unique_ptr<Implementation::ProfilerZoneState> zoneState;
+
+        std::size_t _gpuLatency, gpuFrameCount, _droppedGpuFrameCount;
+        std::vector<std::chrono::nanoseconds> gpuFrameData;
+        std::vector<std::chrono::nanoseconds> gpuTotalData;
+        std::vector<bool> gpuFrameValid;
+        std::unique_ptr<Implementation::ProfilerGpuState> gpuState;
+};
+
+CORRADE_ENUMSET_OPERATORS(Profiler::SectionFlags)
+
+/**
+@brief Scoped profiler zone
+
+Measures time from construction to destruction and records it to per-thread
+buffer of given profiler. If the profiler is not enabled at the time of
+construction, nothing is recorded. See @ref Profiler-zones "Profiler" for an
+example.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT Profiler::Zone {
+    public:
+        /**
+         * @brief Constructor
+         * @param profiler  %Profiler to record to
+         * @param name      Zone name. Must be a string with static storage
+         *      duration, as only the pointer is saved.
+         */
+        explicit Zone(Profiler& profiler, const char* name);
+
+        /** @brief Copying is not allowed */
+        Zone(const Zone&) = delete;
+
+        /** @brief Moving is not allowed */
+        Zone(Zone&&) = delete;
+
+        /** @brief Records the zone */
+        ~Zone();
+
+        /** @brief Copying is not allowed */
+        Zone& operator=(const Zone&) = delete;
+
+        /** @brief Moving is not allowed */
+        Zone& operator=(Zone&&) = delete;
+
+    private:
+        Implementation::ProfilerThreadBuffer* _buffer;
+        UnsignedInt _generation;
+        const char* _name;
+        UnsignedLong _begin;
 };
 
 }}
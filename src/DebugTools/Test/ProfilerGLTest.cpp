@@ -0,0 +1,126 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <thread>
+
+#include "Context.h"
+#include "Extensions.h"
+#include "DebugTools/Profiler.h"
+#include "Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace DebugTools { namespace Test {
+
+class ProfilerGLTest: public Magnum::Test::AbstractOpenGLTester {
+    public:
+        explicit ProfilerGLTest();
+
+        void gpuTime();
+        void gpuTimeAcrossFrames();
+};
+
+ProfilerGLTest::ProfilerGLTest() {
+    addTests({&ProfilerGLTest::gpuTime,
+              &ProfilerGLTest::gpuTimeAcrossFrames});
+}
+
+void ProfilerGLTest::gpuTime() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current()->isExtensionSupported<Extensions::GL::ARB::timer_query>())
+        CORRADE_SKIP(Extensions::GL::ARB::timer_query::string() + std::string(" is not supported."));
+    #else
+    if(!Context::current()->isExtensionSupported<Extensions::GL::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(Extensions::GL::EXT::disjoint_timer_query::string() + std::string(" is not supported."));
+    #endif
+
+    Profiler p;
+    p.setMeasureDuration(4);
+    p.setGpuLatency(2);
+    const Profiler::Section cpu = p.addSection("CPU");
+    const Profiler::Section gpu = p.addSection("GPU", Profiler::SectionFlag::GpuTime);
+    p.enable();
+
+    for(std::size_t i = 0; i != 8; ++i) {
+        p.start(cpu);
+        p.start(gpu);
+        /* GPU time includes the wait between query begin and end */
+        Renderer::finish();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        p.stop();
+
+        /* Make sure the results are available when read */
+        Renderer::finish();
+        p.nextFrame();
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(p.droppedGpuFrameCount(), 0);
+    CORRADE_VERIFY(p.averageTime(gpu) >= std::chrono::milliseconds(1));
+    CORRADE_VERIFY(p.averageGpuTime(gpu) > std::chrono::nanoseconds::zero());
+    CORRADE_COMPARE(p.averageGpuTime(cpu).count(), 0);
+    CORRADE_COMPARE(p.gpuStatistics(gpu).frameCount, 4);
+    CORRADE_COMPARE(p.gpuStatistics(gpu).mean.count(), p.averageGpuTime(gpu).count());
+    CORRADE_COMPARE(p.gpuStatistics(cpu).frameCount, 0);
+
+    /* Re-enabling reuses the queries */
+    p.enable();
+    p.start(gpu);
+    p.stop();
+    p.nextFrame();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(p.averageGpuTime(gpu).count(), 0);
+}
+
+void ProfilerGLTest::gpuTimeAcrossFrames() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current()->isExtensionSupported<Extensions::GL::ARB::timer_query>())
+        CORRADE_SKIP(Extensions::GL::ARB::timer_query::string() + std::string(" is not supported."));
+    #else
+    if(!Context::current()->isExtensionSupported<Extensions::GL::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(Extensions::GL::EXT::disjoint_timer_query::string() + std::string(" is not supported."));
+    #endif
+
+    /* With latency of one frame the query ended in nextFrame() would be read
+       back right away, before the GPU had a chance to finish it */
+    Profiler p;
+    p.setGpuLatency(2);
+    const Profiler::Section gpu = p.addSection("GPU", Profiler::SectionFlag::GpuTime);
+    p.enable();
+
+    /* Section is never stopped, the query is split at frame boundaries */
+    p.start(gpu);
+    for(std::size_t i = 0; i != 4; ++i) {
+        Renderer::finish();
+        p.nextFrame();
+    }
+    p.disable();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(p.droppedGpuFrameCount(), 0);
+    CORRADE_VERIFY(p.averageGpuTime(gpu) > std::chrono::nanoseconds::zero());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::ProfilerGLTest)
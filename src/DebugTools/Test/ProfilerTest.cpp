@@ -0,0 +1,376 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <TestSuite/Tester.h>
+
+#include "Magnum.h"
+#include "DebugTools/Profiler.h"
+
+namespace Magnum { namespace DebugTools { namespace Test {
+
+class ProfilerTest: public TestSuite::Tester {
+    public:
+        explicit ProfilerTest();
+
+        void statistics();
+        void statisticsEmpty();
+        void statisticsWindow();
+        void addTimeDisabled();
+
+        void zoneDisabled();
+        void zoneNested();
+        void zoneThreads();
+        void zoneDropped();
+        void zoneEnableClears();
+        void zoneEnableOpen();
+        void zoneEnableConcurrent();
+        void traceTimestamps();
+        void traceEscape();
+
+        void zoneOverhead();
+};
+
+namespace {
+    /* Extracts value of numeric field of n-th event with given name */
+    double traceField(const std::string& trace, const std::string& name, const std::string& field, std::size_t n = 0) {
+        std::size_t pos = 0;
+        for(std::size_t i = 0; i <= n; ++i) {
+            pos = trace.find("{\"name\":\"" + name + "\"", pos);
+            if(pos == std::string::npos) return -1.0;
+            ++pos;
+        }
+        pos = trace.find("\"" + field + "\":", pos);
+        return std::stod(trace.substr(pos + field.size() + 3));
+    }
+}
+
+ProfilerTest::ProfilerTest() {
+    addTests({&ProfilerTest::statistics,
+              &ProfilerTest::statisticsEmpty,
+              &ProfilerTest::statisticsWindow,
+              &ProfilerTest::addTimeDisabled,
+
+              &ProfilerTest::zoneDisabled,
+              &ProfilerTest::zoneNested,
+              &ProfilerTest::zoneThreads,
+              &ProfilerTest::zoneDropped,
+              &ProfilerTest::zoneEnableClears,
+              &ProfilerTest::zoneEnableOpen,
+              &ProfilerTest::zoneEnableConcurrent,
+              &ProfilerTest::traceTimestamps,
+              &ProfilerTest::traceEscape,
+
+              &ProfilerTest::zoneOverhead});
+}
+
+void ProfilerTest::statistics() {
+    Profiler p;
+    p.setMeasureDuration(20);
+    const Profiler::Section section = p.addSection("Section");
+    p.enable();
+
+    /* One spike in twenty frames */
+    for(std::size_t i = 0; i != 20; ++i) {
+        p.addTime(section, std::chrono::milliseconds(i == 7 ? 20 : 1));
+        p.nextFrame();
+    }
+
+    const Profiler::Statistics s = p.statistics(section);
+    CORRADE_COMPARE(s.frameCount, 20);
+    CORRADE_COMPARE(s.mean.count(), 1950000);
+    CORRADE_COMPARE(s.median.count(), 1000000);
+    CORRADE_COMPARE(s.percentile95.count(), 1000000);
+    CORRADE_COMPARE(s.percentile99.count(), 20000000);
+    CORRADE_COMPARE(s.max.count(), 20000000);
+    CORRADE_COMPARE(s.mean.count(), p.averageTime(section).count());
+
+    /* 19 ms spike in one of twenty frames: 19²*19/20² */
+    CORRADE_COMPARE(s.variance, 17.1475e12);
+
+    /* Nothing measured in other section, nothing measured on GPU */
+    CORRADE_COMPARE(p.statistics(Profiler::otherSection).max.count(), 0);
+    CORRADE_COMPARE(p.gpuStatistics(section).frameCount, 0);
+
+    /* Frame time is sum of all sections */
+    const Profiler::Statistics frame = p.frameStatistics();
+    CORRADE_COMPARE(frame.frameCount, 20);
+    CORRADE_COMPARE(frame.max.count(), s.max.count());
+    CORRADE_COMPARE(frame.mean.count(), s.mean.count());
+}
+
+void ProfilerTest::statisticsEmpty() {
+    Profiler p;
+    const Profiler::Section section = p.addSection("Section");
+    p.enable();
+
+    const Profiler::Statistics s = p.statistics(section);
+    CORRADE_COMPARE(s.frameCount, 0);
+    CORRADE_COMPARE(s.median.count(), 0);
+    CORRADE_COMPARE(s.max.count(), 0);
+    CORRADE_COMPARE(s.variance, 0.0);
+    CORRADE_COMPARE(p.frameStatistics().frameCount, 0);
+}
+
+void ProfilerTest::statisticsWindow() {
+    Profiler p;
+    p.setMeasureDuration(3);
+    const Profiler::Section section = p.addSection("Section");
+    p.enable();
+
+    /* The spike falls out of the window after three frames */
+    for(std::size_t i = 0; i != 4; ++i) {
+        p.addTime(section, std::chrono::milliseconds(i == 0 ? 20 : 1));
+        p.nextFrame();
+    }
+
+    const Profiler::Statistics s = p.statistics(section);
+    CORRADE_COMPARE(s.frameCount, 3);
+    CORRADE_COMPARE(s.max.count(), 1000000);
+    CORRADE_COMPARE(s.mean.count(), 1000000);
+    CORRADE_COMPARE(p.averageTime(section).count(), 1000000);
+}
+
+void ProfilerTest::addTimeDisabled() {
+    Profiler p;
+    const Profiler::Section section = p.addSection("Section");
+
+    /* No data are allocated before enabling, nothing should be touched */
+    p.addTime(section, std::chrono::milliseconds(1));
+    p.enable();
+    p.nextFrame();
+    CORRADE_COMPARE(p.statistics(section).frameCount, 1);
+    CORRADE_COMPARE(p.statistics(section).max.count(), 0);
+}
+
+void ProfilerTest::zoneDisabled() {
+    Profiler p;
+    {
+        Profiler::Zone zone(p, "Disabled");
+    }
+
+    CORRADE_COMPARE(p.zoneCount(), 0);
+
+    std::ostringstream out;
+    p.writeTrace(out);
+    CORRADE_COMPARE(out.str(), "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ns\"}\n");
+}
+
+void ProfilerTest::zoneNested() {
+    Profiler p;
+    p.enable();
+    {
+        Profiler::Zone outer(p, "Outer");
+        {
+            Profiler::Zone inner(p, "Inner");
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        {
+            Profiler::Zone inner(p, "Inner");
+        }
+    }
+
+    CORRADE_COMPARE(p.zoneCount(), 3);
+    CORRADE_COMPARE(p.droppedZoneCount(), 0);
+
+    std::ostringstream out;
+    p.writeTrace(out);
+    const std::string trace = out.str();
+
+    /* Inner zones are recorded first, as they end first */
+    CORRADE_VERIFY(trace.find("\"name\":\"Inner\"") < trace.find("\"name\":\"Outer\""));
+    CORRADE_VERIFY(trace.find("\"ph\":\"X\"") != std::string::npos);
+
+    /* Inner zones are fully inside the outer one */
+    const double outerBegin = traceField(trace, "Outer", "ts");
+    const double outerEnd = outerBegin + traceField(trace, "Outer", "dur");
+    const double innerBegin = traceField(trace, "Inner", "ts");
+    const double innerEnd = traceField(trace, "Inner", "ts", 1) + traceField(trace, "Inner", "dur", 1);
+    CORRADE_VERIFY(outerBegin >= 0.0);
+    CORRADE_VERIFY(innerBegin >= outerBegin);
+    CORRADE_VERIFY(innerEnd <= outerEnd);
+    CORRADE_VERIFY(traceField(trace, "Inner", "dur") >= 1000.0*0.9);
+}
+
+void ProfilerTest::zoneThreads() {
+    Profiler p;
+    p.enable();
+
+    auto work = [&p]() {
+        for(std::size_t i = 0; i != 100; ++i)
+            Profiler::Zone zone(p, "Work");
+    };
+    std::thread a(work), b(work);
+    a.join();
+    b.join();
+
+    CORRADE_COMPARE(p.zoneCount(), 200);
+
+    std::ostringstream out;
+    p.writeTrace(out);
+    const std::string trace = out.str();
+    CORRADE_VERIFY(trace.find("\"tid\":0,\"args\":{\"name\":\"Thread 0\"}") != std::string::npos);
+    CORRADE_VERIFY(trace.find("\"tid\":1,\"args\":{\"name\":\"Thread 1\"}") != std::string::npos);
+    CORRADE_VERIFY(trace.find("\"tid\":2") == std::string::npos);
+}
+
+void ProfilerTest::zoneDropped() {
+    Profiler p;
+    p.setZoneCapacity(2);
+    CORRADE_COMPARE(p.zoneCapacity(), 2);
+    p.enable();
+
+    for(std::size_t i = 0; i != 5; ++i)
+        Profiler::Zone zone(p, "Zone");
+
+    CORRADE_COMPARE(p.zoneCount(), 2);
+    CORRADE_COMPARE(p.droppedZoneCount(), 3);
+}
+
+void ProfilerTest::zoneEnableClears() {
+    Profiler p;
+    p.enable();
+    {
+        Profiler::Zone zone(p, "Zone");
+    }
+    CORRADE_COMPARE(p.zoneCount(), 1);
+
+    /* Changing capacity replaces the buffers */
+    p.disable();
+    p.setZoneCapacity(1);
+    p.enable();
+    CORRADE_COMPARE(p.zoneCount(), 0);
+    for(std::size_t i = 0; i != 2; ++i)
+        Profiler::Zone zone(p, "Zone");
+    CORRADE_COMPARE(p.zoneCount(), 1);
+    CORRADE_COMPARE(p.droppedZoneCount(), 1);
+}
+
+void ProfilerTest::zoneEnableOpen() {
+    Profiler p;
+    p.enable();
+
+    /* Zones open while enabling are not recorded, regardless of whether the
+       buffer is reused or replaced */
+    {
+        Profiler::Zone zone(p, "Open");
+        p.enable();
+    }
+    CORRADE_COMPARE(p.zoneCount(), 0);
+    {
+        Profiler::Zone zone(p, "Open");
+        p.disable();
+        p.setZoneCapacity(16);
+        p.enable();
+    }
+    CORRADE_COMPARE(p.zoneCount(), 0);
+    CORRADE_COMPARE(p.droppedZoneCount(), 0);
+
+    {
+        Profiler::Zone zone(p, "Closed");
+    }
+    CORRADE_COMPARE(p.zoneCount(), 1);
+}
+
+void ProfilerTest::zoneEnableConcurrent() {
+    Profiler p;
+    p.setZoneCapacity(8);
+    p.enable();
+
+    /* Enabling again with changing capacity while the other thread is
+       recording zones */
+    std::atomic<bool> running{true};
+    std::thread thread([&p, &running]() {
+        while(running.load(std::memory_order_relaxed))
+            Profiler::Zone zone(p, "Work");
+    });
+    for(std::size_t i = 0; i != 1000; ++i) {
+        p.disable();
+        p.setZoneCapacity(i % 3 ? 8 : 16);
+        p.enable();
+        CORRADE_VERIFY(p.zoneCount() <= 16);
+    }
+    running.store(false, std::memory_order_relaxed);
+    thread.join();
+}
+
+void ProfilerTest::traceTimestamps() {
+    Profiler p;
+    p.enable();
+
+    /* Converted timestamps should roughly match steady clock */
+    const auto begin = std::chrono::steady_clock::now();
+    {
+        Profiler::Zone zone(p, "Sleep");
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    const double expected = std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(std::chrono::steady_clock::now() - begin).count();
+
+    std::ostringstream out;
+    p.writeTrace(out);
+    const double duration = traceField(out.str(), "Sleep", "dur");
+    CORRADE_VERIFY(duration >= 20000.0*0.95);
+    CORRADE_VERIFY(duration <= expected*1.05);
+}
+
+void ProfilerTest::traceEscape() {
+    Profiler p;
+    p.enable();
+    {
+        Profiler::Zone zone(p, "A \"quoted\" \\ zone");
+    }
+
+    std::ostringstream out;
+    p.writeTrace(out);
+    CORRADE_VERIFY(out.str().find("{\"name\":\"A \\\"quoted\\\" \\\\ zone\"") != std::string::npos);
+}
+
+void ProfilerTest::zoneOverhead() {
+    constexpr std::size_t iterations = 100000;
+
+    Profiler p;
+    p.setZoneCapacity(iterations);
+    p.enable();
+
+    const auto begin = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i != iterations; ++i)
+        Profiler::Zone zone(p, "Overhead");
+    const auto end = std::chrono::steady_clock::now();
+
+    CORRADE_COMPARE(p.zoneCount(), iterations);
+    CORRADE_COMPARE(p.droppedZoneCount(), 0);
+
+    const double overhead = std::chrono::duration_cast<std::chrono::duration<double, std::nano>>(end - begin).count()/iterations;
+    Debug() << "Profiler::Zone overhead:" << overhead << "ns";
+
+    /* Generous bound to not fail on debug or instrumented builds */
+    CORRADE_VERIFY(overhead < 1000.0);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::ProfilerTest)
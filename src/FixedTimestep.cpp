@@ -0,0 +1,88 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FixedTimestep.h"
+
+#include <Utility/Assert.h>
+
+#include "Timeline.h"
+
+namespace Magnum {
+
+FixedTimestep::FixedTimestep(const Float tickDuration): _tickDuration(tickDuration), _maxTicksPerFrame(5), _accumulator(0.0), _time(0.0), _ticks(0), _droppedTicks(0) {
+    CORRADE_ASSERT(tickDuration > 0.0f, "FixedTimestep::FixedTimestep(): tick duration must be positive", );
+}
+
+FixedTimestep& FixedTimestep::setTickDuration(const Float seconds) {
+    CORRADE_ASSERT(seconds > 0.0f, "FixedTimestep::setTickDuration(): tick duration must be positive", *this);
+    _tickDuration = seconds;
+    return *this;
+}
+
+FixedTimestep& FixedTimestep::setMaxTicksPerFrame(const UnsignedInt count) {
+    CORRADE_ASSERT(count, "FixedTimestep::setMaxTicksPerFrame(): at least one tick per frame is needed", *this);
+    _maxTicksPerFrame = count;
+    return *this;
+}
+
+FixedTimestep& FixedTimestep::addCallback(Callback callback) {
+    _callbacks.push_back(std::move(callback));
+    return *this;
+}
+
+UnsignedInt FixedTimestep::update(const Float frameDuration) {
+    _accumulator += frameDuration;
+
+    UnsignedInt count = 0;
+    while(_accumulator >= _tickDuration) {
+        /* Drop all remaining whole ticks if over the limit, keep only the
+           fraction for interpolation */
+        if(count == _maxTicksPerFrame) {
+            const UnsignedLong dropped = UnsignedLong(_accumulator/_tickDuration);
+            _droppedTicks += dropped;
+            _accumulator -= dropped*double(_tickDuration);
+            break;
+        }
+
+        for(const Callback& callback: _callbacks) callback(Float(_time), _tickDuration);
+
+        _accumulator -= _tickDuration;
+        _time += _tickDuration;
+        ++_ticks;
+        ++count;
+    }
+
+    return count;
+}
+
+UnsignedInt FixedTimestep::update(const Timeline& timeline) {
+    return update(timeline.previousFrameDuration());
+}
+
+void FixedTimestep::reset() {
+    _accumulator = _time = 0.0;
+    _ticks = _droppedTicks = 0;
+}
+
+}
@@ -0,0 +1,184 @@
+#ifndef Magnum_FixedTimestep_h
+#define Magnum_FixedTimestep_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::FixedTimestep
+ */
+
+#include <functional>
+#include <vector>
+
+#include "Magnum.h"
+
+#include "magnumVisibility.h"
+
+namespace Magnum {
+
+/**
+@brief Fixed timestep scheduler
+
+Runs simulation callbacks at fixed tick rate independently of rendering frame
+rate. Frame duration passed to update() is accumulated and as many ticks as
+fit into the accumulated time are executed. The remaining fraction of tick is
+available through alpha() and can be used for interpolating between previous
+and current simulation state when rendering, so the motion is smooth even if
+the tick rate doesn't match the frame rate.
+
+If the frame takes too long (e.g. when debugging or loading resources), the
+simulation would need to execute more and more ticks to catch up, making the
+next frame even longer. To avoid this, at most maxTicksPerFrame() ticks are
+executed in one update() and the rest of the accumulated time is dropped.
+
+Example usage with @ref Timeline and @ref SceneGraph::AnimableGroup:
+@code
+MyApplication::MyApplication(const Parameters& parameters): Platform::Application(parameters) {
+    // Initialization ...
+
+    physics.setTickDuration(1/120.0f)
+        .addCallback([this](Float time, Float delta) { animables.step(time, delta); });
+
+    timeline.setMinimalFrameTime(1/60.0f)
+        .start();
+}
+
+void MyApplication::drawEvent() {
+    physics.update(timeline);
+
+    // Interpolate between previous and current physics state
+    Vector3 position = Math::lerp(previousPosition, currentPosition, physics.alpha());
+
+    // Draw ...
+
+    swapBuffers();
+    redraw();
+    timeline.nextFrame();
+}
+@endcode
+*/
+class MAGNUM_EXPORT FixedTimestep {
+    public:
+        /**
+         * @brief Tick callback
+         *
+         * The first parameter is simulation time at the beginning of the
+         * tick, the second is tick duration, both in seconds.
+         */
+        typedef std::function<void(Float, Float)> Callback;
+
+        /**
+         * @brief Constructor
+         * @param tickDuration  Tick duration in seconds
+         */
+        explicit FixedTimestep(Float tickDuration = 1/60.0f);
+
+        /** @brief Tick duration (in seconds) */
+        Float tickDuration() const { return _tickDuration; }
+
+        /**
+         * @brief Set tick duration
+         * @return Reference to self (for method chaining)
+         *
+         * Already accumulated time and simulation time are preserved.
+         */
+        FixedTimestep& setTickDuration(Float seconds);
+
+        /** @brief Max count of ticks executed in one update() */
+        UnsignedInt maxTicksPerFrame() const { return _maxTicksPerFrame; }
+
+        /**
+         * @brief Set max count of ticks executed in one update()
+         * @return Reference to self (for method chaining)
+         *
+         * Default value is `5`.
+         * @see droppedTickCount()
+         */
+        FixedTimestep& setMaxTicksPerFrame(UnsignedInt count);
+
+        /**
+         * @brief Add tick callback
+         * @return Reference to self (for method chaining)
+         *
+         * Callbacks are called in order in which they were added.
+         */
+        FixedTimestep& addCallback(Callback callback);
+
+        /**
+         * @brief Advance the simulation
+         * @param frameDuration     Duration of previous frame in seconds
+         * @return Count of executed ticks
+         *
+         * Adds @p frameDuration to accumulated time and executes all whole
+         * ticks in it, at most maxTicksPerFrame().
+         */
+        UnsignedInt update(Float frameDuration);
+
+        /**
+         * @brief Advance the simulation using timeline
+         *
+         * Same as calling `update(timeline.previousFrameDuration())`.
+         */
+        UnsignedInt update(const Timeline& timeline);
+
+        /**
+         * @brief Interpolation factor
+         *
+         * Fraction of tick remaining in accumulated time after last update(),
+         * in range @f$ [0, 1) @f$.
+         */
+        Float alpha() const { return Float(_accumulator/_tickDuration); }
+
+        /** @brief Simulation time (in seconds) */
+        Float time() const { return Float(_time); }
+
+        /** @brief Count of executed ticks */
+        UnsignedLong tickCount() const { return _ticks; }
+
+        /**
+         * @brief Count of dropped ticks
+         *
+         * Count of ticks which were dropped because of the limit set by
+         * setMaxTicksPerFrame().
+         */
+        UnsignedLong droppedTickCount() const { return _droppedTicks; }
+
+        /**
+         * @brief Reset the simulation
+         *
+         * Sets simulation time, accumulated time and tick counters to zero.
+         */
+        void reset();
+
+    private:
+        Float _tickDuration;
+        UnsignedInt _maxTicksPerFrame;
+        double _accumulator, _time;
+        UnsignedLong _ticks, _droppedTicks;
+        std::vector<Callback> _callbacks;
+};
+
+}
+
+#endif
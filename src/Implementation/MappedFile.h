@@ -0,0 +1,140 @@
+#ifndef Magnum_Implementation_MappedFile_h
+#define Magnum_Implementation_MappedFile_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <utility>
+#include <Containers/Array.h>
+#include <corradeConfigure.h>
+
+#if !defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_NACL) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#define MAGNUM_IMPLEMENTATION_MAPPEDFILE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <Utility/Directory.h>
+#endif
+
+namespace Magnum { namespace Implementation {
+
+/*
+Read-only view on file contents
+
+Used by importer plugins to parse files without copying them to memory first.
+On POSIX systems the file is memory-mapped, thus only pages which are actually
+accessed are read from the disk, elsewhere the whole file is read into an
+owned array. The data are valid until the instance is destroyed or moved from.
+*/
+class MappedFile {
+    public:
+        explicit MappedFile(): _opened(false) {}
+
+        explicit MappedFile(const std::string& filename);
+
+        MappedFile(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept: _opened(other._opened), _data(other._data)
+            #ifndef MAGNUM_IMPLEMENTATION_MAPPEDFILE_MMAP
+            , _storage(std::move(other._storage))
+            #endif
+        {
+            other._opened = false;
+            other._data = nullptr;
+        }
+
+        ~MappedFile();
+
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile& operator=(MappedFile&& other) noexcept {
+            std::swap(_opened, other._opened);
+            std::swap(_data, other._data);
+            #ifndef MAGNUM_IMPLEMENTATION_MAPPEDFILE_MMAP
+            std::swap(_storage, other._storage);
+            #endif
+            return *this;
+        }
+
+        /* Whether the file was successfully opened (it might be empty) */
+        explicit operator bool() const { return _opened; }
+
+        Containers::ArrayReference<const unsigned char> data() const { return _data; }
+
+    private:
+        bool _opened;
+        Containers::ArrayReference<const unsigned char> _data;
+        #ifndef MAGNUM_IMPLEMENTATION_MAPPEDFILE_MMAP
+        Containers::Array<unsigned char> _storage;
+        #endif
+};
+
+#ifdef MAGNUM_IMPLEMENTATION_MAPPEDFILE_MMAP
+inline MappedFile::MappedFile(const std::string& filename): _opened(false) {
+    const int fd = open(filename.data(), O_RDONLY);
+    if(fd == -1) return;
+
+    /* Directories can be opened too, but not mapped */
+    struct stat st;
+    if(fstat(fd, &st) == -1 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return;
+    }
+
+    /* Zero-length mapping is not allowed, empty file is still a valid file */
+    if(st.st_size != 0) {
+        void* const data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(data == MAP_FAILED) {
+            close(fd);
+            return;
+        }
+
+        _data = {static_cast<const unsigned char*>(data), std::size_t(st.st_size)};
+    }
+
+    /* The mapping stays valid after closing the descriptor */
+    close(fd);
+    _opened = true;
+}
+
+inline MappedFile::~MappedFile() {
+    if(_data) munmap(const_cast<unsigned char*>(_data.begin()), _data.size());
+}
+#else
+inline MappedFile::MappedFile(const std::string& filename): _opened(false) {
+    if(!Utility::Directory::fileExists(filename)) return;
+
+    _storage = Utility::Directory::read(filename);
+    _data = _storage;
+    _opened = true;
+}
+
+inline MappedFile::~MappedFile() = default;
+#endif
+
+}}
+
+#endif
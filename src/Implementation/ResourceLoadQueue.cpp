@@ -0,0 +1,141 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/* Resource.h includes the rest of the resource management headers, which need
+   ResourceLoadQueue complete, so it can't be included first */
+#include "AbstractResourceLoader.h"
+
+namespace Magnum { namespace Implementation {
+
+ResourceLoadQueue::ResourceLoadQueue(): _runningCount(0), _workerCount(1), _stopping(false) {}
+
+ResourceLoadQueue::~ResourceLoadQueue() { stopWorkers(); }
+
+void ResourceLoadQueue::setWorkerCount(const UnsignedInt count) {
+    stopWorkers();
+    _workerCount = count;
+    if(_queued.empty()) return;
+
+    if(_workerCount) {
+        startWorkers();
+        return;
+    }
+
+    /* No workers anymore, execute everything directly */
+    for(Entry& entry: _queued)
+        _finished.emplace_back(entry.key, entry.job());
+    _queued.clear();
+}
+
+std::size_t ResourceLoadQueue::pendingCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _queued.size() + _runningCount + _finished.size();
+}
+
+void ResourceLoadQueue::push(const ResourceKey key, const std::size_t priority, Job job) {
+    /* No workers, execute directly */
+    if(!_workerCount) {
+        std::function<void()> completion = job();
+        std::lock_guard<std::mutex> lock(_mutex);
+        _finished.emplace_back(key, std::move(completion));
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queued.push_back({key, priority, std::move(job)});
+    }
+
+    if(_workers.empty()) startWorkers();
+    else _condition.notify_one();
+}
+
+std::vector<ResourceKey> ResourceLoadQueue::reprioritize(const std::function<std::size_t(ResourceKey)>& priority) {
+    std::vector<ResourceKey> removed;
+    std::lock_guard<std::mutex> lock(_mutex);
+    for(auto it = _queued.begin(); it != _queued.end(); ) {
+        if(!(it->priority = priority(it->key))) {
+            removed.push_back(it->key);
+            it = _queued.erase(it);
+        } else ++it;
+    }
+
+    return removed;
+}
+
+bool ResourceLoadQueue::pop(ResourceKey& key, std::function<void()>& completion) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if(_finished.empty()) return false;
+
+    key = _finished.front().first;
+    completion = std::move(_finished.front().second);
+    _finished.pop_front();
+    return true;
+}
+
+void ResourceLoadQueue::startWorkers() {
+    _stopping = false;
+    for(UnsignedInt i = 0; i != _workerCount; ++i)
+        _workers.emplace_back(&ResourceLoadQueue::work, this);
+}
+
+void ResourceLoadQueue::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _condition.notify_all();
+
+    for(std::thread& worker: _workers) worker.join();
+    _workers.clear();
+}
+
+void ResourceLoadQueue::work() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    for(;;) {
+        _condition.wait(lock, [this]() { return _stopping || !_queued.empty(); });
+        if(_stopping) return;
+
+        /* Take the job with highest priority, the first one of equal ones to
+           preserve the request order */
+        auto job = _queued.begin();
+        for(auto it = _queued.begin(); it != _queued.end(); ++it)
+            if(it->priority > job->priority) job = it;
+
+        const ResourceKey key = job->key;
+        Job function = std::move(job->job);
+        _queued.erase(job);
+        ++_runningCount;
+
+        lock.unlock();
+        std::function<void()> completion = function();
+        lock.lock();
+
+        _finished.emplace_back(key, std::move(completion));
+        --_runningCount;
+    }
+}
+
+}}
@@ -0,0 +1,98 @@
+#ifndef Magnum_Implementation_ResourceLoadQueue_h
+#define Magnum_Implementation_ResourceLoadQueue_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Resource.h"
+
+namespace Magnum { namespace Implementation {
+
+/* Job queue for asynchronous resource loading, shared by all
+   AbstractResourceLoader instantiations. Jobs are executed by worker threads
+   in order of their priority, results are collected on the owning thread.
+   With zero workers the jobs are executed directly in push(). */
+class MAGNUM_EXPORT ResourceLoadQueue {
+    public:
+        /* Job executed on a worker thread, returns completion executed on the
+           owning thread (or empty function if the resource wasn't found) */
+        typedef std::function<std::function<void()>()> Job;
+
+        explicit ResourceLoadQueue();
+
+        ResourceLoadQueue(const ResourceLoadQueue&) = delete;
+        ResourceLoadQueue(ResourceLoadQueue&&) = delete;
+        ResourceLoadQueue& operator=(const ResourceLoadQueue&) = delete;
+        ResourceLoadQueue& operator=(ResourceLoadQueue&&) = delete;
+
+        /* Waits for running jobs, discards the queued ones */
+        ~ResourceLoadQueue();
+
+        UnsignedInt workerCount() const { return _workerCount; }
+
+        /* Waits for running jobs and restarts the workers */
+        void setWorkerCount(UnsignedInt count);
+
+        /* Queued, running and not yet collected jobs */
+        std::size_t pendingCount() const;
+
+        void push(ResourceKey key, std::size_t priority, Job job);
+
+        /* Updates priority of all queued jobs, removes the ones with zero
+           priority and returns their keys */
+        std::vector<ResourceKey> reprioritize(const std::function<std::size_t(ResourceKey)>& priority);
+
+        /* Takes one finished job, returns false if there is none */
+        bool pop(ResourceKey& key, std::function<void()>& completion);
+
+    private:
+        struct Entry {
+            ResourceKey key;
+            std::size_t priority;
+            Job job;
+        };
+
+        void startWorkers();
+        void stopWorkers();
+        void work();
+
+        mutable std::mutex _mutex;
+        std::condition_variable _condition;
+        std::vector<Entry> _queued;
+        std::deque<std::pair<ResourceKey, std::function<void()>>> _finished;
+        std::vector<std::thread> _workers;
+        std::size_t _runningCount;
+        UnsignedInt _workerCount;
+        bool _stopping;
+};
+
+}}
+
+#endif
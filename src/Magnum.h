@@ -570,6 +570,7 @@ class CubeMapTextureArray;
 /* DimensionTraits forward declaration is not needed */
 
 class Extension;
+class FixedTimestep;
 class Framebuffer;
 
 template<UnsignedInt> class Image;
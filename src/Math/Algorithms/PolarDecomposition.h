@@ -0,0 +1,83 @@
+#ifndef Magnum_Math_Algorithms_PolarDecomposition_h
+#define Magnum_Math_Algorithms_PolarDecomposition_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function Magnum::Math::Algorithms::polarDecomposition()
+ */
+
+#include "Math/Quaternion.h"
+#include "Math/Algorithms/Svd.h"
+
+namespace Magnum { namespace Math { namespace Algorithms {
+
+/**
+@brief Polar decomposition of 3x3 matrix
+
+Decomposes the matrix into rotation @f$ R @f$ and symmetric stretch matrix
+@f$ S @f$ so that @f[
+    M = R S
+@f]
+The rotation is computed from svd3() as @f$ R = U V^T @f$ and it is the
+nearest rotation to @p m. If @p m contains reflection (i.e. has negative
+determinant), the reflection is put into @f$ S @f$ along the axis of the
+smallest singular value, so @f$ R @f$ is always a proper rotation. Returned
+quaternion is normalized.
+@see Quaternion::fromMatrix()
+*/
+template<class T> std::tuple<Quaternion<T>, Matrix<3, T>> polarDecomposition(const Matrix<3, T>& m) {
+    Matrix<3, T> u{Matrix<3, T>::Zero};
+    Vector<3, T> w;
+    Matrix<3, T> v{Matrix<3, T>::Zero};
+    Implementation::svd3Signed(m, u, w, v);
+
+    const Matrix<3, T> vt = v.transposed();
+    return std::make_tuple(Math::Implementation::quaternionFromMatrix(Matrix<3, T>(u*vt)).normalized(),
+        Matrix<3, T>(v*Matrix<3, T>::fromDiagonal(w)*vt));
+}
+
+/**
+@brief Rotation part of polar decomposition of array of 3x3 matrices
+
+Computes only the rotation part of polarDecomposition(const Matrix<3, T>&)
+for each matrix in @p matrices and puts it into @p rotations. Expects that
+both arrays have the same size.
+*/
+template<class T> void polarDecomposition(Corrade::Containers::ArrayReference<const Matrix<3, T>> matrices, Corrade::Containers::ArrayReference<Quaternion<T>> rotations) {
+    CORRADE_ASSERT(rotations.size() == matrices.size(),
+        "Math::Algorithms::polarDecomposition(): expected output array of size" << matrices.size() << "but got" << rotations.size(), );
+
+    Matrix<3, T> u{Matrix<3, T>::Zero};
+    Vector<3, T> w;
+    Matrix<3, T> v{Matrix<3, T>::Zero};
+    for(std::size_t i = 0; i != matrices.size(); ++i) {
+        Implementation::svd3Signed(matrices[i], u, w, v);
+        rotations[i] = Math::Implementation::quaternionFromMatrix(Matrix<3, T>(u*v.transposed())).normalized();
+    }
+}
+
+}}}
+
+#endif
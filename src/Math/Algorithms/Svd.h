@@ -25,13 +25,16 @@
 */
 
 /** @file
- * @brief Function Magnum::Math::Algorithms::svd()
+ * @brief Function Magnum::Math::Algorithms::svd(), Magnum::Math::Algorithms::svd3()
  */
 
+#include <limits>
 #include <tuple>
+#include <Containers/Array.h>
 
 #include "Math/Functions.h"
 #include "Math/Matrix.h"
+#include "Math/Vector3.h"
 
 namespace Magnum { namespace Math { namespace Algorithms {
 
@@ -54,6 +57,117 @@ template<> constexpr Float smallestDelta<Float>() { return 1.0e-32f; }
 template<> constexpr Double smallestDelta<Double>() { return 1.0e-64; }
 #endif
 
+/* Max count of Jacobi sweeps done in svd3(). The convergence is quadratic, so
+   usually three sweeps are enough for Float and four for Double, the limit
+   is there only to have bounded execution time. */
+template<class T> constexpr std::size_t jacobiSweeps();
+template<> constexpr std::size_t jacobiSweeps<Float>() { return 6; }
+#ifndef MAGNUM_TARGET_GLES
+template<> constexpr std::size_t jacobiSweeps<Double>() { return 8; }
+#endif
+
+/* Jacobi rotation annihilating element `pq` of symmetric matrix, `rp` and
+   `rq` are the remaining off-diagonal elements in the affected rows, the
+   rotation is accumulated into columns `vp` and `vq`. Returns `false` if the
+   element is already negligible and thus nothing was done -- rotating
+   further would only make the off-diagonal elements slowly decay into
+   denormals, which are extremely slow to operate on. */
+template<class T> inline bool jacobiRotation(T& pp, T& qq, T& pq, T& rp, T& rq, T(&vp)[3], T(&vq)[3]) {
+    if(std::abs(pq) <= std::numeric_limits<T>::epsilon()*(std::abs(pp) + std::abs(qq)))
+        return false;
+
+    /* The tan of the rotation angle is the smaller root of t^2 + 2θt - 1,
+       where θ = (qq - pp)/(2pq). Expressed as a fraction with positive
+       denominator, which is then normalized to get cos and sin without
+       needing to divide twice in a row. */
+    const T d = qq - pp;
+    const T e = d < T(0) ? T(-2)*pq : T(2)*pq;
+    const T cn = std::abs(d) + std::sqrt(d*d + e*e);
+    const T length = std::sqrt(cn*cn + e*e);
+    const T c = cn/length;
+    const T s = e/length;
+    const T t = e/cn;
+
+    pp -= t*pq;
+    qq += t*pq;
+    pq = T(0);
+    const T rp0 = rp;
+    rp = c*rp0 - s*rq;
+    rq = s*rp0 + c*rq;
+
+    for(std::size_t i = 0; i != 3; ++i) {
+        const T vpi = vp[i];
+        vp[i] = c*vpi - s*vq[i];
+        vq[i] = s*vpi + c*vq[i];
+    }
+
+    return true;
+}
+
+/* Swaps columns `i` and `j` if column `j` is longer, negating one of them to
+   preserve the determinant */
+template<class T> inline void sortColumns(Matrix<3, T>& b, Matrix<3, T>& v, Vector<3, T>& lengths, const std::size_t i, const std::size_t j) {
+    if(lengths[i] >= lengths[j]) return;
+
+    std::swap(lengths[i], lengths[j]);
+    const Vector<3, T> bi = b[i];
+    b[i] = b[j];
+    b[j] = -bi;
+    const Vector<3, T> vi = v[i];
+    v[i] = v[j];
+    v[j] = -vi;
+}
+
+/* SVD of 3x3 matrix with U and V being rotations, the last singular value has
+   the sign of the determinant */
+template<class T> void svd3Signed(const Matrix<3, T>& m, Matrix<3, T>& u, Vector<3, T>& w, Matrix<3, T>& v) {
+    /* Eigenvectors of symmetric MᵀM using cyclic Jacobi sweeps until all
+       off-diagonal elements are negligible. Operating on plain scalars, as
+       only the upper triangle is needed. */
+    T s00 = m[0].dot(), s11 = m[1].dot(), s22 = m[2].dot();
+    T s01 = Vector<3, T>::dot(m[0], m[1]);
+    T s02 = Vector<3, T>::dot(m[0], m[2]);
+    T s12 = Vector<3, T>::dot(m[1], m[2]);
+    T v0[3]{T(1), T(0), T(0)}, v1[3]{T(0), T(1), T(0)}, v2[3]{T(0), T(0), T(1)};
+    for(std::size_t i = 0; i != jacobiSweeps<T>(); ++i) {
+        const bool rotated01 = jacobiRotation(s00, s11, s01, s02, s12, v0, v1);
+        const bool rotated02 = jacobiRotation(s00, s22, s02, s01, s12, v0, v2);
+        const bool rotated12 = jacobiRotation(s11, s22, s12, s01, s02, v1, v2);
+        if(!rotated01 && !rotated02 && !rotated12) break;
+    }
+    v = Matrix<3, T>(Vector<3, T>(v0[0], v0[1], v0[2]),
+                     Vector<3, T>(v1[0], v1[1], v1[2]),
+                     Vector<3, T>(v2[0], v2[1], v2[2]));
+
+    /* Columns of B = MV are orthogonal with lengths equal to the singular
+       values, sort them in descending order */
+    Matrix<3, T> b = m*v;
+    Vector<3, T> lengths(b[0].dot(), b[1].dot(), b[2].dot());
+    sortColumns(b, v, lengths, 0, 1);
+    sortColumns(b, v, lengths, 0, 2);
+    sortColumns(b, v, lengths, 1, 2);
+
+    /* QR decomposition of B by Gram-Schmidt, the last column is computed as
+       cross product so U is always a rotation. Degenerate columns are
+       replaced with arbitrary perpendicular vectors. */
+    const T epsilon = TypeTraits<T>::epsilon();
+    w[0] = std::sqrt(lengths[0]);
+    const Vector3<T> u0 = w[0] > epsilon*epsilon ? Vector3<T>(b[0]/w[0]) : Vector3<T>::xAxis();
+    const Vector3<T> b1 = Vector3<T>(b[1]) - Vector3<T>::dot(u0, b[1])*u0;
+    w[1] = b1.length();
+    Vector3<T> u1;
+    if(w[1] > epsilon*w[0] && w[1] > epsilon*epsilon) u1 = b1/w[1];
+    else {
+        w[1] = T(0);
+        u1 = Vector3<T>::cross(u0, std::abs(u0.x()) < std::abs(u0.y()) ?
+            Vector3<T>::xAxis() : Vector3<T>::yAxis()).normalized();
+    }
+    const Vector3<T> u2 = Vector3<T>::cross(u0, u1);
+    w[2] = Vector3<T>::dot(u2, b[2]);
+
+    u = Matrix<3, T>(u0, u1, u2);
+}
+
 }
 
 /**
@@ -332,6 +446,52 @@ template<std::size_t cols, std::size_t rows, class T> std::tuple<RectangularMatr
     return std::make_tuple(m, q, v);
 }
 
+/**
+@brief Singular Value Decomposition of 3x3 matrix
+
+Specialized version of svd() for 3x3 matrices using eigenvalue decomposition
+of @f$ M^T M @f$ with bounded count of cyclic Jacobi sweeps followed by QR
+decomposition. It has only a few data-dependent branches and is considerably
+faster than the generic implementation. Returns @f$ U @f$,
+diagonal of @f$ \Sigma @f$ and non-transposed @f$ V @f$ such that
+@f[
+    M = U \Sigma V^*
+@f]
+Unlike with svd(), the singular values are sorted in descending order, all
+are non-negative and @f$ V @f$ is always a rotation (i.e. its determinant is
+@f$ 1 @f$). If @p m has negative determinant, @f$ U @f$ contains reflection.
+@see polarDecomposition()
+*/
+template<class T> std::tuple<Matrix<3, T>, Vector<3, T>, Matrix<3, T>> svd3(const Matrix<3, T>& m) {
+    Matrix<3, T> u{Matrix<3, T>::Zero};
+    Vector<3, T> w;
+    Matrix<3, T> v{Matrix<3, T>::Zero};
+    Implementation::svd3Signed(m, u, w, v);
+
+    /* Invert to non-negative */
+    if(w[2] < T(0)) {
+        w[2] = -w[2];
+        u[2] = -u[2];
+    }
+
+    return std::make_tuple(u, w, v);
+}
+
+/**
+@brief Singular Value Decomposition of array of 3x3 matrices
+
+Same as calling svd3(const Matrix<3, T>&) on each matrix in @p matrices, the
+results are put into @p u, @p w and @p v. Expects that all arrays have the
+same size.
+*/
+template<class T> void svd3(Corrade::Containers::ArrayReference<const Matrix<3, T>> matrices, Corrade::Containers::ArrayReference<Matrix<3, T>> u, Corrade::Containers::ArrayReference<Vector<3, T>> w, Corrade::Containers::ArrayReference<Matrix<3, T>> v) {
+    CORRADE_ASSERT(u.size() == matrices.size() && w.size() == matrices.size() && v.size() == matrices.size(),
+        "Math::Algorithms::svd3(): expected output arrays of the same size as input", );
+
+    for(std::size_t i = 0; i != matrices.size(); ++i)
+        std::tie(u[i], w[i], v[i]) = svd3(matrices[i]);
+}
+
 }}}
 
 #endif
@@ -0,0 +1,140 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <TestSuite/Tester.h>
+
+#include "Math/Algorithms/PolarDecomposition.h"
+
+namespace Magnum { namespace Math { namespace Algorithms { namespace Test {
+
+class PolarDecompositionTest: public Corrade::TestSuite::Tester {
+    public:
+        explicit PolarDecompositionTest();
+
+        void rotationScaling();
+        void generic();
+        void reflection();
+        void batch();
+};
+
+typedef Math::Matrix<3, Float> Matrix3x3;
+typedef Math::Vector<3, Float> Vector3;
+typedef Math::Quaternion<Float> Quaternion;
+typedef Math::Deg<Float> Deg;
+
+PolarDecompositionTest::PolarDecompositionTest() {
+    addTests({&PolarDecompositionTest::rotationScaling,
+              &PolarDecompositionTest::generic,
+              &PolarDecompositionTest::reflection,
+              &PolarDecompositionTest::batch});
+}
+
+namespace {
+
+/* Single precision is not enough for exact comparison of matrix products,
+   test for similarity */
+bool similar(const Matrix3x3& a, const Matrix3x3& b) {
+    return Math::abs((a - b).toVector()).max() < 1.0e-5f;
+}
+
+}
+
+void PolarDecompositionTest::rotationScaling() {
+    const Quaternion rotation = Quaternion::rotation(Deg(35.0f), Math::Vector3<Float>(1.0f, 2.0f, 3.0f).normalized());
+
+    /* Non-uniform scaling along rotated axes */
+    const Matrix3x3 axes = Quaternion::rotation(Deg(-70.0f), Math::Vector3<Float>::zAxis()).toMatrix();
+    const Matrix3x3 stretch = axes*Matrix3x3::fromDiagonal({2.0f, 1.5f, 0.5f})*axes.transposed();
+
+    Quaternion q;
+    Matrix3x3 s;
+    std::tie(q, s) = Algorithms::polarDecomposition(Matrix3x3(rotation.toMatrix()*stretch));
+
+    /* The quaternion is normalized and may have opposite sign */
+    CORRADE_VERIFY(q.isNormalized());
+    CORRADE_VERIFY(similar(q.toMatrix(), rotation.toMatrix()));
+    CORRADE_VERIFY(similar(s, stretch));
+}
+
+void PolarDecompositionTest::generic() {
+    const Matrix3x3 m(Vector3(3.0f,  5.0f,  8.0f),
+                      Vector3(4.0f, -4.0f,  7.0f),
+                      Vector3(7.0f, -1.0f,  8.0f));
+    CORRADE_VERIFY(m.determinant() > 0.0f);
+
+    Quaternion q;
+    Matrix3x3 s;
+    std::tie(q, s) = Algorithms::polarDecomposition(m);
+
+    /* The rotation is UVᵀ from the generic SVD */
+    RectangularMatrix<3, 3, Float> u;
+    Vector3 w;
+    Matrix3x3 v;
+    std::tie(u, w, v) = Algorithms::svd(RectangularMatrix<3, 3, Float>(m));
+    CORRADE_VERIFY(similar(q.toMatrix(), Matrix3x3(u*v.transposed())));
+
+    /* The stretch is symmetric */
+    CORRADE_VERIFY(similar(s, s.transposed()));
+    CORRADE_VERIFY(similar(q.toMatrix()*s, m));
+}
+
+void PolarDecompositionTest::reflection() {
+    const Matrix3x3 m(Vector3(0.0f, 2.0f, 0.0f),
+                      Vector3(3.0f, 0.0f, 0.0f),
+                      Vector3(0.0f, 0.0f, 1.0f));
+    CORRADE_VERIFY(m.determinant() < 0.0f);
+
+    Quaternion q;
+    Matrix3x3 s;
+    std::tie(q, s) = Algorithms::polarDecomposition(m);
+
+    /* The rotation is proper, reflection is moved to the stretch along the
+       axis with smallest scale */
+    CORRADE_VERIFY(q.isNormalized());
+    CORRADE_COMPARE(q.toMatrix().determinant(), 1.0f);
+    CORRADE_VERIFY(similar(s, Matrix3x3::fromDiagonal({2.0f, 3.0f, -1.0f})));
+    CORRADE_VERIFY(similar(q.toMatrix()*s, m));
+}
+
+void PolarDecompositionTest::batch() {
+    const Matrix3x3 matrices[] = {
+        Matrix3x3(Matrix3x3::Identity),
+        Matrix3x3(Vector3(3.0f,  5.0f,  8.0f),
+                  Vector3(4.0f, -4.0f,  7.0f),
+                  Vector3(7.0f, -1.0f, -8.0f)),
+        Matrix3x3(Quaternion::rotation(Deg(120.0f), Math::Vector3<Float>::yAxis()).toMatrix()*2.0f)
+    };
+    Quaternion rotations[3];
+    Algorithms::polarDecomposition<Float>(matrices, rotations);
+
+    for(std::size_t i = 0; i != 3; ++i)
+        CORRADE_COMPARE(rotations[i], std::get<0>(Algorithms::polarDecomposition(matrices[i])));
+
+    CORRADE_COMPARE(rotations[0], Quaternion());
+    CORRADE_VERIFY(similar(rotations[2].toMatrix(), Quaternion::rotation(Deg(120.0f), Math::Vector3<Float>::yAxis()).toMatrix()));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::PolarDecompositionTest)
@@ -22,6 +22,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <chrono>
 #include <TestSuite/Tester.h>
 
 #include "Math/Algorithms/Svd.h"
@@ -34,6 +35,12 @@ class SvdTest: public Corrade::TestSuite::Tester {
 
         void testDouble();
         void testFloat();
+
+        void svd3();
+        void svd3Reflection();
+        void svd3Degenerate();
+        void svd3Batch();
+        void svd3Benchmark();
 };
 
 #ifndef MAGNUM_TARGET_GLES
@@ -50,6 +57,13 @@ typedef Matrix<5, Float> Matrix5f;
 typedef Vector<8, Float> Vector8f;
 typedef Vector<5, Float> Vector5f;
 
+typedef Matrix<3, Float> Matrix3f;
+typedef Vector<3, Float> Vector3f;
+#ifndef MAGNUM_TARGET_GLES
+typedef Matrix<3, Double> Matrix3d;
+typedef Vector<3, Double> Vector3d;
+#endif
+
 #ifndef MAGNUM_TARGET_GLES
 constexpr static Matrix5x8d ad(
     Vector8d(22.0, 14.0,  -1.0, -3.0,  9.0,  9.0,  2.0,  4.0),
@@ -72,7 +86,13 @@ static const Vector5f expectedf(std::sqrt(1248.0f), 0.0f, 20.0f, std::sqrt(384.0
 
 SvdTest::SvdTest() {
     addTests({&SvdTest::testDouble,
-              &SvdTest::testFloat});
+              &SvdTest::testFloat,
+
+              &SvdTest::svd3,
+              &SvdTest::svd3Reflection,
+              &SvdTest::svd3Degenerate,
+              &SvdTest::svd3Batch,
+              &SvdTest::svd3Benchmark});
 }
 
 void SvdTest::testDouble() {
@@ -117,6 +137,167 @@ void SvdTest::testFloat() {
     CORRADE_VERIFY(Math::abs(w-expectedf).max() < 1.0e-5f);
 }
 
+namespace {
+
+constexpr static Matrix3f a3f(Vector3f(3.0f,  5.0f,  8.0f),
+                              Vector3f(4.0f, -4.0f,  7.0f),
+                              Vector3f(7.0f, -1.0f, -8.0f));
+
+template<class T> bool isRotation(const Matrix<3, T>& m) {
+    return m.isOrthogonal() && TypeTraits<T>::equals(m.determinant(), T(1));
+}
+
+/* Sorted singular values from the generic implementation */
+template<class T> Vector<3, T> genericSingularValues(const Matrix<3, T>& m) {
+    RectangularMatrix<3, 3, T> u;
+    Vector<3, T> w;
+    Matrix<3, T> v;
+    std::tie(u, w, v) = Algorithms::svd(RectangularMatrix<3, 3, T>(m));
+
+    if(w[0] < w[1]) std::swap(w[0], w[1]);
+    if(w[0] < w[2]) std::swap(w[0], w[2]);
+    if(w[1] < w[2]) std::swap(w[1], w[2]);
+    return w;
+}
+
+}
+
+void SvdTest::svd3() {
+    Matrix3f u;
+    Vector3f w;
+    Matrix3f v;
+    std::tie(u, w, v) = Algorithms::svd3(a3f);
+
+    /* Test composition (single precision is not enough, test for similarity) */
+    CORRADE_VERIFY(Math::abs((u*Matrix3f::fromDiagonal(w)*v.transposed() - a3f).toVector()).max() < 1.0e-5f);
+
+    /* U is orthogonal, V is rotation */
+    CORRADE_VERIFY(u.isOrthogonal());
+    CORRADE_VERIFY(isRotation(v));
+
+    /* Same singular values as the generic implementation, sorted (again
+       testing only for similarity) */
+    CORRADE_VERIFY(Math::abs(w - genericSingularValues(a3f)).max() < 1.0e-5f);
+    CORRADE_VERIFY(w[0] >= w[1] && w[1] >= w[2]);
+
+    #ifndef MAGNUM_TARGET_GLES
+    const Matrix3d a3d(Vector3d(3.0, 5.0,  8.0),
+                       Vector3d(4.0, 4.0,  7.0),
+                       Vector3d(7.0, 0.5, -8.0));
+    Matrix3d ud;
+    Vector3d wd;
+    Matrix3d vd;
+    std::tie(ud, wd, vd) = Algorithms::svd3(a3d);
+    CORRADE_COMPARE(ud*Matrix3d::fromDiagonal(wd)*vd.transposed(), a3d);
+    CORRADE_VERIFY(ud.isOrthogonal());
+    CORRADE_VERIFY(isRotation(vd));
+    CORRADE_COMPARE(wd, genericSingularValues(a3d));
+    #endif
+}
+
+void SvdTest::svd3Reflection() {
+    const Matrix3f a(Vector3f(0.0f, 2.0f, 0.0f),
+                     Vector3f(3.0f, 0.0f, 0.0f),
+                     Vector3f(0.0f, 0.0f, 1.0f));
+    CORRADE_VERIFY(a.determinant() < 0.0f);
+
+    Matrix3f u;
+    Vector3f w;
+    Matrix3f v;
+    std::tie(u, w, v) = Algorithms::svd3(a);
+
+    /* Singular values are positive, reflection is in U */
+    CORRADE_COMPARE(w, Vector3f(3.0f, 2.0f, 1.0f));
+    CORRADE_VERIFY(isRotation(v));
+    CORRADE_COMPARE(u.determinant(), -1.0f);
+    CORRADE_COMPARE(u*Matrix3f::fromDiagonal(w)*v.transposed(), a);
+}
+
+void SvdTest::svd3Degenerate() {
+    Matrix3f u;
+    Vector3f w;
+    Matrix3f v;
+
+    /* Rank 1 */
+    const Matrix3f a(Vector3f(1.0f, 2.0f, 3.0f),
+                     Vector3f(2.0f, 4.0f, 6.0f),
+                     Vector3f(-1.0f, -2.0f, -3.0f));
+    std::tie(u, w, v) = Algorithms::svd3(a);
+    CORRADE_COMPARE(w, Vector3f(std::sqrt(84.0f), 0.0f, 0.0f));
+    CORRADE_VERIFY(u.isOrthogonal());
+    CORRADE_VERIFY(isRotation(v));
+    CORRADE_COMPARE(u*Matrix3f::fromDiagonal(w)*v.transposed(), a);
+
+    /* Zero */
+    std::tie(u, w, v) = Algorithms::svd3(Matrix3f(Matrix3f::Zero));
+    CORRADE_COMPARE(w, Vector3f());
+    CORRADE_VERIFY(u.isOrthogonal());
+    CORRADE_VERIFY(isRotation(v));
+
+    /* Already diagonal with repeated values */
+    std::tie(u, w, v) = Algorithms::svd3(Matrix3f(Matrix3f::Identity)*2.0f);
+    CORRADE_COMPARE(w, Vector3f(2.0f, 2.0f, 2.0f));
+    CORRADE_COMPARE(u*v.transposed(), Matrix3f(Matrix3f::Identity));
+}
+
+void SvdTest::svd3Batch() {
+    const Matrix3f matrices[] = {
+        a3f,
+        Matrix3f(Matrix3f::Identity),
+        Matrix3f::fromDiagonal({1.0f, -3.0f, 2.0f}),
+        Matrix3f(a3f*a3f.transposed())
+    };
+    Matrix3f u[4];
+    Vector3f w[4];
+    Matrix3f v[4];
+    Algorithms::svd3<Float>(matrices, u, w, v);
+
+    for(std::size_t i = 0; i != 4; ++i) {
+        Matrix3f u1;
+        Vector3f w1;
+        Matrix3f v1;
+        std::tie(u1, w1, v1) = Algorithms::svd3(matrices[i]);
+        CORRADE_COMPARE(u[i], u1);
+        CORRADE_COMPARE(w[i], w1);
+        CORRADE_COMPARE(v[i], v1);
+    }
+}
+
+void SvdTest::svd3Benchmark() {
+    /* Set of varying matrices */
+    Matrix3f matrices[64];
+    for(std::size_t i = 0; i != 64; ++i)
+        matrices[i] = a3f + Matrix3f::fromDiagonal(Vector3f(Float(i%7), Float(i%5), -Float(i%3)));
+
+    constexpr std::size_t iterations = 2000;
+    Float sum1 = 0.0f, sum2 = 0.0f;
+
+    const auto begin = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i != iterations; ++i) for(const Matrix3f& m: matrices) {
+        RectangularMatrix<3, 3, Float> u;
+        Vector3f w;
+        Matrix3f v;
+        std::tie(u, w, v) = Algorithms::svd(RectangularMatrix<3, 3, Float>(m));
+        sum1 += w.sum();
+    }
+    const auto middle = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i != iterations; ++i) for(const Matrix3f& m: matrices) {
+        Matrix3f u;
+        Vector3f w;
+        Matrix3f v;
+        std::tie(u, w, v) = Algorithms::svd3(m);
+        sum2 += w.sum();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    /* Sum of all singular values should be the same */
+    CORRADE_VERIFY(std::abs(sum1 - sum2) < 1.0e-5f*sum1);
+
+    typedef std::chrono::duration<double, std::nano> Nanoseconds;
+    Debug() << "3x3 SVD, generic:" << std::chrono::duration_cast<Nanoseconds>(middle - begin).count()/(iterations*64)
+            << "ns, Jacobi:" << std::chrono::duration_cast<Nanoseconds>(end - middle).count()/(iterations*64) << "ns";
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::SvdTest)
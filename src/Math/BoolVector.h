@@ -28,6 +28,9 @@
  * @brief Class Magnum::Math::BoolVector
  */
 
+#include <cstring>
+#include <Containers/Array.h>
+#include <Utility/Assert.h>
 #include <Utility/Debug.h>
 #include <corradeCompatibility.h>
 
@@ -50,6 +53,50 @@ namespace Implementation {
     #endif
 
     template<class T> constexpr T repeat(T value, std::size_t) { return value; }
+
+    /* Count of set bits */
+    inline std::size_t popcount(UnsignedLong value) {
+        #ifdef __GNUC__
+        return __builtin_popcountll(value);
+        #else
+        value = value - ((value >> 1) & 0x5555555555555555ull);
+        value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+        value = (value + (value >> 4)) & 0x0f0f0f0f0f0f0f0full;
+        return (value*0x0101010101010101ull) >> 56;
+        #endif
+    }
+
+    /* Position of lowest set bit, the value must be nonzero */
+    inline std::size_t trailingZeros(UnsignedInt value) {
+        #ifdef __GNUC__
+        return __builtin_ctz(value);
+        #else
+        std::size_t out = 0;
+        while(!(value & 1)) {
+            value >>= 1;
+            ++out;
+        }
+        return out;
+        #endif
+    }
+
+    /* Eight segments at once, the byte order doesn't matter for the
+       operations they are used for */
+    inline UnsignedLong loadSegments(const UnsignedByte* data) {
+        UnsignedLong out;
+        std::memcpy(&out, data, 8);
+        return out;
+    }
+
+    inline void storeSegments(UnsignedByte* data, UnsignedLong value) {
+        std::memcpy(data, &value, 8);
+    }
+
+    /* Calls given function for each set bit in given segment */
+    template<class F> inline void forEachSetInSegment(UnsignedInt segment, std::size_t offset, F& f) {
+        for(; segment; segment &= segment - 1)
+            f(offset + trailingZeros(segment));
+    }
 }
 
 /**
@@ -138,6 +185,51 @@ template<std::size_t size> class BoolVector {
         /** @brief Whether any bit is set */
         bool any() const { return !none(); }
 
+        /**
+         * @brief Count of set bits
+         *
+         * Counts eight segments at once using population count builtin, if
+         * the compiler has it.
+         * @see @ref count(Corrade::Containers::ArrayReference<const BoolVector<size>>)
+         */
+        std::size_t count() const;
+
+        /**
+         * @brief Position of first set bit
+         *
+         * Returns @ref Size if no bit is set.
+         * @see @ref nextSet(), @ref forEachSet()
+         */
+        std::size_t firstSet() const { return findSet(0); }
+
+        /**
+         * @brief Position of next set bit
+         *
+         * Returns position of first set bit after @p i or @ref Size if there
+         * is no such bit. Together with @ref firstSet() can be used for
+         * iterating over set bits:
+         * @code
+         * for(std::size_t i = a.firstSet(); i != a.Size; i = a.nextSet(i)) {
+         *     // ...
+         * }
+         * @endcode
+         * @see @ref forEachSet()
+         */
+        std::size_t nextSet(std::size_t i) const { return findSet(i + 1); }
+
+        /**
+         * @brief Call function for each set bit
+         *
+         * Calls @p f with position of each set bit, in ascending order. Eight
+         * empty segments are skipped at once, which makes this faster than
+         * @ref firstSet() / @ref nextSet() for sparse vectors.
+         * @code
+         * Math::BoolVector<256> visible = ...;
+         * visible.forEachSet([&](std::size_t i) { draw(objects[i]); });
+         * @endcode
+         */
+        template<class F> void forEachSet(F f) const;
+
         /** @brief Bitwise inversion */
         BoolVector<size> operator~() const;
 
@@ -210,6 +302,8 @@ template<std::size_t size> class BoolVector {
             LastSegmentMask = (1 << size%8) - 1
         };
 
+        std::size_t findSet(std::size_t from) const;
+
         /* Implementation for Vector<size, T>::Vector(U) */
         template<std::size_t ...sequence> constexpr explicit BoolVector(Implementation::Sequence<sequence...>, UnsignedByte value): _data{Implementation::repeat(value, sequence)...} {}
 
@@ -264,6 +358,57 @@ template<std::size_t size> inline bool BoolVector<size>::none() const {
     return true;
 }
 
+template<std::size_t size> inline std::size_t BoolVector<size>::count() const {
+    std::size_t out = 0;
+
+    /* Eight full segments at once, then the rest */
+    std::size_t i = 0;
+    for(; i + 8 <= size/8; i += 8)
+        out += Implementation::popcount(Implementation::loadSegments(_data + i));
+    for(; i != size/8; ++i)
+        out += Implementation::popcount(_data[i]);
+
+    /* Last segment */
+    if(size%8)
+        out += Implementation::popcount(_data[DataSize-1] & LastSegmentMask);
+
+    return out;
+}
+
+template<std::size_t size> std::size_t BoolVector<size>::findSet(const std::size_t from) const {
+    if(from >= size) return size;
+
+    std::size_t i = from/8;
+    UnsignedInt segment = _data[i] & (FullSegmentMask << from%8);
+    for(;;) {
+        if(size%8 && i == DataSize-1) segment &= LastSegmentMask;
+        if(segment) return i*8 + Implementation::trailingZeros(segment);
+        if(++i == DataSize) return size;
+
+        /* Skip eight empty full segments at once */
+        while(i + 8 <= size/8 && !Implementation::loadSegments(_data + i))
+            i += 8;
+        if(i == DataSize) return size;
+        segment = _data[i];
+    }
+}
+
+template<std::size_t size> template<class F> void BoolVector<size>::forEachSet(F f) const {
+    /* Eight full segments at once, then the rest */
+    std::size_t i = 0;
+    for(; i + 8 <= size/8; i += 8) {
+        if(!Implementation::loadSegments(_data + i)) continue;
+        for(std::size_t j = i; j != i + 8; ++j)
+            Implementation::forEachSetInSegment(_data[j], j*8, f);
+    }
+    for(; i != size/8; ++i)
+        Implementation::forEachSetInSegment(_data[i], i*8, f);
+
+    /* Last segment */
+    if(size%8)
+        Implementation::forEachSetInSegment(_data[DataSize-1] & LastSegmentMask, (DataSize-1)*8, f);
+}
+
 template<std::size_t size> inline BoolVector<size> BoolVector<size>::operator~() const {
     BoolVector<size> out;
 
@@ -273,6 +418,95 @@ template<std::size_t size> inline BoolVector<size> BoolVector<size>::operator~()
     return out;
 }
 
+namespace Implementation {
+    /* Applies given operation on the whole arrays, eight bytes at once. The
+       vectors are just arrays of bytes, so the arrays are contiguous. */
+    template<std::size_t size, class Operation> void bitwise(Corrade::Containers::ArrayReference<const BoolVector<size>> a, Corrade::Containers::ArrayReference<const BoolVector<size>> b, Corrade::Containers::ArrayReference<BoolVector<size>> out, Operation operation) {
+        static_assert(sizeof(BoolVector<size>) == BoolVector<size>::DataSize, "BoolVector has padding");
+
+        const UnsignedByte* const aData = a.empty() ? nullptr : a[0].data();
+        const UnsignedByte* const bData = b.empty() ? nullptr : b[0].data();
+        UnsignedByte* const outData = out.empty() ? nullptr : out[0].data();
+        const std::size_t dataSize = a.size()*BoolVector<size>::DataSize;
+
+        std::size_t i = 0;
+        for(; i + 8 <= dataSize; i += 8)
+            storeSegments(outData + i, operation(loadSegments(aData + i), loadSegments(bData + i)));
+        for(; i != dataSize; ++i)
+            outData[i] = UnsignedByte(operation(aData[i], bData[i]));
+    }
+}
+
+/** @relates BoolVector
+@brief Bitwise AND of two arrays of boolean vectors
+
+Equivalent to calling @ref BoolVector::operator&() on each pair of
+vectors, but operates on eight bytes at once. Expects that all arrays have the
+same size, @p out may alias any of the inputs. The size can't be deduced from
+array references constructed in place, specify it explicitly in that case:
+@code
+std::vector<Math::BoolVector<32>> visible, lit;
+Math::bitwiseAnd<32>({visible.data(), visible.size()}, {lit.data(), lit.size()}, {visible.data(), visible.size()});
+@endcode
+*/
+template<std::size_t size> inline void bitwiseAnd(Corrade::Containers::ArrayReference<const BoolVector<size>> a, Corrade::Containers::ArrayReference<const BoolVector<size>> b, Corrade::Containers::ArrayReference<BoolVector<size>> out) {
+    CORRADE_ASSERT(a.size() == b.size() && a.size() == out.size(),
+        "Math::bitwiseAnd(): expected arrays of the same size", );
+    Implementation::bitwise(a, b, out, [](UnsignedLong a, UnsignedLong b) { return a & b; });
+}
+
+/** @relates BoolVector
+@brief Bitwise OR of two arrays of boolean vectors
+
+Equivalent to calling @ref BoolVector::operator|() on each pair of
+vectors, but operates on eight bytes at once. Expects that all arrays have the
+same size, @p out may alias any of the inputs.
+*/
+template<std::size_t size> inline void bitwiseOr(Corrade::Containers::ArrayReference<const BoolVector<size>> a, Corrade::Containers::ArrayReference<const BoolVector<size>> b, Corrade::Containers::ArrayReference<BoolVector<size>> out) {
+    CORRADE_ASSERT(a.size() == b.size() && a.size() == out.size(),
+        "Math::bitwiseOr(): expected arrays of the same size", );
+    Implementation::bitwise(a, b, out, [](UnsignedLong a, UnsignedLong b) { return a | b; });
+}
+
+/** @relates BoolVector
+@brief Bitwise XOR of two arrays of boolean vectors
+
+Equivalent to calling @ref BoolVector::operator^() on each pair of
+vectors, but operates on eight bytes at once. Expects that all arrays have the
+same size, @p out may alias any of the inputs.
+*/
+template<std::size_t size> inline void bitwiseXor(Corrade::Containers::ArrayReference<const BoolVector<size>> a, Corrade::Containers::ArrayReference<const BoolVector<size>> b, Corrade::Containers::ArrayReference<BoolVector<size>> out) {
+    CORRADE_ASSERT(a.size() == b.size() && a.size() == out.size(),
+        "Math::bitwiseXor(): expected arrays of the same size", );
+    Implementation::bitwise(a, b, out, [](UnsignedLong a, UnsignedLong b) { return a ^ b; });
+}
+
+/** @relates BoolVector
+@brief Count of set bits in array of boolean vectors
+
+Equivalent to summing @ref BoolVector::count() of all vectors. If @p size is
+divisible by eight, the whole array is counted eight bytes at once.
+*/
+template<std::size_t size> std::size_t count(Corrade::Containers::ArrayReference<const BoolVector<size>> vectors) {
+    std::size_t out = 0;
+
+    /* No unused bits, count the array as a whole */
+    if(size%8 == 0) {
+        if(vectors.empty()) return 0;
+        const UnsignedByte* const data = vectors[0].data();
+        const std::size_t dataSize = vectors.size()*BoolVector<size>::DataSize;
+        std::size_t i = 0;
+        for(; i + 8 <= dataSize; i += 8)
+            out += Implementation::popcount(Implementation::loadSegments(data + i));
+        for(; i != dataSize; ++i)
+            out += Implementation::popcount(data[i]);
+
+    } else for(const BoolVector<size>& vector: vectors)
+        out += vector.count();
+
+    return out;
+}
+
 }}
 
 #endif
@@ -0,0 +1,93 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "FastFunctions.h"
+
+#include <Utility/Assert.h>
+
+namespace Magnum { namespace Math { namespace Fast {
+
+/* The loops are kept trivial so the compiler can vectorize them */
+
+void sincos(Corrade::Containers::ArrayReference<const Float> angles, Corrade::Containers::ArrayReference<Float> sines, Corrade::Containers::ArrayReference<Float> cosines) {
+    CORRADE_ASSERT(sines.size() == angles.size() && cosines.size() == angles.size(),
+        "Math::Fast::sincos(): expected output arrays of the same size as input", );
+
+    for(std::size_t i = 0; i != angles.size(); ++i) {
+        const std::pair<Float, Float> sincos = Fast::sincos(Rad<Float>(angles[i]));
+        sines[i] = sincos.first;
+        cosines[i] = sincos.second;
+    }
+}
+
+void sin(Corrade::Containers::ArrayReference<const Float> angles, Corrade::Containers::ArrayReference<Float> out) {
+    CORRADE_ASSERT(out.size() == angles.size(),
+        "Math::Fast::sin(): expected output array of size" << angles.size() << "but got" << out.size(), );
+
+    for(std::size_t i = 0; i != angles.size(); ++i)
+        out[i] = sin(Rad<Float>(angles[i]));
+}
+
+void cos(Corrade::Containers::ArrayReference<const Float> angles, Corrade::Containers::ArrayReference<Float> out) {
+    CORRADE_ASSERT(out.size() == angles.size(),
+        "Math::Fast::cos(): expected output array of size" << angles.size() << "but got" << out.size(), );
+
+    for(std::size_t i = 0; i != angles.size(); ++i)
+        out[i] = cos(Rad<Float>(angles[i]));
+}
+
+void atan2(Corrade::Containers::ArrayReference<const Float> y, Corrade::Containers::ArrayReference<const Float> x, Corrade::Containers::ArrayReference<Float> out) {
+    CORRADE_ASSERT(x.size() == y.size() && out.size() == y.size(),
+        "Math::Fast::atan2(): expected arrays of the same size", );
+
+    for(std::size_t i = 0; i != y.size(); ++i)
+        out[i] = Float(atan2(y[i], x[i]));
+}
+
+void sqrtInverted(Corrade::Containers::ArrayReference<const Float> values, Corrade::Containers::ArrayReference<Float> out) {
+    CORRADE_ASSERT(out.size() == values.size(),
+        "Math::Fast::sqrtInverted(): expected output array of size" << values.size() << "but got" << out.size(), );
+
+    for(std::size_t i = 0; i != values.size(); ++i)
+        out[i] = sqrtInverted(values[i]);
+}
+
+void sqrt(Corrade::Containers::ArrayReference<const Float> values, Corrade::Containers::ArrayReference<Float> out) {
+    CORRADE_ASSERT(out.size() == values.size(),
+        "Math::Fast::sqrt(): expected output array of size" << values.size() << "but got" << out.size(), );
+
+    for(std::size_t i = 0; i != values.size(); ++i)
+        out[i] = sqrt(values[i]);
+}
+
+void exp(Corrade::Containers::ArrayReference<const Float> values, Corrade::Containers::ArrayReference<Float> out) {
+    CORRADE_ASSERT(out.size() == values.size(),
+        "Math::Fast::exp(): expected output array of size" << values.size() << "but got" << out.size(), );
+
+    for(std::size_t i = 0; i != values.size(); ++i)
+        out[i] = exp(values[i]);
+}
+
+}}}
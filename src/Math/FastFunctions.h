@@ -0,0 +1,294 @@
+#ifndef Magnum_Math_FastFunctions_h
+#define Magnum_Math_FastFunctions_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Namespace Magnum::Math::Fast, fast approximations of transcendental functions
+ */
+
+#include <cstring>
+#include <utility>
+#include <Containers/Array.h>
+
+#include "Math/Angle.h"
+
+#include "magnumVisibility.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@brief Fast approximations of transcendental functions
+
+Polynomial approximations of functions from @ref Functions.h for use in
+places where throughput matters more than last-bit precision, such as
+particle systems or procedural animation. All functions operate on @ref Float
+only, have no branches (so loops calling them can be auto-vectorized) and
+their maximal error is documented for each function. The precision is
+verified against `std::` functions in tests.
+
+Besides scalar versions there are also batch versions operating on whole
+arrays. These are compiled as part of the library with auto-vectorization
+explicitly enabled, so in optimized builds of the library they are vectorized
+regardless of optimization flags of the calling code.
+*/
+namespace Fast {
+
+namespace Implementation {
+    inline UnsignedInt bits(Float value) {
+        UnsignedInt out;
+        std::memcpy(&out, &value, sizeof(Float));
+        return out;
+    }
+
+    inline Float fromBits(UnsignedInt value) {
+        Float out;
+        std::memcpy(&out, &value, sizeof(Float));
+        return out;
+    }
+
+    /* Branchless selection. The compiler tends to turn a plain ternary
+       operator into real branches around the floating-point arithmetic
+       (which then can't be vectorized as it may trap), this prevents it. */
+    inline Float select(bool condition, Float a, Float b) {
+        const UnsignedInt mask = UnsignedInt(-Int(condition));
+        return fromBits((bits(a) & mask)|(bits(b) & ~mask));
+    }
+
+    /* Value with sign of another value */
+    inline Float copysign(Float value, Float sign) {
+        return fromBits((bits(value) & 0x7fffffffu)|(bits(sign) & 0x80000000u));
+    }
+
+    /* Round to nearest integer without calling std::round(), which is not
+       vectorized without SSE4.1 */
+    inline Int round(Float value) {
+        return Int(value + copysign(0.5f, value));
+    }
+}
+
+/**
+@brief Sine and cosine
+
+The angle is reduced to @f$ [-\frac{\pi}{4}; \frac{\pi}{4}] @f$ and both
+values are then computed using minimax polynomials. Maximal absolute error
+is about @f$ 10^{-7} @f$ for angles in range @f$ [-8192; 8192] @f$, outside of
+it the argument reduction gradually loses precision.
+@see Math::sin(), Math::cos()
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+inline std::pair<Float, Float> sincos(Rad<Float> angle);
+#else
+inline std::pair<Float, Float> sincos(Unit<Rad, Float> angle) {
+    /* Reduction by π/2 split into three parts so the subtraction is exact */
+    const Float x = Float(angle);
+    const Int quadrant = Implementation::round(x*0.636619772367581343f);
+    const Float q = Float(quadrant);
+    const Float r = ((x - q*1.5703125f) - q*4.83751296997070312e-4f) - q*7.54978995489188216e-8f;
+    const Float r2 = r*r;
+
+    const Float sinr = r + r*r2*(-1.6666654611e-1f + r2*(8.3321608736e-3f + r2*-1.9515295891e-4f));
+    const Float cosr = 1.0f - 0.5f*r2 + r2*r2*(4.166664568298827e-2f + r2*(-1.388731625493765e-3f + r2*2.443315711809948e-5f));
+
+    /* Swap the values in odd quadrants, flip signs in the second half of
+       the period */
+    const Float s = Implementation::select(quadrant & 1, cosr, sinr);
+    const Float c = Implementation::select(quadrant & 1, sinr, cosr);
+    return {Implementation::fromBits(Implementation::bits(s) ^ (UnsignedInt(quadrant & 2) << 30)),
+            Implementation::fromBits(Implementation::bits(c) ^ (UnsignedInt((quadrant + 1) & 2) << 30))};
+}
+inline std::pair<Float, Float> sincos(Unit<Deg, Float> angle) { return sincos(Rad<Float>(angle)); }
+#endif
+
+/**
+@brief Sine
+
+Same as sincos(), but returns only the sine.
+@see Math::sin()
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+inline Float sin(Rad<Float> angle);
+#else
+inline Float sin(Unit<Rad, Float> angle) { return sincos(angle).first; }
+inline Float sin(Unit<Deg, Float> angle) { return sin(Rad<Float>(angle)); }
+#endif
+
+/**
+@brief Cosine
+
+Same as sincos(), but returns only the cosine.
+@see Math::cos()
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+inline Float cos(Rad<Float> angle);
+#else
+inline Float cos(Unit<Rad, Float> angle) { return sincos(angle).second; }
+inline Float cos(Unit<Deg, Float> angle) { return cos(Rad<Float>(angle)); }
+#endif
+
+/**
+@brief Arc tangent of two values
+
+Returns angle of vector (@p x, @p y) from positive X axis in range
+@f$ [-\pi; \pi] @f$. The ratio of smaller and larger absolute value is
+evaluated using polynomial from *Abramowitz, M.; Stegun, I. (1964) "Handbook
+of Mathematical Functions", 4.4.49* and the result is then mirrored to correct
+octant. Maximal absolute error is about @f$ 3 \cdot 10^{-7} @f$. Unlike
+`std::atan2()` doesn't distinguish between positive and negative zero in
+@p x, i.e. returns @f$ 0 @f$ for both (0, 0) and (0, -0).
+*/
+inline Rad<Float> atan2(Float y, Float x) {
+    const Float absx = Implementation::fromBits(Implementation::bits(x) & 0x7fffffffu);
+    const Float absy = Implementation::fromBits(Implementation::bits(y) & 0x7fffffffu);
+    const bool swap = absy > absx;
+    const Float max = Implementation::select(swap, absy, absx);
+    const Float min = Implementation::select(swap, absx, absy);
+    const Float a = min/Implementation::select(max == 0.0f, 1.0f, max);
+    const Float s = a*a;
+
+    Float r = a + a*s*(-0.3333314528f + s*(0.1999355085f + s*(-0.1420889944f +
+        s*(0.1065626393f + s*(-0.0752896400f + s*(0.0429096138f +
+        s*(-0.0161657367f + s*0.0028662257f)))))));
+
+    /* Mirror to correct octant, the sign is taken directly from y */
+    r = Implementation::select(swap, 1.57079632679489662f - r, r);
+    r = Implementation::select(x < 0.0f, 3.14159265358979324f - r, r);
+    return Rad<Float>(Implementation::copysign(r, y));
+}
+
+/**
+@brief Inverse square root
+
+Initial approximation using bit manipulation refined with two Newton-Raphson
+iterations. Maximal relative error is about @f$ 5 \cdot 10^{-6} @f$. Expects
+that the value is positive.
+@see Math::sqrtInverted()
+*/
+inline Float sqrtInverted(Float value) {
+    Float y = Implementation::fromBits(0x5f375a86u - (Implementation::bits(value) >> 1));
+    const Float half = 0.5f*value;
+    y *= 1.5f - half*y*y;
+    y *= 1.5f - half*y*y;
+    return y;
+}
+
+/**
+@brief Square root
+
+Computed as @f$ x \frac{1}{\sqrt x} @f$ using sqrtInverted(), thus with the
+same relative error. Expects that the value is non-negative, returns exactly
+@f$ 0 @f$ for zero.
+@see Math::sqrt()
+*/
+inline Float sqrt(Float value) {
+    /* The initial approximation is finite for zero, so no special handling
+       is needed to avoid 0*inf */
+    return value*sqrtInverted(value);
+}
+
+/**
+@brief Natural exponential
+
+Computed as @f$ 2^n e^r @f$, where @f$ |r| \le \frac{\ln 2}{2} @f$ and
+@f$ e^r @f$ is evaluated using minimax polynomial. Maximal relative error is
+about @f$ 2 \cdot 10^{-7} @f$. To avoid special-casing overflow and
+underflow, the input is clamped to @f$ [-87.33; 88.02] @f$, i.e. the range
+where the result is finite, normalized @ref Float.
+*/
+inline Float exp(Float value) {
+    const Float min = Implementation::select(value < -87.3365448f, -87.3365448f, value);
+    const Float x = Implementation::select(min > 88.0296919f, 88.0296919f, min);
+
+    /* Reduction by ln 2 split into two parts so the subtraction is exact */
+    const Int n = Implementation::round(x*1.44269504088896341f);
+    const Float r = (x - Float(n)*0.693359375f) + Float(n)*2.12194440e-4f;
+
+    const Float er = 1.0f + r + r*r*(5.0000001201e-1f + r*(1.6666665459e-1f +
+        r*(4.1665795894e-2f + r*(8.3334519073e-3f + r*(1.3981999507e-3f +
+        r*1.9875691500e-4f)))));
+    return er*Implementation::fromBits(UnsignedInt(n + 127) << 23);
+}
+
+/**
+@brief Sine and cosine of array of values
+
+Calls sincos() on each value in @p angles, which are expected to be in
+radians, and puts the results to @p sines and @p cosines. Expects that all
+arrays have the same size.
+*/
+void MAGNUM_EXPORT sincos(Corrade::Containers::ArrayReference<const Float> angles, Corrade::Containers::ArrayReference<Float> sines, Corrade::Containers::ArrayReference<Float> cosines);
+
+/**
+@brief Sine of array of values
+
+Calls sin() on each value in @p angles, which are expected to be in radians,
+and puts the results to @p out. Expects that both arrays have the same size.
+*/
+void MAGNUM_EXPORT sin(Corrade::Containers::ArrayReference<const Float> angles, Corrade::Containers::ArrayReference<Float> out);
+
+/**
+@brief Cosine of array of values
+
+Calls cos() on each value in @p angles, which are expected to be in radians,
+and puts the results to @p out. Expects that both arrays have the same size.
+*/
+void MAGNUM_EXPORT cos(Corrade::Containers::ArrayReference<const Float> angles, Corrade::Containers::ArrayReference<Float> out);
+
+/**
+@brief Arc tangent of array of value pairs
+
+Calls atan2() on each pair of values in @p y and @p x and puts the results in
+radians to @p out. Expects that all arrays have the same size.
+*/
+void MAGNUM_EXPORT atan2(Corrade::Containers::ArrayReference<const Float> y, Corrade::Containers::ArrayReference<const Float> x, Corrade::Containers::ArrayReference<Float> out);
+
+/**
+@brief Inverse square root of array of values
+
+Calls sqrtInverted() on each value in @p values and puts the results to
+@p out. Expects that both arrays have the same size.
+*/
+void MAGNUM_EXPORT sqrtInverted(Corrade::Containers::ArrayReference<const Float> values, Corrade::Containers::ArrayReference<Float> out);
+
+/**
+@brief Square root of array of values
+
+Calls sqrt() on each value in @p values and puts the results to @p out.
+Expects that both arrays have the same size.
+*/
+void MAGNUM_EXPORT sqrt(Corrade::Containers::ArrayReference<const Float> values, Corrade::Containers::ArrayReference<Float> out);
+
+/**
+@brief Natural exponential of array of values
+
+Calls exp() on each value in @p values and puts the results to @p out.
+Expects that both arrays have the same size.
+*/
+void MAGNUM_EXPORT exp(Corrade::Containers::ArrayReference<const Float> values, Corrade::Containers::ArrayReference<Float> out);
+
+}
+
+}}
+
+#endif
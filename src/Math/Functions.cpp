@@ -24,6 +24,8 @@
 
 #include "Functions.h"
 
+#include <cstring>
+
 namespace Magnum { namespace Math {
 
 UnsignedInt log2(UnsignedInt number) {
@@ -40,4 +42,64 @@ UnsignedInt log(UnsignedInt base, UnsignedInt number) {
     return log;
 }
 
+namespace {
+    inline UnsignedInt floatBits(Float value) {
+        UnsignedInt bits;
+        std::memcpy(&bits, &value, 4);
+        return bits;
+    }
+
+    inline Float floatFromBits(UnsignedInt bits) {
+        Float value;
+        std::memcpy(&value, &bits, 4);
+        return value;
+    }
+}
+
+UnsignedShort packHalf(const Float value) {
+    UnsignedInt bits = floatBits(value);
+    const UnsignedInt sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    UnsignedShort out;
+
+    /* Too large for half (>= 65536.0f before rounding), infinity or NaN */
+    if(bits >= 0x47800000u)
+        out = bits > 0x7f800000u ? 0x7e00 : 0x7c00;
+
+    /* Denormalized half or zero (< 2^-14). Adding 0.5f puts the mantissa
+       bits at the right place and the FPU does the rounding for us. */
+    else if(bits < 0x38800000u)
+        out = UnsignedShort(floatBits(floatFromBits(bits) + 0.5f) - 0x3f000000u);
+
+    /* Normalized half, rebias the exponent and round to nearest even */
+    else {
+        const UnsignedInt mantissaOdd = (bits >> 13) & 1;
+        bits += (UnsignedInt(15 - 127) << 23) + 0xfff + mantissaOdd;
+        out = UnsignedShort(bits >> 13);
+    }
+
+    return out|UnsignedShort(sign >> 16);
+}
+
+Float unpackHalf(const UnsignedShort value) {
+    constexpr UnsignedInt shiftedExponent = 0x7c00 << 13;
+
+    UnsignedInt bits = (value & 0x7fff) << 13;
+    const UnsignedInt exponent = bits & shiftedExponent;
+    bits += (127 - 15) << 23;
+
+    /* Infinity or NaN, adjust the exponent once more */
+    if(exponent == shiftedExponent)
+        bits += (128 - 16) << 23;
+
+    /* Zero or denormal, renormalize using the FPU */
+    else if(exponent == 0) {
+        bits += 1 << 23;
+        bits = floatBits(floatFromBits(bits) - floatFromBits(113 << 23));
+    }
+
+    return floatFromBits(bits|((value & 0x8000) << 16));
+}
+
 }}
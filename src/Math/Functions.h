@@ -489,6 +489,25 @@ template<class Integral, class FloatingPoint> inline typename std::enable_if<std
 }
 #endif
 
+/**
+@brief Pack 32-bit float value into 16-bit half-float representation
+
+Rounds to nearest representable value, ties to even. Values larger than
+@f$ 65504 @f$ are converted to infinity, values smaller than @f$ 2^{-24} @f$
+to (signed) zero, NaN is preserved. The result can be uploaded as vertex
+attribute with @ref Magnum::AbstractShaderProgram::Attribute::DataType "DataType::HalfFloat".
+@see @ref unpackHalf()
+*/
+UnsignedShort MAGNUM_EXPORT packHalf(Float value);
+
+/**
+@brief Unpack 16-bit half-float value into 32-bit float
+
+The conversion is lossless.
+@see @ref packHalf()
+*/
+Float MAGNUM_EXPORT unpackHalf(UnsignedShort value);
+
 /*@}*/
 
 }}
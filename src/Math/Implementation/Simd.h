@@ -0,0 +1,271 @@
+#ifndef Magnum_Math_Implementation_Simd_h
+#define Magnum_Math_Implementation_Simd_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <cstddef>
+
+#include "Types.h"
+
+/* Kernels are available whenever the target supports the instructions, so
+   they can be tested and benchmarked against the scalar code. Math classes
+   use them only if the library is built with MAGNUM_BUILD_SIMD. */
+#if defined(__SSE__)
+#define MAGNUM_MATH_SIMD_SSE
+#include <xmmintrin.h>
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define MAGNUM_MATH_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(MAGNUM_BUILD_SIMD) && (defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON))
+#define MAGNUM_MATH_SIMD
+#endif
+
+#if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+namespace Magnum { namespace Math { namespace Implementation { namespace Simd {
+
+/* All kernels operate on four-component float arrays without any alignment
+   requirements, matrices are column-major and quaternions are (x, y, z, w),
+   the same as the memory layout of corresponding Math classes. Outputs may
+   alias inputs. */
+
+#ifdef MAGNUM_MATH_SIMD_SSE
+typedef __m128 Register;
+inline Register load(const Float* data) { return _mm_loadu_ps(data); }
+inline void store(Float* data, Register value) { _mm_storeu_ps(data, value); }
+inline Register broadcast(Float value) { return _mm_set1_ps(value); }
+inline Register add(Register a, Register b) { return _mm_add_ps(a, b); }
+inline Register subtract(Register a, Register b) { return _mm_sub_ps(a, b); }
+inline Register multiply(Register a, Register b) { return _mm_mul_ps(a, b); }
+inline Register divide(Register a, Register b) { return _mm_div_ps(a, b); }
+inline Register minimum(Register a, Register b) { return _mm_min_ps(a, b); }
+inline Register maximum(Register a, Register b) { return _mm_max_ps(a, b); }
+inline Register squareRoot(Register a) { return _mm_sqrt_ps(a); }
+
+/* a with sign flipped in components where sign is negative */
+inline Register flipSign(Register a, Register sign) {
+    return _mm_xor_ps(a, _mm_and_ps(sign, _mm_set1_ps(-0.0f)));
+}
+
+/* Horizontal sum, returned in all four components */
+inline Register sum(Register a) {
+    a = _mm_add_ps(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_add_ps(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+inline Float first(Register a) { return _mm_cvtss_f32(a); }
+
+/* Broadcast of given component */
+template<int i> inline Register component(Register a) {
+    return _mm_shuffle_ps(a, a, _MM_SHUFFLE(i, i, i, i));
+}
+#else
+typedef float32x4_t Register;
+inline Register load(const Float* data) { return vld1q_f32(data); }
+inline void store(Float* data, Register value) { vst1q_f32(data, value); }
+inline Register broadcast(Float value) { return vdupq_n_f32(value); }
+inline Register add(Register a, Register b) { return vaddq_f32(a, b); }
+inline Register subtract(Register a, Register b) { return vsubq_f32(a, b); }
+inline Register multiply(Register a, Register b) { return vmulq_f32(a, b); }
+inline Register minimum(Register a, Register b) { return vminq_f32(a, b); }
+inline Register maximum(Register a, Register b) { return vmaxq_f32(a, b); }
+
+/* ARMv7 NEON has only reciprocal estimate, do the division in scalar to have
+   the same results as the scalar code */
+inline Register divide(Register a, Register b) {
+    #ifdef __aarch64__
+    return vdivq_f32(a, b);
+    #else
+    Float x[4], y[4];
+    vst1q_f32(x, a);
+    vst1q_f32(y, b);
+    for(std::size_t i = 0; i != 4; ++i) x[i] /= y[i];
+    return vld1q_f32(x);
+    #endif
+}
+
+/* Similarly for square root */
+inline Register squareRoot(Register a) {
+    #ifdef __aarch64__
+    return vsqrtq_f32(a);
+    #else
+    Float x[4];
+    vst1q_f32(x, a);
+    for(std::size_t i = 0; i != 4; ++i) x[i] = std::sqrt(x[i]);
+    return vld1q_f32(x);
+    #endif
+}
+
+inline Register flipSign(Register a, Register sign) {
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a),
+        vandq_u32(vreinterpretq_u32_f32(sign), vdupq_n_u32(0x80000000u))));
+}
+
+inline Register sum(Register a) {
+    const float32x2_t pair = vadd_f32(vget_low_f32(a), vget_high_f32(a));
+    return vdupq_lane_f32(vpadd_f32(pair, pair), 0);
+}
+
+inline Float first(Register a) { return vgetq_lane_f32(a, 0); }
+
+template<int i> inline Register component(Register a) {
+    return vdupq_n_f32(vgetq_lane_f32(a, i));
+}
+#endif
+
+/* Arbitrary permutation of sixteen bytes, indices with highest bit set result
+   in zero. On x86 it needs SSSE3. */
+#if defined(__SSSE3__) || defined(MAGNUM_MATH_SIMD_NEON)
+#define MAGNUM_MATH_SIMD_BYTE_SHUFFLE
+#ifdef __SSSE3__
+typedef __m128i ByteRegister;
+inline ByteRegister loadBytes(const void* data) { return _mm_loadu_si128(static_cast<const __m128i*>(data)); }
+inline void storeBytes(void* data, ByteRegister value) { _mm_storeu_si128(static_cast<__m128i*>(data), value); }
+inline ByteRegister shuffleBytes(ByteRegister a, ByteRegister indices) { return _mm_shuffle_epi8(a, indices); }
+inline ByteRegister orBytes(ByteRegister a, ByteRegister b) { return _mm_or_si128(a, b); }
+#else
+typedef uint8x16_t ByteRegister;
+inline ByteRegister loadBytes(const void* data) { return vld1q_u8(static_cast<const UnsignedByte*>(data)); }
+inline void storeBytes(void* data, ByteRegister value) { vst1q_u8(static_cast<UnsignedByte*>(data), value); }
+inline ByteRegister shuffleBytes(ByteRegister a, ByteRegister indices) {
+    #ifdef __aarch64__
+    return vqtbl1q_u8(a, indices);
+    #else
+    const uint8x8x2_t table = {{vget_low_u8(a), vget_high_u8(a)}};
+    return vcombine_u8(vtbl2_u8(table, vget_low_u8(indices)), vtbl2_u8(table, vget_high_u8(indices)));
+    #endif
+}
+inline ByteRegister orBytes(ByteRegister a, ByteRegister b) { return vorrq_u8(a, b); }
+#endif
+#endif
+
+/* a = a + b */
+inline void add4(Float* a, const Float* b) {
+    store(a, add(load(a), load(b)));
+}
+
+/* a = a - b */
+inline void subtract4(Float* a, const Float* b) {
+    store(a, subtract(load(a), load(b)));
+}
+
+/* a = a*b */
+inline void multiply4(Float* a, const Float* b) {
+    store(a, multiply(load(a), load(b)));
+}
+
+/* a = a*b */
+inline void multiply4(Float* a, Float b) {
+    store(a, multiply(load(a), broadcast(b)));
+}
+
+/* a = a/b */
+inline void divide4(Float* a, const Float* b) {
+    store(a, divide(load(a), load(b)));
+}
+
+/* a = a/b */
+inline void divide4(Float* a, Float b) {
+    store(a, divide(load(a), broadcast(b)));
+}
+
+/* out = -a, multiplication to have the same sign of zero as scalar code */
+inline void negate4(Float* out, const Float* a) {
+    store(out, multiply(load(a), broadcast(-1.0f)));
+}
+
+/* a·b */
+inline Float dot4(const Float* a, const Float* b) {
+    return first(sum(multiply(load(a), load(b))));
+}
+
+/* out = a*b, each output column is linear combination of columns of a */
+inline void multiplyMatrix4(Float* out, const Float* a, const Float* b) {
+    const Register a0 = load(a);
+    const Register a1 = load(a + 4);
+    const Register a2 = load(a + 8);
+    const Register a3 = load(a + 12);
+
+    Register columns[4];
+    for(std::size_t i = 0; i != 4; ++i) {
+        const Register column = load(b + i*4);
+        columns[i] = add(add(multiply(a0, component<0>(column)),
+                             multiply(a1, component<1>(column))),
+                         add(multiply(a2, component<2>(column)),
+                             multiply(a3, component<3>(column))));
+    }
+
+    for(std::size_t i = 0; i != 4; ++i)
+        store(out + i*4, columns[i]);
+}
+
+/* out = m*v, summed in the same order as the scalar code so transformed
+   points are the same regardless of whether SIMD is used */
+inline void transformVector4(Float* out, const Float* m, const Float* v) {
+    const Register vector = load(v);
+    store(out, add(add(add(multiply(load(m), component<0>(vector)),
+                           multiply(load(m + 4), component<1>(vector))),
+                       multiply(load(m + 8), component<2>(vector))),
+                   multiply(load(m + 12), component<3>(vector))));
+}
+
+/* Quaternion product, written as linear combination of sign-flipped
+   permutations of a:
+
+    ab = b_x (a_w, a_z, -a_y, -a_x) + b_y (-a_z, a_w, a_x, -a_y) +
+         b_z (a_y, -a_x, a_w, -a_z) + b_w (a_x, a_y, a_z, a_w) */
+inline Register multiplyQuaternion(Register a, Register b) {
+    #ifdef MAGNUM_MATH_SIMD_SSE
+    const Register wzyx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 1, 2, 3));
+    const Register zwxy = _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 3, 2));
+    const Register yxwz = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+    #else
+    const Register yxwz = vrev64q_f32(a);
+    const Register wzyx = vextq_f32(yxwz, yxwz, 2);
+    const Register zwxy = vextq_f32(a, a, 2);
+    #endif
+    const Float signX[] = { 1.0f,  1.0f, -1.0f, -1.0f};
+    const Float signY[] = {-1.0f,  1.0f,  1.0f, -1.0f};
+    const Float signZ[] = { 1.0f, -1.0f,  1.0f, -1.0f};
+
+    return add(add(multiply(multiply(wzyx, load(signX)), component<0>(b)),
+                   multiply(multiply(zwxy, load(signY)), component<1>(b))),
+               add(multiply(multiply(yxwz, load(signZ)), component<2>(b)),
+                   multiply(a, component<3>(b))));
+}
+
+/* out = a*b */
+inline void multiplyQuaternion(Float* out, const Float* a, const Float* b) {
+    store(out, multiplyQuaternion(load(a), load(b)));
+}
+
+}}}}
+#endif
+
+#endif
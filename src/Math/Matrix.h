@@ -28,12 +28,17 @@
  * @brief Class Magnum::Math::Matrix
  */
 
+#include <type_traits>
+#include <utility>
+
 #include "RectangularMatrix.h"
+#include "Math/Implementation/Simd.h"
 
 namespace Magnum { namespace Math {
 
 namespace Implementation {
     template<std::size_t size, class T> class MatrixDeterminant;
+    template<std::size_t size, class T> class MatrixInverter;
 }
 
 /**
@@ -129,26 +134,38 @@ template<std::size_t size, class T> class Matrix: public RectangularMatrix<size,
         /**
          * @brief Determinant
          *
-         * Computed recursively using Laplace's formula: @f[
+         * Matrices up to 4x4 use closed-form expansion, the 4x4 one shares
+         * 2x2 sub-determinants of the upper and lower half of the matrix: @f[
+         *      \det(A) = s_0 c_5 - s_1 c_4 + s_2 c_3 + s_3 c_2 - s_4 c_1 + s_5 c_0
+         * @f] Larger floating-point matrices are decomposed using LU
+         * decomposition with partial pivoting and the determinant is the
+         * product of the pivots. Larger integral matrices are computed
+         * recursively using Laplace's formula: @f[
          *      \det(A) = \sum_{j=1}^n (-1)^{i+j} a_{i,j} \det(A^{i,j})
          * @f] @f$ A^{i, j} @f$ is matrix without i-th row and j-th column, see
-         * ij(). The formula is expanded down to 2x2 matrix, where the
-         * determinant is computed directly: @f[
-         *      \det(A) = a_{0, 0} a_{1, 1} - a_{1, 0} a_{0, 1}
-         * @f]
+         * ij().
          */
         T determinant() const { return Implementation::MatrixDeterminant<size, T>()(*this); }
 
         /**
          * @brief Inverted matrix
          *
-         * Computed using Cramer's rule: @f[
+         * Matrices up to 4x4 are computed using Cramer's rule: @f[
          *      A^{-1} = \frac{1}{\det(A)} Adj(A)
-         * @f]
+         * @f] with the cofactors expanded in closed form, the 4x4 version
+         * reuses the 2x2 sub-determinants from determinant() for all
+         * cofactors. If compiled with `BUILD_SIMD` on SSE targets, 4x4
+         * @ref Magnum::Float "Float" matrices are inverted blockwise in
+         * four-component registers. Larger floating-point matrices are
+         * inverted using LU decomposition with partial pivoting, larger
+         * integral matrices use Cramer's rule with cofactors computed from
+         * ij(). The matrix is expected to be invertible, i.e. have non-zero
+         * determinant.
+         *
          * See invertedOrthogonal(), Matrix3::invertedRigid() and Matrix4::invertedRigid()
          * which are faster alternatives for particular matrix types.
          */
-        Matrix<size, T> inverted() const;
+        Matrix<size, T> inverted() const { return Implementation::MatrixInverter<size, T>()(*this); }
 
         /**
          * @brief Inverted orthogonal matrix
@@ -251,19 +268,104 @@ template<std::size_t size, class T> inline Corrade::Utility::Debug operator<<(Co
 
 namespace Implementation {
 
+/* LU decomposition with partial pivoting, done in place on the transposed
+   matrix (i.e. `m[col][row]` is treated as row `col`, which doesn't matter for
+   the determinant and the inverse is transposed back by the solve). Lower
+   triangular part holds the multipliers, upper triangular part the U matrix,
+   `permutation` maps rows of U to original rows. Returns false if the matrix
+   is singular. */
+template<std::size_t size, class T> bool luDecomposition(Matrix<size, T>& m, std::size_t(&permutation)[size], bool& oddPermutation) {
+    oddPermutation = false;
+    for(std::size_t i = 0; i != size; ++i)
+        permutation[i] = i;
+
+    for(std::size_t k = 0; k != size; ++k) {
+        /* Find the pivot */
+        std::size_t pivot = k;
+        T pivotValue = std::abs(m[k][k]);
+        for(std::size_t i = k+1; i != size; ++i) if(std::abs(m[i][k]) > pivotValue) {
+            pivot = i;
+            pivotValue = std::abs(m[i][k]);
+        }
+
+        if(pivotValue == T(0)) return false;
+
+        if(pivot != k) {
+            std::swap(m[pivot], m[k]);
+            std::swap(permutation[pivot], permutation[k]);
+            oddPermutation = !oddPermutation;
+        }
+
+        /* Eliminate the column below the pivot */
+        for(std::size_t i = k+1; i != size; ++i) {
+            const T factor = (m[i][k] /= m[k][k]);
+            for(std::size_t j = k+1; j != size; ++j)
+                m[i][j] -= factor*m[k][j];
+        }
+    }
+
+    return true;
+}
+
 template<std::size_t size, class T> class MatrixDeterminant {
     public:
-        T operator()(const Matrix<size, T>& m);
-};
+        T operator()(const Matrix<size, T>& m) {
+            return compute(m, std::integral_constant<bool, std::is_floating_point<T>::value>());
+        }
 
-template<std::size_t size, class T> T MatrixDeterminant<size, T>::operator()(const Matrix<size, T>& m) {
-    T out(0);
+    private:
+        /* LU decomposition for floating-point types */
+        static T compute(Matrix<size, T> m, std::true_type) {
+            std::size_t permutation[size];
+            bool oddPermutation;
+            if(!luDecomposition(m, permutation, oddPermutation)) return T(0);
 
-    for(std::size_t col = 0; col != size; ++col)
-        out += ((col & 1) ? -1 : 1)*m[col][0]*m.ij(col, 0).determinant();
+            T out = oddPermutation ? T(-1) : T(1);
+            for(std::size_t i = 0; i != size; ++i)
+                out *= m[i][i];
+            return out;
+        }
 
-    return out;
-}
+        /* Laplace's formula for integral types */
+        static T compute(const Matrix<size, T>& m, std::false_type) {
+            T out(0);
+
+            for(std::size_t col = 0; col != size; ++col)
+                out += ((col & 1) ? -1 : 1)*m[col][0]*m.ij(col, 0).determinant();
+
+            return out;
+        }
+};
+
+template<class T> class MatrixDeterminant<4, T> {
+    public:
+        T operator()(const Matrix<4, T>& m) const {
+            /* 2x2 sub-determinants of the two left and two right columns */
+            const T s0 = m[0][0]*m[1][1] - m[1][0]*m[0][1];
+            const T s1 = m[0][0]*m[1][2] - m[1][0]*m[0][2];
+            const T s2 = m[0][0]*m[1][3] - m[1][0]*m[0][3];
+            const T s3 = m[0][1]*m[1][2] - m[1][1]*m[0][2];
+            const T s4 = m[0][1]*m[1][3] - m[1][1]*m[0][3];
+            const T s5 = m[0][2]*m[1][3] - m[1][2]*m[0][3];
+            const T c0 = m[2][0]*m[3][1] - m[3][0]*m[2][1];
+            const T c1 = m[2][0]*m[3][2] - m[3][0]*m[2][2];
+            const T c2 = m[2][0]*m[3][3] - m[3][0]*m[2][3];
+            const T c3 = m[2][1]*m[3][2] - m[3][1]*m[2][2];
+            const T c4 = m[2][1]*m[3][3] - m[3][1]*m[2][3];
+            const T c5 = m[2][2]*m[3][3] - m[3][2]*m[2][3];
+
+            return s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+        }
+};
+
+template<class T> class MatrixDeterminant<3, T> {
+    public:
+        constexpr T operator()(const Matrix<3, T>& m) const {
+            return m[0][0]*(m[1][1]*m[2][2] - m[2][1]*m[1][2]) -
+                   m[1][0]*(m[0][1]*m[2][2] - m[2][1]*m[0][2]) +
+                   m[2][0]*(m[0][1]*m[1][2] - m[1][1]*m[0][2]);
+        }
+};
 
 template<class T> class MatrixDeterminant<2, T> {
     public:
@@ -279,6 +381,219 @@ template<class T> class MatrixDeterminant<1, T> {
         }
 };
 
+template<std::size_t size, class T> class MatrixInverter {
+    public:
+        Matrix<size, T> operator()(const Matrix<size, T>& m) {
+            return compute(m, std::integral_constant<bool, std::is_floating_point<T>::value>());
+        }
+
+    private:
+        /* LU decomposition for floating-point types */
+        static Matrix<size, T> compute(Matrix<size, T> m, std::true_type) {
+            std::size_t permutation[size];
+            bool oddPermutation;
+            luDecomposition(m, permutation, oddPermutation);
+
+            /* Solve the system for each column of identity. As the
+               decomposition was done on the transposed matrix, the solution
+               of (PL U)^T x = e_i is the i-th column of the inverse. */
+            Matrix<size, T> out(Matrix<size, T>::Zero);
+            for(std::size_t i = 0; i != size; ++i) {
+                /* U^T y = e_i */
+                Vector<size, T> y;
+                for(std::size_t j = 0; j != size; ++j) {
+                    T sum = j == i ? T(1) : T(0);
+                    for(std::size_t k = 0; k != j; ++k)
+                        sum -= m[k][j]*y[k];
+                    y[j] = sum/m[j][j];
+                }
+
+                /* L^T z = y, z = P x */
+                for(std::size_t j = size; j != 0; --j) {
+                    T sum = y[j-1];
+                    for(std::size_t k = j; k != size; ++k)
+                        sum -= m[k][j-1]*out[i][permutation[k]];
+                    out[i][permutation[j-1]] = sum;
+                }
+            }
+
+            return out;
+        }
+
+        /* Cramer's rule for integral types */
+        static Matrix<size, T> compute(const Matrix<size, T>& m, std::false_type) {
+            Matrix<size, T> out(Matrix<size, T>::Zero);
+
+            const T determinant = m.determinant();
+
+            for(std::size_t col = 0; col != size; ++col)
+                for(std::size_t row = 0; row != size; ++row)
+                    out[col][row] = (((row+col) & 1) ? -1 : 1)*m.ij(row, col).determinant()/determinant;
+
+            return out;
+        }
+};
+
+template<class T> class MatrixInverter<4, T> {
+    public:
+        Matrix<4, T> operator()(const Matrix<4, T>& m) const {
+            /* Same sub-determinants as in MatrixDeterminant<4, T>, each is
+               used three times in the cofactors and once in the
+               determinant */
+            const T s0 = m[0][0]*m[1][1] - m[1][0]*m[0][1];
+            const T s1 = m[0][0]*m[1][2] - m[1][0]*m[0][2];
+            const T s2 = m[0][0]*m[1][3] - m[1][0]*m[0][3];
+            const T s3 = m[0][1]*m[1][2] - m[1][1]*m[0][2];
+            const T s4 = m[0][1]*m[1][3] - m[1][1]*m[0][3];
+            const T s5 = m[0][2]*m[1][3] - m[1][2]*m[0][3];
+            const T c0 = m[2][0]*m[3][1] - m[3][0]*m[2][1];
+            const T c1 = m[2][0]*m[3][2] - m[3][0]*m[2][2];
+            const T c2 = m[2][0]*m[3][3] - m[3][0]*m[2][3];
+            const T c3 = m[2][1]*m[3][2] - m[3][1]*m[2][2];
+            const T c4 = m[2][1]*m[3][3] - m[3][1]*m[2][3];
+            const T c5 = m[2][2]*m[3][3] - m[3][2]*m[2][3];
+
+            const T d = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+
+            return Matrix<4, T>(
+                Vector<4, T>(( m[1][1]*c5 - m[1][2]*c4 + m[1][3]*c3)/d,
+                             (-m[0][1]*c5 + m[0][2]*c4 - m[0][3]*c3)/d,
+                             ( m[3][1]*s5 - m[3][2]*s4 + m[3][3]*s3)/d,
+                             (-m[2][1]*s5 + m[2][2]*s4 - m[2][3]*s3)/d),
+                Vector<4, T>((-m[1][0]*c5 + m[1][2]*c2 - m[1][3]*c1)/d,
+                             ( m[0][0]*c5 - m[0][2]*c2 + m[0][3]*c1)/d,
+                             (-m[3][0]*s5 + m[3][2]*s2 - m[3][3]*s1)/d,
+                             ( m[2][0]*s5 - m[2][2]*s2 + m[2][3]*s1)/d),
+                Vector<4, T>(( m[1][0]*c4 - m[1][1]*c2 + m[1][3]*c0)/d,
+                             (-m[0][0]*c4 + m[0][1]*c2 - m[0][3]*c0)/d,
+                             ( m[3][0]*s4 - m[3][1]*s2 + m[3][3]*s0)/d,
+                             (-m[2][0]*s4 + m[2][1]*s2 - m[2][3]*s0)/d),
+                Vector<4, T>((-m[1][0]*c3 + m[1][1]*c1 - m[1][2]*c0)/d,
+                             ( m[0][0]*c3 - m[0][1]*c1 + m[0][2]*c0)/d,
+                             (-m[3][0]*s3 + m[3][1]*s1 - m[3][2]*s0)/d,
+                             ( m[2][0]*s3 - m[2][1]*s1 + m[2][2]*s0)/d));
+        }
+};
+
+#if defined(MAGNUM_MATH_SIMD) && defined(MAGNUM_MATH_SIMD_SSE)
+/* Blockwise inversion of 4x4 float matrix, each 2x2 block is one register
+   (row-major, which is the same as inverting the transposed matrix). With
+   A, B, C, D being the blocks, the inverse is 1/|M| (X, Y; Z, W) with
+   adj(X) = |D|A - B adj(D)C, adj(W) = |A|D - C adj(A)B,
+   adj(Y) = |B|C - D adj(adj(A)B), adj(Z) = |C|B - A adj(adj(D)C) and
+   |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C). */
+template<> class MatrixInverter<4, Float> {
+    public:
+        Matrix<4, Float> operator()(const Matrix<4, Float>& m) const {
+            const __m128 c0 = _mm_loadu_ps(m[0].data());
+            const __m128 c1 = _mm_loadu_ps(m[1].data());
+            const __m128 c2 = _mm_loadu_ps(m[2].data());
+            const __m128 c3 = _mm_loadu_ps(m[3].data());
+
+            const __m128 a = _mm_movelh_ps(c0, c1);
+            const __m128 b = _mm_movehl_ps(c1, c0);
+            const __m128 c = _mm_movelh_ps(c2, c3);
+            const __m128 d = _mm_movehl_ps(c3, c2);
+
+            /* (|A|, |B|, |C|, |D|) */
+            const __m128 detSub = _mm_sub_ps(
+                _mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(3, 1, 3, 1))),
+                _mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(2, 0, 2, 0))));
+            const __m128 detA = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(0, 0, 0, 0));
+            const __m128 detB = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(1, 1, 1, 1));
+            const __m128 detC = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(2, 2, 2, 2));
+            const __m128 detD = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(3, 3, 3, 3));
+
+            const __m128 dc = adjugateMultiply(d, c);
+            const __m128 ab = adjugateMultiply(a, b);
+
+            __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), multiply(b, dc));
+            __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), multiply(c, ab));
+            __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), multiplyAdjugate(d, ab));
+            __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), multiplyAdjugate(a, dc));
+
+            /* tr(adj(A)B adj(D)C), horizontal sum */
+            __m128 tr = _mm_mul_ps(ab, _mm_shuffle_ps(dc, dc, _MM_SHUFFLE(3, 1, 2, 0)));
+            tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(2, 3, 0, 1)));
+            tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(1, 0, 3, 2)));
+
+            const __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+            const __m128 invDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+
+            x = _mm_mul_ps(x, invDetM);
+            y = _mm_mul_ps(y, invDetM);
+            z = _mm_mul_ps(z, invDetM);
+            w = _mm_mul_ps(w, invDetM);
+
+            /* Adjugate of the blocks combined with the shuffle back */
+            Matrix<4, Float> out(Matrix<4, Float>::Zero);
+            _mm_storeu_ps(out[0].data(), _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+            _mm_storeu_ps(out[1].data(), _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+            _mm_storeu_ps(out[2].data(), _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+            _mm_storeu_ps(out[3].data(), _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+            return out;
+        }
+
+    private:
+        /* A*B of 2x2 row-major matrices */
+        static __m128 multiply(__m128 a, __m128 b) {
+            return _mm_add_ps(
+                _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+                _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+        }
+
+        /* adj(A)*B of 2x2 row-major matrices */
+        static __m128 adjugateMultiply(__m128 a, __m128 b) {
+            return _mm_sub_ps(
+                _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+                _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+
+        /* A*adj(B) of 2x2 row-major matrices */
+        static __m128 multiplyAdjugate(__m128 a, __m128 b) {
+            return _mm_sub_ps(
+                _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+                _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+        }
+};
+#endif
+
+template<class T> class MatrixInverter<3, T> {
+    public:
+        Matrix<3, T> operator()(const Matrix<3, T>& m) const {
+            /* Columns of the inverse are cross products of the rows */
+            const Vector<3, T> c0(m[1][1]*m[2][2] - m[2][1]*m[1][2],
+                                  m[2][1]*m[0][2] - m[0][1]*m[2][2],
+                                  m[0][1]*m[1][2] - m[1][1]*m[0][2]);
+            const Vector<3, T> c1(m[1][2]*m[2][0] - m[2][2]*m[1][0],
+                                  m[2][2]*m[0][0] - m[0][2]*m[2][0],
+                                  m[0][2]*m[1][0] - m[1][2]*m[0][0]);
+            const Vector<3, T> c2(m[1][0]*m[2][1] - m[2][0]*m[1][1],
+                                  m[2][0]*m[0][1] - m[0][0]*m[2][1],
+                                  m[0][0]*m[1][1] - m[1][0]*m[0][1]);
+
+            const T d = m[0][0]*c0[0] + m[1][0]*c0[1] + m[2][0]*c0[2];
+
+            return Matrix<3, T>(c0/d, c1/d, c2/d);
+        }
+};
+
+template<class T> class MatrixInverter<2, T> {
+    public:
+        Matrix<2, T> operator()(const Matrix<2, T>& m) const {
+            const T d = m.determinant();
+            return Matrix<2, T>(Vector<2, T>( m[1][1]/d, -m[0][1]/d),
+                                Vector<2, T>(-m[1][0]/d,  m[0][0]/d));
+        }
+};
+
+template<class T> class MatrixInverter<1, T> {
+    public:
+        Matrix<1, T> operator()(const Matrix<1, T>& m) const {
+            return Matrix<1, T>(Vector<1, T>(T(1)/m[0][0]));
+        }
+};
+
 }
 #endif
 
@@ -307,18 +622,6 @@ template<std::size_t size, class T> Matrix<size-1, T> Matrix<size, T>::ij(const
     return out;
 }
 
-template<std::size_t size, class T> Matrix<size, T> Matrix<size, T>::inverted() const {
-    Matrix<size, T> out(Zero);
-
-    const T _determinant = determinant();
-
-    for(std::size_t col = 0; col != size; ++col)
-        for(std::size_t row = 0; row != size; ++row)
-            out[col][row] = (((row+col) & 1) ? -1 : 1)*ij(row, col).determinant()/_determinant;
-
-    return out;
-}
-
 }}
 
 namespace Corrade { namespace Utility {
@@ -58,7 +58,6 @@ template<class T> class Quaternion {
          * @see dot() const
          */
         static T dot(const Quaternion<T>& a, const Quaternion<T>& b) {
-            /** @todo Use four-component SIMD implementation when available */
             return Vector3<T>::dot(a.vector(), b.vector()) + a.scalar()*b.scalar();
         }
 
@@ -551,6 +550,22 @@ template<class T> inline Quaternion<T> Quaternion<T>::operator*(const Quaternion
             _scalar*other._scalar - Vector3<T>::dot(_vector, other._vector)};
 }
 
+#if defined(MAGNUM_MATH_SIMD) && !defined(DOXYGEN_GENERATING_OUTPUT)
+template<> inline Float Quaternion<Float>::dot(const Quaternion<Float>& a, const Quaternion<Float>& b) {
+    const Float x[] = {a._vector.x(), a._vector.y(), a._vector.z(), a._scalar};
+    const Float y[] = {b._vector.x(), b._vector.y(), b._vector.z(), b._scalar};
+    return Implementation::Simd::dot4(x, y);
+}
+
+template<> inline Quaternion<Float> Quaternion<Float>::operator*(const Quaternion<Float>& other) const {
+    const Float a[] = {_vector.x(), _vector.y(), _vector.z(), _scalar};
+    const Float b[] = {other._vector.x(), other._vector.y(), other._vector.z(), other._scalar};
+    Float out[4];
+    Implementation::Simd::multiplyQuaternion(out, a, b);
+    return {Vector3<Float>(out[0], out[1], out[2]), out[3]};
+}
+#endif
+
 template<class T> inline Quaternion<T> Quaternion<T>::invertedNormalized() const {
     CORRADE_ASSERT(isNormalized(), "Math::Quaternion::invertedNormalized(): quaternion must be normalized",
         Quaternion<T>({}, std::numeric_limits<T>::quiet_NaN()));
@@ -0,0 +1,230 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "QuaternionBatch.h"
+
+#include <Utility/Assert.h>
+
+#include "Math/Implementation/Simd.h"
+
+namespace Magnum { namespace Math { namespace Batch {
+
+namespace {
+
+#if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+namespace Simd = Implementation::Simd;
+using Simd::Register;
+
+static_assert(sizeof(Quaternion<Float>) == 4*sizeof(Float) && sizeof(DualQuaternion<Float>) == 8*sizeof(Float),
+    "quaternion memory layout doesn't match SIMD register");
+
+/* Quaternion is (x, y, z, w) in memory, the same as the register layout
+   expected by the kernels */
+inline Register load(const Quaternion<Float>& q) {
+    return Simd::load(reinterpret_cast<const Float*>(&q));
+}
+
+inline void store(Quaternion<Float>& q, Register value) {
+    Simd::store(reinterpret_cast<Float*>(&q), value);
+}
+
+/* Dual quaternion is real part followed by dual part */
+inline Register loadReal(const DualQuaternion<Float>& q) {
+    return Simd::load(reinterpret_cast<const Float*>(&q));
+}
+
+inline Register loadDual(const DualQuaternion<Float>& q) {
+    return Simd::load(reinterpret_cast<const Float*>(&q) + 4);
+}
+
+inline void store(DualQuaternion<Float>& q, Register real, Register dual) {
+    Simd::store(reinterpret_cast<Float*>(&q), real);
+    Simd::store(reinterpret_cast<Float*>(&q) + 4, dual);
+}
+
+inline Register normalized(Register q) {
+    return Simd::divide(q, Simd::squareRoot(Simd::sum(Simd::multiply(q, q))));
+}
+
+/* Same as DualQuaternion::normalized(), i.e. division by dual length, which
+   also removes the part of dual part parallel to the real part */
+inline void normalized(Register& real, Register& dual) {
+    const Register length = Simd::squareRoot(Simd::sum(Simd::multiply(real, real)));
+    real = Simd::divide(real, length);
+    dual = Simd::divide(dual, length);
+    dual = Simd::subtract(dual, Simd::multiply(real, Simd::sum(Simd::multiply(real, dual))));
+}
+#else
+inline Quaternion<Float> flipSign(const Quaternion<Float>& q, const Float sign) {
+    return sign < 0.0f ? -q : q;
+}
+#endif
+
+}
+
+void normalize(const Corrade::Containers::ArrayReference<const Quaternion<Float>> in, const Corrade::Containers::ArrayReference<Quaternion<Float>> out) {
+    CORRADE_ASSERT(out.size() == in.size(),
+        "Math::Batch::normalize(): expected output array of size" << in.size() << "but got" << out.size(), );
+
+    for(std::size_t i = 0; i != in.size(); ++i) {
+        #if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+        store(out[i], normalized(load(in[i])));
+        #else
+        out[i] = in[i].normalized();
+        #endif
+    }
+}
+
+void normalize(const Corrade::Containers::ArrayReference<const DualQuaternion<Float>> in, const Corrade::Containers::ArrayReference<DualQuaternion<Float>> out) {
+    CORRADE_ASSERT(out.size() == in.size(),
+        "Math::Batch::normalize(): expected output array of size" << in.size() << "but got" << out.size(), );
+
+    for(std::size_t i = 0; i != in.size(); ++i) {
+        #if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+        Register real = loadReal(in[i]);
+        Register dual = loadDual(in[i]);
+        normalized(real, dual);
+        store(out[i], real, dual);
+        #else
+        out[i] = in[i].normalized();
+        #endif
+    }
+}
+
+void lerpShortestPath(const Corrade::Containers::ArrayReference<const Quaternion<Float>> a, const Corrade::Containers::ArrayReference<const Quaternion<Float>> b, const Float t, const Corrade::Containers::ArrayReference<Quaternion<Float>> out) {
+    CORRADE_ASSERT(b.size() == a.size() && out.size() == a.size(),
+        "Math::Batch::lerpShortestPath(): expected arrays of the same size", );
+
+    #if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+    const Register ta = Simd::broadcast(1.0f - t);
+    const Register tb = Simd::broadcast(t);
+    #endif
+    for(std::size_t i = 0; i != a.size(); ++i) {
+        #if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+        const Register qa = load(a[i]);
+        const Register qb = load(b[i]);
+        const Register sign = Simd::sum(Simd::multiply(qa, qb));
+        store(out[i], normalized(Simd::add(Simd::multiply(ta, qa), Simd::multiply(tb, Simd::flipSign(qb, sign)))));
+        #else
+        const Float sign = Quaternion<Float>::dot(a[i], b[i]);
+        out[i] = ((1.0f - t)*a[i] + t*flipSign(b[i], sign)).normalized();
+        #endif
+    }
+}
+
+void lerpShortestPath(const Corrade::Containers::ArrayReference<const DualQuaternion<Float>> a, const Corrade::Containers::ArrayReference<const DualQuaternion<Float>> b, const Float t, const Corrade::Containers::ArrayReference<DualQuaternion<Float>> out) {
+    CORRADE_ASSERT(b.size() == a.size() && out.size() == a.size(),
+        "Math::Batch::lerpShortestPath(): expected arrays of the same size", );
+
+    #if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+    const Register ta = Simd::broadcast(1.0f - t);
+    const Register tb = Simd::broadcast(t);
+    #endif
+    for(std::size_t i = 0; i != a.size(); ++i) {
+        #if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+        const Register realA = loadReal(a[i]);
+        const Register realB = loadReal(b[i]);
+        const Register weightB = Simd::flipSign(tb, Simd::sum(Simd::multiply(realA, realB)));
+        Register real = Simd::add(Simd::multiply(ta, realA), Simd::multiply(weightB, realB));
+        Register dual = Simd::add(Simd::multiply(ta, loadDual(a[i])), Simd::multiply(weightB, loadDual(b[i])));
+        normalized(real, dual);
+        store(out[i], real, dual);
+        #else
+        const Float weightB = Quaternion<Float>::dot(a[i].real(), b[i].real()) < 0.0f ? -t : t;
+        out[i] = DualQuaternion<Float>((1.0f - t)*a[i].real() + weightB*b[i].real(),
+                                       (1.0f - t)*a[i].dual() + weightB*b[i].dual()).normalized();
+        #endif
+    }
+}
+
+void slerpShortestPath(const Corrade::Containers::ArrayReference<const Quaternion<Float>> a, const Corrade::Containers::ArrayReference<const Quaternion<Float>> b, const Float t, const Corrade::Containers::ArrayReference<Quaternion<Float>> out) {
+    CORRADE_ASSERT(b.size() == a.size() && out.size() == a.size(),
+        "Math::Batch::slerpShortestPath(): expected arrays of the same size", );
+
+    for(std::size_t i = 0; i != a.size(); ++i) {
+        Float cosAngle = Quaternion<Float>::dot(a[i], b[i]);
+        const Float weightB = cosAngle < 0.0f ? -1.0f : 1.0f;
+        cosAngle *= weightB;
+
+        /* Nearly parallel, sin(angle) would be too close to zero */
+        if(cosAngle > 0.9995f) {
+            out[i] = ((1.0f - t)*a[i] + t*weightB*b[i]).normalized();
+            continue;
+        }
+
+        const Float angle = std::acos(cosAngle);
+        const Float sinAngleInverted = 1.0f/std::sin(angle);
+        out[i] = std::sin((1.0f - t)*angle)*sinAngleInverted*a[i] +
+                 std::sin(t*angle)*sinAngleInverted*weightB*b[i];
+    }
+}
+
+void multiply(const Corrade::Containers::ArrayReference<const Quaternion<Float>> a, const Corrade::Containers::ArrayReference<const Quaternion<Float>> b, const Corrade::Containers::ArrayReference<Quaternion<Float>> out) {
+    CORRADE_ASSERT(b.size() == a.size() && out.size() == a.size(),
+        "Math::Batch::multiply(): expected arrays of the same size", );
+
+    for(std::size_t i = 0; i != a.size(); ++i) {
+        #if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+        store(out[i], Simd::multiplyQuaternion(load(a[i]), load(b[i])));
+        #else
+        out[i] = a[i]*b[i];
+        #endif
+    }
+}
+
+void multiply(const Corrade::Containers::ArrayReference<const DualQuaternion<Float>> a, const Corrade::Containers::ArrayReference<const DualQuaternion<Float>> b, const Corrade::Containers::ArrayReference<DualQuaternion<Float>> out) {
+    CORRADE_ASSERT(b.size() == a.size() && out.size() == a.size(),
+        "Math::Batch::multiply(): expected arrays of the same size", );
+
+    for(std::size_t i = 0; i != a.size(); ++i) {
+        #if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+        const Register realA = loadReal(a[i]);
+        const Register realB = loadReal(b[i]);
+        const Register dualA = loadDual(a[i]);
+        const Register dualB = loadDual(b[i]);
+        store(out[i], Simd::multiplyQuaternion(realA, realB),
+            Simd::add(Simd::multiplyQuaternion(realA, dualB), Simd::multiplyQuaternion(dualA, realB)));
+        #else
+        out[i] = a[i]*b[i];
+        #endif
+    }
+}
+
+void toMatrix(const Corrade::Containers::ArrayReference<const Quaternion<Float>> in, const Corrade::Containers::ArrayReference<Matrix<3, Float>> out) {
+    CORRADE_ASSERT(out.size() == in.size(),
+        "Math::Batch::toMatrix(): expected output array of size" << in.size() << "but got" << out.size(), );
+
+    for(std::size_t i = 0; i != in.size(); ++i)
+        out[i] = in[i].toMatrix();
+}
+
+void toMatrix(const Corrade::Containers::ArrayReference<const DualQuaternion<Float>> in, const Corrade::Containers::ArrayReference<Matrix4<Float>> out) {
+    CORRADE_ASSERT(out.size() == in.size(),
+        "Math::Batch::toMatrix(): expected output array of size" << in.size() << "but got" << out.size(), );
+
+    for(std::size_t i = 0; i != in.size(); ++i)
+        out[i] = in[i].toMatrix();
+}
+
+}}}
@@ -0,0 +1,140 @@
+#ifndef Magnum_Math_QuaternionBatch_h
+#define Magnum_Math_QuaternionBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Namespace Magnum::Math::Batch, batch operations on quaternions and dual quaternions
+ */
+
+#include <Containers/Array.h>
+
+#include "Math/DualQuaternion.h"
+
+#include "magnumVisibility.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@brief Batch operations on quaternions and dual quaternions
+
+Versions of @ref Quaternion and @ref DualQuaternion operations working on
+whole arrays, meant for animation blending where thousands of bone
+transformations are processed every frame. Unlike the single-value
+functions these don't check normalization of each input value (it is the
+caller's responsibility), the interpolation functions always take the
+shortest path and everything is compiled as part of the library, operating
+on one quaternion per SSE or NEON register, if available.
+
+All functions operate on @ref Float only and expect that all arrays have the
+same size. The output array may be the same as (one of) the input arrays.
+*/
+namespace Batch {
+
+/**
+@brief Normalize array of quaternions
+
+Equivalent to calling @ref Quaternion::normalized() on each value.
+*/
+void MAGNUM_EXPORT normalize(Corrade::Containers::ArrayReference<const Quaternion<Float>> in, Corrade::Containers::ArrayReference<Quaternion<Float>> out);
+
+/**
+@brief Normalize array of dual quaternions
+
+Equivalent to calling @ref DualQuaternion::normalized() on each value, i.e.
+the result is unit dual quaternion even if the dual part wasn't orthogonal
+to the real part before.
+*/
+void MAGNUM_EXPORT normalize(Corrade::Containers::ArrayReference<const DualQuaternion<Float>> in, Corrade::Containers::ArrayReference<DualQuaternion<Float>> out);
+
+/**
+@brief Shortest-path linear interpolation of arrays of quaternions
+
+Expects that all quaternions are normalized. Equivalent to
+@ref Quaternion::lerp(), except that the second quaternion is negated if
+@f$ q_A \cdot q_B < 0 @f$, so the interpolation follows the shorter arc. @f[
+     q_{LERP} = \frac{(1 - t) q_A + t s q_B}{|(1 - t) q_A + t s q_B|} ~~~~~~~~~~
+     s = sign(q_A \cdot q_B)
+@f]
+@see @ref slerpShortestPath()
+*/
+void MAGNUM_EXPORT lerpShortestPath(Corrade::Containers::ArrayReference<const Quaternion<Float>> a, Corrade::Containers::ArrayReference<const Quaternion<Float>> b, Float t, Corrade::Containers::ArrayReference<Quaternion<Float>> out);
+
+/**
+@brief Shortest-path linear interpolation of arrays of dual quaternions
+
+Expects that all dual quaternions are normalized. Both parts are
+interpolated linearly, with the second dual quaternion negated if dot
+product of real parts is negative, and the result is normalized, which is
+the dual quaternion linear blending @f$ DLB(t) @f$ of two transformations.
+*/
+void MAGNUM_EXPORT lerpShortestPath(Corrade::Containers::ArrayReference<const DualQuaternion<Float>> a, Corrade::Containers::ArrayReference<const DualQuaternion<Float>> b, Float t, Corrade::Containers::ArrayReference<DualQuaternion<Float>> out);
+
+/**
+@brief Shortest-path spherical linear interpolation of arrays of quaternions
+
+Expects that all quaternions are normalized. Equivalent to
+@ref Quaternion::slerp() with the second quaternion negated if
+@f$ q_A \cdot q_B < 0 @f$. If the quaternions are nearly parallel, the
+function falls back to @ref lerpShortestPath() to avoid division by
+@f$ sin \theta @f$ close to zero. The trigonometric functions are evaluated
+with scalar code.
+*/
+void MAGNUM_EXPORT slerpShortestPath(Corrade::Containers::ArrayReference<const Quaternion<Float>> a, Corrade::Containers::ArrayReference<const Quaternion<Float>> b, Float t, Corrade::Containers::ArrayReference<Quaternion<Float>> out);
+
+/**
+@brief Multiply arrays of quaternions
+
+Computes @f$ q_A q_B @f$ for each pair of values.
+*/
+void MAGNUM_EXPORT multiply(Corrade::Containers::ArrayReference<const Quaternion<Float>> a, Corrade::Containers::ArrayReference<const Quaternion<Float>> b, Corrade::Containers::ArrayReference<Quaternion<Float>> out);
+
+/**
+@brief Multiply arrays of dual quaternions
+
+Computes @f$ \hat q_A \hat q_B @f$ for each pair of values, for example to
+concatenate local bone transformations with transformations of their
+parents.
+*/
+void MAGNUM_EXPORT multiply(Corrade::Containers::ArrayReference<const DualQuaternion<Float>> a, Corrade::Containers::ArrayReference<const DualQuaternion<Float>> b, Corrade::Containers::ArrayReference<DualQuaternion<Float>> out);
+
+/**
+@brief Convert array of quaternions to rotation matrices
+
+Equivalent to calling @ref Quaternion::toMatrix() on each value.
+*/
+void MAGNUM_EXPORT toMatrix(Corrade::Containers::ArrayReference<const Quaternion<Float>> in, Corrade::Containers::ArrayReference<Matrix<3, Float>> out);
+
+/**
+@brief Convert array of dual quaternions to transformation matrices
+
+Equivalent to calling @ref DualQuaternion::toMatrix() on each value.
+*/
+void MAGNUM_EXPORT toMatrix(Corrade::Containers::ArrayReference<const DualQuaternion<Float>> in, Corrade::Containers::ArrayReference<Matrix4<Float>> out);
+
+}
+
+}}
+
+#endif
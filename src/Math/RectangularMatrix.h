@@ -650,6 +650,20 @@ template<std::size_t cols, std::size_t rows, class T> auto RectangularMatrix<col
     return out;
 }
 
+#if defined(MAGNUM_MATH_SIMD) && !defined(DOXYGEN_GENERATING_OUTPUT)
+template<> template<> inline RectangularMatrix<4, 4, Float> RectangularMatrix<4, 4, Float>::operator*(const RectangularMatrix<4, 4, Float>& other) const {
+    RectangularMatrix<4, 4, Float> out;
+    Implementation::Simd::multiplyMatrix4(out.data(), data(), other.data());
+    return out;
+}
+
+template<> inline Vector<4, Float> RectangularMatrix<4, 4, Float>::operator*(const Vector<4, Float>& other) const {
+    Vector<4, Float> out;
+    Implementation::Simd::transformVector4(out.data(), data(), other.data());
+    return out;
+}
+#endif
+
 }}
 
 namespace Corrade { namespace Utility {
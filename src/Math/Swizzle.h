@@ -28,6 +28,9 @@
  * @brief Function Magnum::Math::swizzle()
  */
 
+#include <Containers/Array.h>
+#include <Utility/Assert.h>
+
 #include "Vector.h"
 
 namespace Magnum { namespace Math {
@@ -58,6 +61,54 @@ namespace Implementation {
     template<std::size_t size, class T> struct TypeForSize {
         typedef Math::Vector<size, typename T::Type> Type;
     };
+
+    /* Component position for given letter, -1 for zero and -2 for one */
+    constexpr Int componentPosition(char component) {
+        return component == 'x' || component == 'r' ? 0 :
+               component == 'y' || component == 'g' ? 1 :
+               component == 'z' || component == 'b' ? 2 :
+               component == 'w' || component == 'a' ? 3 :
+               component == '0' ? -1 : -2;
+    }
+
+    /* Generic case, no shuffles */
+    template<char ...components, class T, class U> std::size_t swizzleBlocks(std::false_type, const T*, U*, std::size_t) {
+        return 0;
+    }
+
+    /* Four-component vectors of 8- or 32-bit types fitting exactly into
+       sixteen bytes, swizzled using one byte shuffle and one OR for
+       constant ones */
+    template<char ...components, class T, class U> std::size_t swizzleBlocks(std::true_type, const T* const in, U* const out, const std::size_t count) {
+        #ifdef MAGNUM_MATH_SIMD_BYTE_SHUFFLE
+        using namespace Simd;
+
+        typedef typename T::Type Type;
+        constexpr Int positions[]{componentPosition(components)...};
+        const Type one(1);
+        UnsignedByte indices[16], ones[16];
+        for(std::size_t i = 0; i != 16; ++i) {
+            const std::size_t vector = i/sizeof(T)*sizeof(T);
+            const std::size_t byte = i%sizeof(Type);
+            const Int position = positions[i%sizeof(T)/sizeof(Type)];
+            indices[i] = position < 0 ? 0x80 : UnsignedByte(vector + position*sizeof(Type) + byte);
+            ones[i] = position == -2 ? reinterpret_cast<const UnsignedByte*>(&one)[byte] : 0;
+        }
+        const ByteRegister indicesRegister = loadBytes(indices);
+        const ByteRegister onesRegister = loadBytes(ones);
+
+        constexpr std::size_t vectorsPerBlock = 16/sizeof(T);
+        std::size_t i = 0;
+        for(; i + vectorsPerBlock <= count; i += vectorsPerBlock)
+            storeBytes(out + i, orBytes(shuffleBytes(loadBytes(in + i), indicesRegister), onesRegister));
+        return i;
+        #else
+        static_cast<void>(in);
+        static_cast<void>(out);
+        static_cast<void>(count);
+        return 0;
+        #endif
+    }
 }
 
 /**
@@ -83,6 +134,38 @@ template<char ...components, class T> constexpr typename Implementation::TypeFor
     return {Implementation::Component<T::Size, components>::value(vector)...};
 }
 
+/**
+@brief Swizzle components of all vectors in an array
+@param in       Input vectors
+@param out      Output vectors, must have the same size as @p in
+
+Equivalent to calling @ref swizzle(const T&) on each vector, but if both input
+and output are four-component vectors of 8- or 32-bit type (e.g.
+@ref Magnum::Color4ub "Color4ub" or @ref Magnum::Vector4 "Vector4") and the
+target has SSSE3 or NEON instructions enabled (e.g. `-mssse3` or
+`-mfpu=neon`), whole sixteen-byte blocks are swizzled using single byte
+shuffle. The input and output can be the same array. Example:
+@code
+std::vector<Color4ub> pixels;
+Math::swizzle<'b', 'g', 'r', 'a'>(Containers::ArrayReference<const Color4ub>{pixels.data(), pixels.size()}, {pixels.data(), pixels.size()});
+@endcode
+
+Note that the single-vector variant is `constexpr`, thus it can't use any SIMD
+intrinsics, but compilers usually turn it into one shuffle for
+four-component float vectors.
+*/
+template<char ...components, class T> void swizzle(Corrade::Containers::ArrayReference<const T> in, Corrade::Containers::ArrayReference<typename Implementation::TypeForSize<sizeof...(components), T>::Type> out) {
+    typedef typename Implementation::TypeForSize<sizeof...(components), T>::Type U;
+    CORRADE_ASSERT(in.size() == out.size(),
+        "Math::swizzle(): expected arrays of the same size", );
+
+    std::size_t i = Implementation::swizzleBlocks<components...>(std::integral_constant<bool,
+        T::Size == 4 && U::Size == 4 && sizeof(T) == sizeof(U) && (sizeof(T) == 4 || sizeof(T) == 16)>{},
+        in.data(), out.data(), in.size());
+
+    for(; i != in.size(); ++i) out[i] = swizzle<components...>(in[i]);
+}
+
 }}
 
 #endif
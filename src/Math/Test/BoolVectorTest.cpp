@@ -23,6 +23,7 @@
 */
 
 #include <sstream>
+#include <vector>
 #include <TestSuite/Tester.h>
 
 #include "Math/BoolVector.h"
@@ -49,6 +50,14 @@ class BoolVectorTest: public Corrade::TestSuite::Tester {
         void bitInverse();
         void bitAndOrXor();
 
+        void count();
+        void countArray();
+        void firstNextSet();
+        void firstNextSetLong();
+        void forEachSet();
+        void bitAndOrXorArray();
+        void bitAndOrXorArrayInvalid();
+
         void debug();
 };
 
@@ -75,6 +84,14 @@ BoolVectorTest::BoolVectorTest() {
               &BoolVectorTest::bitInverse,
               &BoolVectorTest::bitAndOrXor,
 
+              &BoolVectorTest::count,
+              &BoolVectorTest::countArray,
+              &BoolVectorTest::firstNextSet,
+              &BoolVectorTest::firstNextSetLong,
+              &BoolVectorTest::forEachSet,
+              &BoolVectorTest::bitAndOrXorArray,
+              &BoolVectorTest::bitAndOrXorArrayInvalid,
+
               &BoolVectorTest::debug});
 }
 
@@ -206,6 +223,110 @@ void BoolVectorTest::bitAndOrXor() {
     CORRADE_COMPARE(a ^ b, BoolVector19(0x92, 0xac, 0x05));
 }
 
+void BoolVectorTest::count() {
+    CORRADE_COMPARE(BoolVector19().count(), 0);
+    CORRADE_COMPARE(BoolVector19(0xa5, 0x5f, 0x03).count(), 12);
+
+    /* Unused bits are ignored */
+    CORRADE_COMPARE(BoolVector19(0xff, 0xff, 0xff).count(), 19);
+
+    /* More than eight segments */
+    Math::BoolVector<200> a;
+    a.set(0, true).set(63, true).set(64, true).set(150, true).set(199, true);
+    CORRADE_COMPARE(a.count(), 5);
+    CORRADE_COMPARE(Math::BoolVector<200>(true).count(), 200);
+}
+
+void BoolVectorTest::countArray() {
+    const BoolVector19 a[]{{0xa5, 0x5f, 0xff}, {0xff, 0x01, 0x00}, {0x00, 0x00, 0x04}};
+    CORRADE_COMPARE(Math::count<19>(a), 13 + 9 + 1);
+
+    /* Size divisible by eight, counted as a whole */
+    const Math::BoolVector<16> b[]{{0xa5, 0x5f}, {0xff, 0x01}, {0x00, 0x00},
+                                   {0x01, 0x80}, {0xff, 0xff}};
+    CORRADE_COMPARE(Math::count<16>(b), 10 + 9 + 0 + 2 + 16);
+    CORRADE_COMPARE(Math::count<16>(nullptr), 0);
+}
+
+void BoolVectorTest::firstNextSet() {
+    const BoolVector19 a(0x00, 0x21, 0x04);
+    CORRADE_COMPARE(a.firstSet(), 8);
+    CORRADE_COMPARE(a.nextSet(8), 13);
+    CORRADE_COMPARE(a.nextSet(13), 18);
+    CORRADE_COMPARE(a.nextSet(18), 19);
+
+    /* Unused bits are ignored */
+    CORRADE_COMPARE(BoolVector19(0x00, 0x00, 0xf8).firstSet(), 19);
+    CORRADE_COMPARE(BoolVector19().firstSet(), 19);
+}
+
+void BoolVectorTest::firstNextSetLong() {
+    /* Skipping over eight empty segments at once */
+    Math::BoolVector<200> a;
+    a.set(3, true).set(64, true).set(65, true).set(191, true).set(199, true);
+
+    std::vector<std::size_t> positions;
+    for(std::size_t i = a.firstSet(); i != a.Size; i = a.nextSet(i))
+        positions.push_back(i);
+    CORRADE_COMPARE(positions, (std::vector<std::size_t>{3, 64, 65, 191, 199}));
+
+    /* Skipping up to the end shouldn't read past the data */
+    CORRADE_COMPARE(Math::BoolVector<72>().firstSet(), 72);
+    CORRADE_COMPARE(Math::BoolVector<200>().firstSet(), 200);
+    CORRADE_COMPARE(Math::BoolVector<72>().set(71, true).firstSet(), 71);
+    CORRADE_COMPARE(Math::BoolVector<200>().set(199, true).firstSet(), 199);
+    CORRADE_COMPARE(Math::BoolVector<200>().set(199, true).nextSet(199), 200);
+}
+
+void BoolVectorTest::forEachSet() {
+    std::vector<std::size_t> positions;
+    BoolVector19(0x81, 0x00, 0xfc).forEachSet([&positions](std::size_t i) { positions.push_back(i); });
+    CORRADE_COMPARE(positions, (std::vector<std::size_t>{0, 7, 18}));
+
+    Math::BoolVector<200> a;
+    a.set(3, true).set(64, true).set(65, true).set(191, true).set(199, true);
+    positions.clear();
+    a.forEachSet([&positions](std::size_t i) { positions.push_back(i); });
+    CORRADE_COMPARE(positions, (std::vector<std::size_t>{3, 64, 65, 191, 199}));
+}
+
+void BoolVectorTest::bitAndOrXorArray() {
+    /* Seven vectors, 21 bytes, so both the word and the byte loop are used */
+    const BoolVector19 a[]{
+        {0xa5, 0x5f, 0x03}, {0x00, 0xff, 0x01}, {0x12, 0x34, 0x56},
+        {0xff, 0xff, 0xff}, {0x0f, 0xf0, 0x00}, {0x81, 0x18, 0x07},
+        {0xa5, 0x5f, 0x03}};
+    const BoolVector19 b[]{
+        {0x37, 0xf3, 0x06}, {0xff, 0x0f, 0x00}, {0x65, 0x43, 0x21},
+        {0x00, 0x00, 0x00}, {0x3c, 0x3c, 0x07}, {0x18, 0x81, 0x02},
+        {0x37, 0xf3, 0x06}};
+
+    BoolVector19 and_[7], or_[7], xor_[7];
+    Math::bitwiseAnd<19>(a, b, and_);
+    Math::bitwiseOr<19>(a, b, or_);
+    Math::bitwiseXor<19>(a, b, xor_);
+    for(std::size_t i = 0; i != 7; ++i) {
+        CORRADE_COMPARE(and_[i], a[i] & b[i]);
+        CORRADE_COMPARE(or_[i], a[i] | b[i]);
+        CORRADE_COMPARE(xor_[i], a[i] ^ b[i]);
+    }
+
+    /* In-place */
+    Math::bitwiseXor<19>(xor_, b, xor_);
+    for(std::size_t i = 0; i != 7; ++i)
+        CORRADE_COMPARE(xor_[i], a[i]);
+}
+
+void BoolVectorTest::bitAndOrXorArrayInvalid() {
+    std::ostringstream o;
+    Corrade::Utility::Error::setOutput(&o);
+
+    const BoolVector19 a[3]{};
+    BoolVector19 out[2];
+    Math::bitwiseOr<19>(a, a, out);
+    CORRADE_COMPARE(o.str(), "Math::bitwiseOr(): expected arrays of the same size\n");
+}
+
 void BoolVectorTest::debug() {
     std::ostringstream o;
 
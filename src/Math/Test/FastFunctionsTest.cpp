@@ -0,0 +1,238 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <chrono>
+#include <sstream>
+#include <vector>
+#include <TestSuite/Tester.h>
+
+#include "Math/FastFunctions.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+class FastFunctionsTest: public Corrade::TestSuite::Tester {
+    public:
+        FastFunctionsTest();
+
+        void sincos();
+        void sinCos();
+        void atan2();
+        void sqrtInverted();
+        void sqrt();
+        void exp();
+
+        void batch();
+        void batchInvalid();
+        void benchmark();
+};
+
+typedef Math::Deg<Float> Deg;
+typedef Math::Rad<Float> Rad;
+
+FastFunctionsTest::FastFunctionsTest() {
+    addTests({&FastFunctionsTest::sincos,
+              &FastFunctionsTest::sinCos,
+              &FastFunctionsTest::atan2,
+              &FastFunctionsTest::sqrtInverted,
+              &FastFunctionsTest::sqrt,
+              &FastFunctionsTest::exp,
+
+              &FastFunctionsTest::batch,
+              &FastFunctionsTest::batchInvalid,
+              &FastFunctionsTest::benchmark});
+}
+
+void FastFunctionsTest::sincos() {
+    /* Compare with double-precision std:: functions over the whole range
+       where the precision is guaranteed */
+    double maxSinError = 0.0, maxCosError = 0.0;
+    for(std::size_t i = 0; i <= 1000000; ++i) {
+        const Float angle = -8192.0f + 16384.0f*i/1000000.0f;
+        const std::pair<Float, Float> sincos = Fast::sincos(Rad(angle));
+        maxSinError = std::max(maxSinError, std::abs(sincos.first - std::sin(double(angle))));
+        maxCosError = std::max(maxCosError, std::abs(sincos.second - std::cos(double(angle))));
+    }
+    CORRADE_VERIFY(maxSinError < 1.0e-7);
+    CORRADE_VERIFY(maxCosError < 1.0e-7);
+
+    /* Quadrant boundaries */
+    CORRADE_COMPARE(Fast::sincos(Deg(0.0f)).first, 0.0f);
+    CORRADE_COMPARE(Fast::sincos(Deg(0.0f)).second, 1.0f);
+    CORRADE_COMPARE(Fast::sincos(Deg(90.0f)).first, 1.0f);
+    CORRADE_COMPARE(Fast::sincos(Deg(90.0f)).second, 0.0f);
+    CORRADE_COMPARE(Fast::sincos(Deg(180.0f)).first, 0.0f);
+    CORRADE_COMPARE(Fast::sincos(Deg(180.0f)).second, -1.0f);
+    CORRADE_COMPARE(Fast::sincos(Deg(-90.0f)).first, -1.0f);
+    CORRADE_COMPARE(Fast::sincos(Deg(-90.0f)).second, 0.0f);
+}
+
+void FastFunctionsTest::sinCos() {
+    CORRADE_COMPARE(Fast::sin(Deg(30.0f)), 0.5f);
+    CORRADE_COMPARE(Fast::sin(Rad(Constants<Float>::pi()/6)), 0.5f);
+    CORRADE_COMPARE(Fast::cos(Deg(60.0f)), 0.5f);
+    CORRADE_COMPARE(Fast::cos(Rad(Constants<Float>::pi()/3)), 0.5f);
+}
+
+void FastFunctionsTest::atan2() {
+    double maxError = 0.0;
+    for(std::size_t i = 0; i != 2000; ++i) for(std::size_t j = 0; j != 200; ++j) {
+        const double angle = i*2*3.141592653589793/2000;
+        const Float radius = 0.001f + j*0.5f;
+        const Float x = radius*Float(std::cos(angle));
+        const Float y = radius*Float(std::sin(angle));
+        maxError = std::max(maxError, std::abs(Float(Fast::atan2(y, x)) - std::atan2(double(y), double(x))));
+    }
+    CORRADE_VERIFY(maxError < 3.0e-7);
+
+    CORRADE_COMPARE(Fast::atan2(1.0f, 1.0f), Rad(Deg(45.0f)));
+    CORRADE_COMPARE(Fast::atan2(-1.0f, 0.0f), Rad(Deg(-90.0f)));
+    CORRADE_COMPARE(Fast::atan2(0.0f, -1.0f), Rad(Deg(180.0f)));
+    CORRADE_COMPARE(Fast::atan2(0.0f, 0.0f), Rad(0.0f));
+}
+
+void FastFunctionsTest::sqrtInverted() {
+    /* Relative error over whole range of normalized floats */
+    double maxError = 0.0;
+    for(Int i = -370; i <= 380; ++i) for(std::size_t j = 0; j != 100; ++j) {
+        const Float value = std::pow(10.0f, i/10.0f)*(1.0f + j/100.0f);
+        maxError = std::max(maxError, std::abs(Fast::sqrtInverted(value)*std::sqrt(double(value)) - 1.0));
+    }
+    CORRADE_VERIFY(maxError < 5.0e-6);
+
+    CORRADE_COMPARE(Fast::sqrtInverted(16.0f), 0.25f);
+}
+
+void FastFunctionsTest::sqrt() {
+    double maxError = 0.0;
+    for(Int i = -370; i <= 380; ++i) for(std::size_t j = 0; j != 100; ++j) {
+        const Float value = std::pow(10.0f, i/10.0f)*(1.0f + j/100.0f);
+        maxError = std::max(maxError, std::abs(Fast::sqrt(value)/std::sqrt(double(value)) - 1.0));
+    }
+    CORRADE_VERIFY(maxError < 5.0e-6);
+
+    CORRADE_COMPARE(Fast::sqrt(16.0f), 4.0f);
+    CORRADE_COMPARE(Fast::sqrt(0.0f), 0.0f);
+}
+
+void FastFunctionsTest::exp() {
+    double maxError = 0.0;
+    for(std::size_t i = 0; i <= 1000000; ++i) {
+        const Float value = -87.0f + 175.0f*i/1000000.0f;
+        maxError = std::max(maxError, std::abs(Fast::exp(value)/std::exp(double(value)) - 1.0));
+    }
+    CORRADE_VERIFY(maxError < 2.0e-7);
+
+    CORRADE_COMPARE(Fast::exp(0.0f), 1.0f);
+    CORRADE_COMPARE(Fast::exp(1.0f), 2.718281828f);
+
+    /* Out-of-range values are clamped */
+    CORRADE_VERIFY(Fast::exp(1000.0f) > 1.0e38f);
+    CORRADE_VERIFY(Fast::exp(1000.0f) < std::numeric_limits<Float>::infinity());
+    CORRADE_VERIFY(Fast::exp(-1000.0f) > 0.0f);
+    CORRADE_VERIFY(Fast::exp(-1000.0f) < 1.2e-38f);
+}
+
+void FastFunctionsTest::batch() {
+    const Float values[] = {0.0f, 0.5f, 1.0f, 3.7f, 17.5f, 1000.0f, 0.001f};
+    const Float negative[] = {0.0f, -0.5f, 1.0f, -3.7f, -17.5f, 1000.0f, -0.001f};
+    Float out[7], out2[7];
+
+    Fast::sincos(values, out, out2);
+    for(std::size_t i = 0; i != 7; ++i) {
+        CORRADE_COMPARE(out[i], Fast::sin(Rad(values[i])));
+        CORRADE_COMPARE(out2[i], Fast::cos(Rad(values[i])));
+    }
+
+    Fast::sin(negative, out);
+    for(std::size_t i = 0; i != 7; ++i)
+        CORRADE_COMPARE(out[i], Fast::sin(Rad(negative[i])));
+
+    Fast::cos(negative, out);
+    for(std::size_t i = 0; i != 7; ++i)
+        CORRADE_COMPARE(out[i], Fast::cos(Rad(negative[i])));
+
+    Fast::atan2(negative, values, out);
+    for(std::size_t i = 0; i != 7; ++i)
+        CORRADE_COMPARE(out[i], Float(Fast::atan2(negative[i], values[i])));
+
+    Fast::sqrtInverted(values, out);
+    for(std::size_t i = 0; i != 7; ++i)
+        CORRADE_COMPARE(out[i], Fast::sqrtInverted(values[i]));
+
+    Fast::sqrt(values, out);
+    for(std::size_t i = 0; i != 7; ++i)
+        CORRADE_COMPARE(out[i], Fast::sqrt(values[i]));
+
+    Fast::exp(negative, out);
+    for(std::size_t i = 0; i != 7; ++i)
+        CORRADE_COMPARE(out[i], Fast::exp(negative[i]));
+}
+
+void FastFunctionsTest::batchInvalid() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    const Float values[3]{};
+    Float result[2];
+    Fast::sin(values, result);
+    Fast::atan2(values, result, result);
+    Fast::sincos(values, result, result);
+
+    CORRADE_COMPARE(out.str(),
+        "Math::Fast::sin(): expected output array of size 3 but got 2\n"
+        "Math::Fast::atan2(): expected arrays of the same size\n"
+        "Math::Fast::sincos(): expected output arrays of the same size as input\n");
+}
+
+void FastFunctionsTest::benchmark() {
+    std::vector<Float> angles(1 << 20);
+    for(std::size_t i = 0; i != angles.size(); ++i)
+        angles[i] = -100.0f + 200.0f*i/angles.size();
+    std::vector<Float> sines(angles.size()), cosines(angles.size());
+    std::vector<Float> fastSines(angles.size()), fastCosines(angles.size());
+
+    const auto begin = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i != angles.size(); ++i) {
+        sines[i] = std::sin(angles[i]);
+        cosines[i] = std::cos(angles[i]);
+    }
+    const auto middle = std::chrono::steady_clock::now();
+    Fast::sincos({angles.data(), angles.size()}, {fastSines.data(), fastSines.size()}, {fastCosines.data(), fastCosines.size()});
+    const auto end = std::chrono::steady_clock::now();
+
+    for(std::size_t i = 0; i != angles.size(); ++i) {
+        CORRADE_VERIFY(std::abs(sines[i] - fastSines[i]) < 1.0e-6f);
+        CORRADE_VERIFY(std::abs(cosines[i] - fastCosines[i]) < 1.0e-6f);
+    }
+
+    typedef std::chrono::duration<double, std::nano> Nanoseconds;
+    Debug() << "Sine and cosine of" << angles.size() << "values, std:"
+            << std::chrono::duration_cast<Nanoseconds>(middle - begin).count()/angles.size()
+            << "ns, fast batch:" << std::chrono::duration_cast<Nanoseconds>(end - middle).count()/angles.size() << "ns";
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::FastFunctionsTest)
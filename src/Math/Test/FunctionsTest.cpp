@@ -60,6 +60,10 @@ class FunctionsTest: public Corrade::TestSuite::Tester {
 
         void normalizeTypeDeduction();
 
+        void packHalf();
+        void unpackHalf();
+        void repackHalf();
+
         void pow();
         void log();
         void log2();
@@ -103,6 +107,10 @@ FunctionsTest::FunctionsTest() {
 
               &FunctionsTest::normalizeTypeDeduction,
 
+              &FunctionsTest::packHalf,
+              &FunctionsTest::unpackHalf,
+              &FunctionsTest::repackHalf,
+
               &FunctionsTest::pow,
               &FunctionsTest::log,
               &FunctionsTest::log2,
@@ -372,6 +380,49 @@ void FunctionsTest::normalizeTypeDeduction() {
     CORRADE_COMPARE((Math::normalize<Float, Byte>('\x7F')), 1.0f);
 }
 
+void FunctionsTest::packHalf() {
+    CORRADE_COMPARE(Math::packHalf(0.0f), 0x0000);
+    CORRADE_COMPARE(Math::packHalf(-0.0f), 0x8000);
+    CORRADE_COMPARE(Math::packHalf(1.0f), 0x3c00);
+    CORRADE_COMPARE(Math::packHalf(-2.0f), 0xc000);
+    CORRADE_COMPARE(Math::packHalf(0.333333f), 0x3555);
+    CORRADE_COMPARE(Math::packHalf(65504.0f), 0x7bff);
+
+    /* Rounding to nearest, ties to even */
+    CORRADE_COMPARE(Math::packHalf(1.0f + 1.0f/2048.0f), 0x3c00);
+    CORRADE_COMPARE(Math::packHalf(1.0f + 3.0f/2048.0f), 0x3c02);
+    CORRADE_COMPARE(Math::packHalf(65519.0f), 0x7bff);
+
+    /* Denormals */
+    CORRADE_COMPARE(Math::packHalf(5.9604645e-8f), 0x0001);
+    CORRADE_COMPARE(Math::packHalf(6.0975552e-5f), 0x03ff);
+    CORRADE_COMPARE(Math::packHalf(1.0e-8f), 0x0000);
+
+    /* Overflow, infinity and NaN */
+    CORRADE_COMPARE(Math::packHalf(65520.0f), 0x7c00);
+    CORRADE_COMPARE(Math::packHalf(1.0e10f), 0x7c00);
+    CORRADE_COMPARE(Math::packHalf(-std::numeric_limits<Float>::infinity()), 0xfc00);
+    CORRADE_COMPARE(Math::packHalf(std::numeric_limits<Float>::quiet_NaN()) & 0x7e00, 0x7e00);
+}
+
+void FunctionsTest::unpackHalf() {
+    CORRADE_COMPARE(Math::unpackHalf(0x0000), 0.0f);
+    CORRADE_COMPARE(Math::unpackHalf(0x3c00), 1.0f);
+    CORRADE_COMPARE(Math::unpackHalf(0xc000), -2.0f);
+    CORRADE_COMPARE(Math::unpackHalf(0x7bff), 65504.0f);
+    CORRADE_COMPARE(Math::unpackHalf(0x0001), 5.9604645e-8f);
+    CORRADE_COMPARE(Math::unpackHalf(0x7c00), std::numeric_limits<Float>::infinity());
+    CORRADE_VERIFY(std::isnan(Math::unpackHalf(0x7e00)));
+}
+
+void FunctionsTest::repackHalf() {
+    /* All non-NaN values survive the roundtrip unchanged */
+    for(UnsignedInt i = 0; i != 0x10000; ++i) {
+        if((i & 0x7c00) == 0x7c00 && (i & 0x03ff)) continue;
+        CORRADE_COMPARE(Math::packHalf(Math::unpackHalf(i)), i);
+    }
+}
+
 void FunctionsTest::pow() {
     CORRADE_COMPARE(Math::pow<10>(2ul), 1024ul);
     CORRADE_COMPARE(Math::pow<0>(3ul), 1ul);
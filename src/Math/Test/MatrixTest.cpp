@@ -22,6 +22,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <chrono>
 #include <sstream>
 #include <TestSuite/Tester.h>
 #include <Utility/Configuration.h>
@@ -72,7 +73,11 @@ class MatrixTest: public Corrade::TestSuite::Tester {
         void trace();
         void ij();
         void determinant();
+        void determinantClosedForm();
+        void determinantLu();
         void inverted();
+        void invertedClosedForm();
+        void invertedLu();
         void invertedOrthogonal();
 
         void subclassTypes();
@@ -80,6 +85,8 @@ class MatrixTest: public Corrade::TestSuite::Tester {
 
         void debug();
         void configuration();
+
+        void invertedBenchmark();
 };
 
 typedef Matrix<4, Float> Matrix4x4;
@@ -104,14 +111,20 @@ MatrixTest::MatrixTest() {
               &MatrixTest::trace,
               &MatrixTest::ij,
               &MatrixTest::determinant,
+              &MatrixTest::determinantClosedForm,
+              &MatrixTest::determinantLu,
               &MatrixTest::inverted,
+              &MatrixTest::invertedClosedForm,
+              &MatrixTest::invertedLu,
               &MatrixTest::invertedOrthogonal,
 
               &MatrixTest::subclassTypes,
               &MatrixTest::subclass,
 
               &MatrixTest::debug,
-              &MatrixTest::configuration});
+              &MatrixTest::configuration,
+
+              &MatrixTest::invertedBenchmark});
 }
 
 void MatrixTest::construct() {
@@ -255,6 +268,43 @@ void MatrixTest::determinant() {
     CORRADE_COMPARE(m.determinant(), -2);
 }
 
+void MatrixTest::determinantClosedForm() {
+    Matrix3x3 a(Vector3(3.0f, 5.0f, 8.0f),
+                Vector3(4.0f, 4.0f, 7.0f),
+                Vector3(7.0f, -1.0f, 8.0f));
+    CORRADE_COMPARE(a.determinant(), -54.0f);
+
+    Matrix4x4 b(Vector4(3.0f,  5.0f, 8.0f, 4.0f),
+                Vector4(4.0f,  4.0f, 7.0f, 3.0f),
+                Vector4(7.0f, -1.0f, 8.0f, 0.0f),
+                Vector4(9.0f,  4.0f, 5.0f, 9.0f));
+    CORRADE_COMPARE(b.determinant(), -412.0f);
+
+    /* Integral types use the closed form too */
+    Matrix4x4i c(Vector4i(3,  5, 8, 4),
+                 Vector4i(4,  4, 7, 3),
+                 Vector4i(7, -1, 8, 0),
+                 Vector4i(9,  4, 5, 9));
+    CORRADE_COMPARE(c.determinant(), -412);
+}
+
+void MatrixTest::determinantLu() {
+    /* Same as in determinant(), but floating-point */
+    Matrix<5, Float> m(
+        Vector<5, Float>(1.0f, 2.0f, 2.0f, 1.0f,  0.0f),
+        Vector<5, Float>(2.0f, 3.0f, 2.0f, 1.0f, -2.0f),
+        Vector<5, Float>(1.0f, 1.0f, 1.0f, 1.0f,  0.0f),
+        Vector<5, Float>(2.0f, 0.0f, 0.0f, 1.0f,  2.0f),
+        Vector<5, Float>(3.0f, 1.0f, 0.0f, 1.0f, -2.0f)
+    );
+    CORRADE_COMPARE(m.determinant(), -2.0f);
+
+    /* Singular matrix */
+    Matrix<5, Float> singular(m);
+    singular[3] = singular[0]*2.0f;
+    CORRADE_COMPARE(singular.determinant(), 0.0f);
+}
+
 void MatrixTest::inverted() {
     Matrix4x4 m(Vector4(3.0f,  5.0f, 8.0f, 4.0f),
                 Vector4(4.0f,  4.0f, 7.0f, 3.0f),
@@ -272,6 +322,54 @@ void MatrixTest::inverted() {
     CORRADE_COMPARE(_inverse*m, Matrix4x4());
 }
 
+void MatrixTest::invertedClosedForm() {
+    Matrix3x3 a(Vector3(3.0f, 5.0f, 8.0f),
+                Vector3(4.0f, 4.0f, 7.0f),
+                Vector3(7.0f, -1.0f, 8.0f));
+    CORRADE_COMPARE(a.inverted()*a, Matrix3x3());
+    CORRADE_COMPARE(a*a.inverted(), Matrix3x3());
+
+    Matrix<2, Float> b(Vector<2, Float>(3.0f, 5.0f),
+                       Vector<2, Float>(4.0f, 4.0f));
+    CORRADE_COMPARE(b.inverted(), (Matrix<2, Float>(Vector<2, Float>(-0.5f, 0.625f),
+                                                    Vector<2, Float>(0.5f, -0.375f))));
+
+    CORRADE_COMPARE((Matrix<1, Float>(Vector<1, Float>(4.0f)).inverted()),
+                    (Matrix<1, Float>(Vector<1, Float>(0.25f))));
+
+    /* Double precision goes through the scalar path even if the Float one is SSE */
+    Matrix<4, double> c(Vector<4, double>(3.0,  5.0, 8.0, 4.0),
+                        Vector<4, double>(4.0,  4.0, 7.0, 3.0),
+                        Vector<4, double>(7.0, -1.0, 8.0, 0.0),
+                        Vector<4, double>(9.0,  4.0, 5.0, 9.0));
+    Matrix<4, double> inverse(Vector<4, double>(-60/103.0,   71/103.0,  -4/103.0,  3/103.0),
+                              Vector<4, double>(-66/103.0,  109/103.0, -25/103.0, -7/103.0),
+                              Vector<4, double>(177/412.0,  -97/206.0,  53/412.0, -7/206.0),
+                              Vector<4, double>(259/412.0, -185/206.0,  31/412.0, 27/206.0));
+    CORRADE_COMPARE(c.inverted(), inverse);
+}
+
+void MatrixTest::invertedLu() {
+    /* Needs pivoting, m[0][0] is zero */
+    Matrix<5, double> m(
+        Vector<5, double>(0.0, 2.0, 2.0, 1.0,  0.0),
+        Vector<5, double>(2.0, 3.0, 2.0, 1.0, -2.0),
+        Vector<5, double>(1.0, 1.0, 1.0, 1.0,  0.0),
+        Vector<5, double>(2.0, 0.0, 0.0, 1.0,  2.0),
+        Vector<5, double>(3.0, 1.0, 0.0, 1.0, -2.0)
+    );
+    Matrix<5, double> inverse(
+        Vector<5, double>(-2.0,  1.0,  2.0,  0.0, -1.0),
+        Vector<5, double>( 4.0, -1.0, -6.0,  1.0,  2.0),
+        Vector<5, double>(-5.0,  2.0,  7.0, -1.0, -3.0),
+        Vector<5, double>( 3.0, -2.0, -2.0,  0.0,  2.0),
+        Vector<5, double>( 0.5,  0.0, -1.0,  0.5,  0.0)
+    );
+
+    CORRADE_COMPARE(m.inverted(), inverse);
+    CORRADE_COMPARE(m.inverted()*m, (Matrix<5, double>()));
+}
+
 void MatrixTest::invertedOrthogonal() {
     std::ostringstream o;
     Error::setOutput(&o);
@@ -380,6 +478,79 @@ void MatrixTest::configuration() {
     CORRADE_COMPARE(c.value<Matrix4x4>("matrix"), m);
 }
 
+namespace {
+    /* The original implementation, cofactor expansion all the way down */
+    template<std::size_t size> Float laplaceDeterminant(const Matrix<size, Float>& m) {
+        Float out(0);
+        for(std::size_t col = 0; col != size; ++col)
+            out += ((col & 1) ? -1 : 1)*m[col][0]*laplaceDeterminant(m.ij(col, 0));
+        return out;
+    }
+
+    template<> Float laplaceDeterminant(const Matrix<2, Float>& m) {
+        return m[0][0]*m[1][1] - m[1][0]*m[0][1];
+    }
+
+    template<std::size_t size> Matrix<size, Float> laplaceInverted(const Matrix<size, Float>& m) {
+        Matrix<size, Float> out(Matrix<size, Float>::Zero);
+        const Float determinant = laplaceDeterminant(m);
+        for(std::size_t col = 0; col != size; ++col)
+            for(std::size_t row = 0; row != size; ++row)
+                out[col][row] = (((row+col) & 1) ? -1 : 1)*laplaceDeterminant(m.ij(row, col))/determinant;
+        return out;
+    }
+
+    template<std::size_t size, class F> double benchmark(const Matrix<size, Float>& m, F f) {
+        constexpr std::size_t iterations = 100000;
+
+        /* Accumulate the results so the loop doesn't get optimized out */
+        Matrix<size, Float> accumulated(Matrix<size, Float>::Zero);
+        Matrix<size, Float> current = m;
+        const auto begin = std::chrono::steady_clock::now();
+        for(std::size_t i = 0; i != iterations; ++i) {
+            current[0][0] = m[0][0] + (i & 1);
+            accumulated += f(current);
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        volatile Float sink = accumulated[0][0];
+        static_cast<void>(sink);
+        return std::chrono::duration_cast<std::chrono::duration<double, std::nano>>(end - begin).count()/iterations;
+    }
+}
+
+void MatrixTest::invertedBenchmark() {
+    Matrix3x3 a(Vector3(3.0f, 5.0f, 8.0f),
+                Vector3(4.0f, 4.0f, 7.0f),
+                Vector3(7.0f, -1.0f, 8.0f));
+    Matrix4x4 b(Vector4(3.0f,  5.0f, 8.0f, 4.0f),
+                Vector4(4.0f,  4.0f, 7.0f, 3.0f),
+                Vector4(7.0f, -1.0f, 8.0f, 0.0f),
+                Vector4(9.0f,  4.0f, 5.0f, 9.0f));
+    Matrix<5, Float> c(
+        Vector<5, Float>(1.0f, 2.0f, 2.0f, 1.0f,  0.0f),
+        Vector<5, Float>(2.0f, 3.0f, 2.0f, 1.0f, -2.0f),
+        Vector<5, Float>(1.0f, 1.0f, 1.0f, 1.0f,  0.0f),
+        Vector<5, Float>(2.0f, 0.0f, 0.0f, 1.0f,  2.0f),
+        Vector<5, Float>(3.0f, 1.0f, 0.0f, 1.0f, -2.0f));
+
+    /* Both should give the same results */
+    CORRADE_COMPARE(a.inverted(), laplaceInverted(a));
+    CORRADE_COMPARE(b.inverted(), laplaceInverted(b));
+    CORRADE_COMPARE(c.inverted(), laplaceInverted(c));
+
+    const double a1 = benchmark(a, laplaceInverted<3>);
+    const double a2 = benchmark(a, [](const Matrix3x3& m) { return m.inverted(); });
+    const double b1 = benchmark(b, laplaceInverted<4>);
+    const double b2 = benchmark(b, [](const Matrix4x4& m) { return m.inverted(); });
+    const double c1 = benchmark(c, laplaceInverted<5>);
+    const double c2 = benchmark(c, [](const Matrix<5, Float>& m) { return m.inverted(); });
+
+    Debug() << "3x3 inverse, cofactor expansion:" << a1 << "ns, closed form:" << a2 << "ns";
+    Debug() << "4x4 inverse, cofactor expansion:" << b1 << "ns, closed form:" << b2 << "ns";
+    Debug() << "5x5 inverse, cofactor expansion:" << c1 << "ns, LU decomposition:" << c2 << "ns";
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::MatrixTest)
@@ -0,0 +1,263 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <sstream>
+#include <TestSuite/Tester.h>
+
+#include "Math/QuaternionBatch.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+class QuaternionBatchTest: public Corrade::TestSuite::Tester {
+    public:
+        QuaternionBatchTest();
+
+        void normalize();
+        void normalizeDual();
+        void lerpShortestPath();
+        void lerpShortestPathDual();
+        void slerpShortestPath();
+        void slerpShortestPathParallel();
+        void multiply();
+        void multiplyDual();
+        void toMatrix();
+        void toMatrixDual();
+
+        void inPlace();
+        void invalid();
+};
+
+typedef Math::Deg<Float> Deg;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Matrix<3, Float> Matrix3x3;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Quaternion<Float> Quaternion;
+typedef Math::DualQuaternion<Float> DualQuaternion;
+
+QuaternionBatchTest::QuaternionBatchTest() {
+    addTests({&QuaternionBatchTest::normalize,
+              &QuaternionBatchTest::normalizeDual,
+              &QuaternionBatchTest::lerpShortestPath,
+              &QuaternionBatchTest::lerpShortestPathDual,
+              &QuaternionBatchTest::slerpShortestPath,
+              &QuaternionBatchTest::slerpShortestPathParallel,
+              &QuaternionBatchTest::multiply,
+              &QuaternionBatchTest::multiplyDual,
+              &QuaternionBatchTest::toMatrix,
+              &QuaternionBatchTest::toMatrixDual,
+
+              &QuaternionBatchTest::inPlace,
+              &QuaternionBatchTest::invalid});
+}
+
+namespace {
+    const Quaternion a[] = {
+        Quaternion::rotation(Deg(35.0f), Vector3::xAxis()),
+        Quaternion::rotation(Deg(-120.0f), Vector3(1.0f, 2.0f, -3.0f).normalized()),
+        Quaternion::rotation(Deg(270.0f), Vector3::zAxis())
+    };
+
+    const Quaternion b[] = {
+        Quaternion::rotation(Deg(75.0f), Vector3::yAxis()),
+        -Quaternion::rotation(Deg(10.0f), Vector3(-3.0f, 0.5f, 1.0f).normalized()),
+        Quaternion::rotation(Deg(-45.0f), Vector3::zAxis())
+    };
+
+    const DualQuaternion dualA[] = {
+        DualQuaternion::translation({1.0f, -2.0f, 3.0f})*DualQuaternion::rotation(Deg(35.0f), Vector3::xAxis()),
+        DualQuaternion::rotation(Deg(-120.0f), Vector3(1.0f, 2.0f, -3.0f).normalized())*DualQuaternion::translation({0.5f, 0.0f, 1.5f}),
+        DualQuaternion::translation(Vector3::yAxis(4.0f))*DualQuaternion::rotation(Deg(270.0f), Vector3::zAxis())
+    };
+
+    const DualQuaternion dualB[] = {
+        DualQuaternion::translation({-1.0f, 0.0f, 2.0f})*DualQuaternion::rotation(Deg(75.0f), Vector3::yAxis()),
+        DualQuaternion::rotation(Deg(10.0f), Vector3(-3.0f, 0.5f, 1.0f).normalized()),
+        DualQuaternion::translation(Vector3::xAxis(-2.0f))*DualQuaternion::rotation(Deg(-45.0f), Vector3::zAxis())
+    };
+}
+
+void QuaternionBatchTest::normalize() {
+    const Quaternion in[] = {
+        Quaternion({1.0f, 2.0f, 3.0f}, 4.0f),
+        Quaternion({0.0f, -0.5f, 0.0f}, 0.0f),
+        a[1]*3.5f
+    };
+    Quaternion out[3];
+    Batch::normalize(in, out);
+
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_COMPARE(out[i], in[i].normalized());
+        CORRADE_VERIFY(out[i].isNormalized());
+    }
+}
+
+void QuaternionBatchTest::normalizeDual() {
+    /* Scaled and with dual part not orthogonal to the real part */
+    const DualQuaternion in[] = {
+        DualQuaternion(dualA[0].real()*2.0f, dualA[0].dual()*2.0f + Quaternion({0.1f, 0.0f, 0.2f}, 0.3f)),
+        DualQuaternion(dualA[1].real()*0.25f, dualA[1].dual()),
+        dualA[2]
+    };
+    DualQuaternion out[3];
+    Batch::normalize(in, out);
+
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_COMPARE(out[i], in[i].normalized());
+        CORRADE_VERIFY(out[i].isNormalized());
+    }
+}
+
+void QuaternionBatchTest::lerpShortestPath() {
+    /* Interpolation between the last two pairs would go the longer path */
+    CORRADE_VERIFY(Quaternion::dot(a[0], b[0]) > 0.0f);
+    CORRADE_VERIFY(Quaternion::dot(a[1], b[1]) < 0.0f);
+    CORRADE_VERIFY(Quaternion::dot(a[2], b[2]) < 0.0f);
+
+    Quaternion out[3];
+    Batch::lerpShortestPath(a, b, 0.35f, out);
+    CORRADE_COMPARE(out[0], Quaternion::lerp(a[0], b[0], 0.35f));
+    CORRADE_COMPARE(out[1], Quaternion::lerp(a[1], -b[1], 0.35f));
+    CORRADE_COMPARE(out[2], Quaternion::lerp(a[2], -b[2], 0.35f));
+
+    /* Endpoints represent the same rotation as inputs */
+    Batch::lerpShortestPath(a, b, 1.0f, out);
+    CORRADE_COMPARE(out[0], b[0]);
+    CORRADE_COMPARE(out[1], -b[1]);
+}
+
+void QuaternionBatchTest::lerpShortestPathDual() {
+    DualQuaternion out[3];
+    Batch::lerpShortestPath(dualA, dualB, 0.35f, out);
+
+    for(std::size_t i = 0; i != 3; ++i) {
+        const Float t = Quaternion::dot(dualA[i].real(), dualB[i].real()) < 0.0f ? -0.35f : 0.35f;
+        const DualQuaternion expected = DualQuaternion(0.65f*dualA[i].real() + t*dualB[i].real(),
+                                                       0.65f*dualA[i].dual() + t*dualB[i].dual()).normalized();
+        CORRADE_COMPARE(out[i], expected);
+        CORRADE_VERIFY(out[i].isNormalized());
+    }
+
+    /* Interpolating between the same transformations gives it back */
+    Batch::lerpShortestPath(dualA, dualA, 0.35f, out);
+    CORRADE_COMPARE(out[0], dualA[0]);
+    CORRADE_COMPARE(out[1], dualA[1]);
+}
+
+void QuaternionBatchTest::slerpShortestPath() {
+    Quaternion out[3];
+    Batch::slerpShortestPath(a, b, 0.35f, out);
+    CORRADE_COMPARE(out[0], Quaternion::slerp(a[0], b[0], 0.35f));
+    CORRADE_COMPARE(out[1], Quaternion::slerp(a[1], -b[1], 0.35f));
+    CORRADE_COMPARE(out[2], Quaternion::slerp(a[2], -b[2], 0.35f));
+}
+
+void QuaternionBatchTest::slerpShortestPathParallel() {
+    /* Would be division by zero in Quaternion::slerp() */
+    const Quaternion in[] = {a[0], -a[1]};
+    const Quaternion in2[] = {a[0], a[1]};
+    Quaternion out[2];
+    Batch::slerpShortestPath(in, in2, 0.35f, out);
+    CORRADE_COMPARE(out[0], a[0]);
+    CORRADE_COMPARE(out[1], -a[1]);
+}
+
+void QuaternionBatchTest::multiply() {
+    Quaternion out[3];
+    Batch::multiply(a, b, out);
+
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_COMPARE(out[i], a[i]*b[i]);
+    }
+}
+
+void QuaternionBatchTest::multiplyDual() {
+    DualQuaternion out[3];
+    Batch::multiply(dualA, dualB, out);
+
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_COMPARE(out[i], dualA[i]*dualB[i]);
+    }
+}
+
+void QuaternionBatchTest::toMatrix() {
+    Matrix3x3 out[3];
+    Batch::toMatrix(a, out);
+
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_COMPARE(out[i], a[i].toMatrix());
+    }
+}
+
+void QuaternionBatchTest::toMatrixDual() {
+    Matrix4 out[3];
+    Batch::toMatrix(dualA, out);
+
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_COMPARE(out[i], dualA[i].toMatrix());
+    }
+}
+
+void QuaternionBatchTest::inPlace() {
+    Quaternion data[] = {a[0], a[1], a[2]};
+    Batch::multiply(data, b, data);
+    Batch::lerpShortestPath(data, b, 0.5f, data);
+
+    for(std::size_t i = 0; i != 3; ++i) {
+        const Quaternion product = a[i]*b[i];
+        const Float t = Quaternion::dot(product, b[i]) < 0.0f ? -0.5f : 0.5f;
+        CORRADE_COMPARE(data[i], (0.5f*product + t*b[i]).normalized());
+    }
+
+    DualQuaternion dualData[] = {dualA[0], dualA[1], dualA[2]};
+    Batch::multiply(dualB, dualData, dualData);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_COMPARE(dualData[i], dualB[i]*dualA[i]);
+    }
+}
+
+void QuaternionBatchTest::invalid() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    Quaternion result[2];
+    DualQuaternion dualResult[2];
+    Matrix3x3 matrices[2];
+    Batch::normalize(a, result);
+    Batch::lerpShortestPath(dualA, dualB, 0.5f, dualResult);
+    Batch::slerpShortestPath(a, b, 0.5f, result);
+    Batch::multiply(a, b, result);
+    Batch::toMatrix(a, matrices);
+
+    CORRADE_COMPARE(out.str(),
+        "Math::Batch::normalize(): expected output array of size 3 but got 2\n"
+        "Math::Batch::lerpShortestPath(): expected arrays of the same size\n"
+        "Math::Batch::slerpShortestPath(): expected arrays of the same size\n"
+        "Math::Batch::multiply(): expected arrays of the same size\n"
+        "Math::Batch::toMatrix(): expected output array of size 3 but got 2\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::QuaternionBatchTest)
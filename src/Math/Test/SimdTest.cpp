@@ -0,0 +1,332 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <TestSuite/Tester.h>
+
+#include "Math/Matrix4.h"
+#include "Math/Quaternion.h"
+#include "Math/Implementation/Simd.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+class SimdTest: public Corrade::TestSuite::Tester {
+    public:
+        explicit SimdTest();
+
+        void vector();
+        void matrixMultiply();
+        void matrixTransformVector();
+        void quaternionMultiply();
+
+        void classVector();
+        void classMatrix();
+        void classQuaternion();
+
+        void benchmarkVector();
+        void benchmarkMatrixMultiply();
+        void benchmarkMatrixTransformVector();
+        void benchmarkQuaternionMultiply();
+};
+
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Matrix4<double> Matrix4d;
+typedef Math::Quaternion<Float> Quaternion;
+#ifndef MAGNUM_TARGET_GLES
+typedef Math::Quaternion<Double> Quaterniond;
+#endif
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector3<double> Vector3d;
+typedef Math::Vector4<Float> Vector4;
+typedef Math::Vector4<double> Vector4d;
+typedef Math::Deg<Float> Deg;
+
+SimdTest::SimdTest() {
+    addTests({&SimdTest::vector,
+              &SimdTest::matrixMultiply,
+              &SimdTest::matrixTransformVector,
+              &SimdTest::quaternionMultiply,
+
+              &SimdTest::classVector,
+              &SimdTest::classMatrix,
+              &SimdTest::classQuaternion,
+
+              &SimdTest::benchmarkVector,
+              &SimdTest::benchmarkMatrixMultiply,
+              &SimdTest::benchmarkMatrixTransformVector,
+              &SimdTest::benchmarkQuaternionMultiply});
+}
+
+namespace {
+    const Matrix4 a(Vector4(3.0f,  5.0f, 8.0f, 4.0f),
+                    Vector4(4.0f,  4.0f, 7.0f, 3.0f),
+                    Vector4(7.0f, -1.0f, 8.0f, 0.0f),
+                    Vector4(9.0f,  4.0f, 5.0f, 9.0f));
+    const Matrix4 b(Vector4(-0.5f, 1.5f,  0.25f, 2.0f),
+                    Vector4( 1.0f, 0.0f, -3.0f,  1.0f),
+                    Vector4( 2.5f, 1.0f,  1.0f, -1.0f),
+                    Vector4( 0.0f, 2.0f,  0.5f,  1.0f));
+    const Vector4 v(1.5f, -2.0f, 0.5f, 3.0f);
+    const Quaternion p = Quaternion::rotation(Deg(35.0f), Vector3(1.0f, 2.0f, 3.0f).normalized());
+    const Quaternion q = Quaternion::rotation(Deg(-120.0f), Vector3(-1.0f, 0.5f, 2.0f).normalized());
+
+    /* Scalar references, done in plain loops to not depend on whether the
+       Math classes are built with SIMD or not */
+    void scalarMultiplyMatrix4(Float* out, const Float* a, const Float* b) {
+        Float temporary[16];
+        for(std::size_t col = 0; col != 4; ++col)
+            for(std::size_t row = 0; row != 4; ++row) {
+                Float sum = 0.0f;
+                for(std::size_t pos = 0; pos != 4; ++pos)
+                    sum += a[pos*4 + row]*b[col*4 + pos];
+                temporary[col*4 + row] = sum;
+            }
+        std::copy(temporary, temporary + 16, out);
+    }
+
+    void scalarTransformVector4(Float* out, const Float* m, const Float* v) {
+        for(std::size_t row = 0; row != 4; ++row) {
+            Float sum = 0.0f;
+            for(std::size_t pos = 0; pos != 4; ++pos)
+                sum += m[pos*4 + row]*v[pos];
+            out[row] = sum;
+        }
+    }
+
+    void scalarMultiplyQuaternion(Float* out, const Float* a, const Float* b) {
+        const Float x = a[3]*b[0] + b[3]*a[0] + a[1]*b[2] - a[2]*b[1];
+        const Float y = a[3]*b[1] + b[3]*a[1] + a[2]*b[0] - a[0]*b[2];
+        const Float z = a[3]*b[2] + b[3]*a[2] + a[0]*b[1] - a[1]*b[0];
+        const Float w = a[3]*b[3] - a[0]*b[0] - a[1]*b[1] - a[2]*b[2];
+        out[0] = x;
+        out[1] = y;
+        out[2] = z;
+        out[3] = w;
+    }
+
+    Quaternion fromArray(const Float* data) {
+        return {Vector3(data[0], data[1], data[2]), data[3]};
+    }
+
+    /* Runs the operation many times, accumulating the results to the input so
+       the loop doesn't get optimized out, returns time per iteration */
+    template<class F> double benchmark(Float* data, F f) {
+        constexpr std::size_t iterations = 1000000;
+
+        const auto begin = std::chrono::steady_clock::now();
+        for(std::size_t i = 0; i != iterations; ++i) f(data);
+        const auto end = std::chrono::steady_clock::now();
+
+        volatile Float sink = data[0];
+        static_cast<void>(sink);
+        return std::chrono::duration_cast<std::chrono::duration<double, std::nano>>(end - begin).count()/iterations;
+    }
+}
+
+void SimdTest::vector() {
+    #if !defined(MAGNUM_MATH_SIMD_SSE) && !defined(MAGNUM_MATH_SIMD_NEON)
+    CORRADE_SKIP("SIMD is not available on this target");
+    #else
+    Vector4 x(v);
+    Implementation::Simd::add4(x.data(), a[1].data());
+    CORRADE_COMPARE(x, Vector4(5.5f, 2.0f, 7.5f, 6.0f));
+    Implementation::Simd::subtract4(x.data(), a[1].data());
+    CORRADE_COMPARE(x, v);
+    Implementation::Simd::multiply4(x.data(), a[1].data());
+    CORRADE_COMPARE(x, Vector4(6.0f, -8.0f, 3.5f, 9.0f));
+    Implementation::Simd::divide4(x.data(), a[1].data());
+    CORRADE_COMPARE(x, v);
+    Implementation::Simd::multiply4(x.data(), 2.0f);
+    CORRADE_COMPARE(x, Vector4(3.0f, -4.0f, 1.0f, 6.0f));
+    Implementation::Simd::divide4(x.data(), 4.0f);
+    CORRADE_COMPARE(x, Vector4(0.75f, -1.0f, 0.25f, 1.5f));
+
+    Vector4 y;
+    Implementation::Simd::negate4(y.data(), x.data());
+    CORRADE_COMPARE(y, Vector4(-0.75f, 1.0f, -0.25f, -1.5f));
+
+    CORRADE_COMPARE(Implementation::Simd::dot4(v.data(), a[0].data()), 10.5f);
+    #endif
+}
+
+void SimdTest::matrixMultiply() {
+    #if !defined(MAGNUM_MATH_SIMD_SSE) && !defined(MAGNUM_MATH_SIMD_NEON)
+    CORRADE_SKIP("SIMD is not available on this target");
+    #else
+    Matrix4 expected, actual;
+    scalarMultiplyMatrix4(expected.data(), a.data(), b.data());
+    Implementation::Simd::multiplyMatrix4(actual.data(), a.data(), b.data());
+    CORRADE_COMPARE(actual, expected);
+
+    /* Output aliasing input */
+    Matrix4 c(a);
+    Implementation::Simd::multiplyMatrix4(c.data(), c.data(), b.data());
+    CORRADE_COMPARE(c, expected);
+    #endif
+}
+
+void SimdTest::matrixTransformVector() {
+    #if !defined(MAGNUM_MATH_SIMD_SSE) && !defined(MAGNUM_MATH_SIMD_NEON)
+    CORRADE_SKIP("SIMD is not available on this target");
+    #else
+    Vector4 expected, actual;
+    scalarTransformVector4(expected.data(), a.data(), v.data());
+    Implementation::Simd::transformVector4(actual.data(), a.data(), v.data());
+    CORRADE_COMPARE(actual, expected);
+    #endif
+}
+
+void SimdTest::quaternionMultiply() {
+    #if !defined(MAGNUM_MATH_SIMD_SSE) && !defined(MAGNUM_MATH_SIMD_NEON)
+    CORRADE_SKIP("SIMD is not available on this target");
+    #else
+    const Float x[] = {p.vector().x(), p.vector().y(), p.vector().z(), p.scalar()};
+    const Float y[] = {q.vector().x(), q.vector().y(), q.vector().z(), q.scalar()};
+    Float expected[4], actual[4];
+    scalarMultiplyQuaternion(expected, x, y);
+    Implementation::Simd::multiplyQuaternion(actual, x, y);
+    CORRADE_COMPARE(fromArray(actual), fromArray(expected));
+    #endif
+}
+
+void SimdTest::classVector() {
+    /* Compared to double precision to verify both scalar and SIMD build */
+    const Vector4d vd(v);
+    const Vector4d ad(a[1]);
+    CORRADE_COMPARE(v + a[1], Vector4(vd + ad));
+    CORRADE_COMPARE(v - a[1], Vector4(vd - ad));
+    CORRADE_COMPARE(v*a[1], Vector4(vd*ad));
+    CORRADE_COMPARE(v/a[1], Vector4(vd/ad));
+    CORRADE_COMPARE(v*2.5f, Vector4(vd*2.5));
+    CORRADE_COMPARE(v/2.5f, Vector4(vd/2.5));
+    CORRADE_COMPARE(-v, Vector4(-vd));
+    CORRADE_COMPARE(Vector4::dot(v, a[1]), Float(Vector4d::dot(vd, ad)));
+    CORRADE_COMPARE(v.length(), Float(vd.length()));
+}
+
+void SimdTest::classMatrix() {
+    const Matrix4d ad(a);
+    const Matrix4d bd(b);
+    CORRADE_COMPARE(a*b, Matrix4(ad*bd));
+    CORRADE_COMPARE(a*v, Vector4(ad*Vector4d(v)));
+    CORRADE_COMPARE(a.transformPoint(v.xyz()), Vector3(ad.transformPoint(Vector3d(v.xyz()))));
+}
+
+void SimdTest::classQuaternion() {
+    #ifndef MAGNUM_TARGET_GLES
+    const Quaterniond pd = Quaterniond::rotation(Math::Deg<Double>(35.0), Vector3d(1.0, 2.0, 3.0).normalized());
+    const Quaterniond qd = Quaterniond::rotation(Math::Deg<Double>(-120.0), Vector3d(-1.0, 0.5, 2.0).normalized());
+    const Quaterniond pq = pd*qd;
+    CORRADE_COMPARE(p*q, Quaternion(Vector3(pq.vector()), Float(pq.scalar())));
+    CORRADE_COMPARE(Quaternion::dot(p, q), Float(Quaterniond::dot(pd, qd)));
+    CORRADE_COMPARE(p.transformVectorNormalized(v.xyz()), Vector3(pd.transformVectorNormalized(Vector3d(v.xyz()))));
+    CORRADE_COMPARE(p.transformVector(v.xyz()), Vector3(pd.transformVector(Vector3d(v.xyz()))));
+    #else
+    CORRADE_SKIP("Double precision is not supported when targeting OpenGL ES.");
+    #endif
+}
+
+void SimdTest::benchmarkVector() {
+    #if !defined(MAGNUM_MATH_SIMD_SSE) && !defined(MAGNUM_MATH_SIMD_NEON)
+    CORRADE_SKIP("SIMD is not available on this target");
+    #else
+    Vector4 x(v), y(v);
+    const Vector4 c(0.5f, 0.25f, 1.0f, 0.75f);
+    const double scalar = benchmark(x.data(), [&c](Float* data) {
+        for(std::size_t i = 0; i != 4; ++i)
+            data[i] = (data[i] + c[i])*c[i];
+    });
+    const double simd = benchmark(y.data(), [&c](Float* data) {
+        Implementation::Simd::add4(data, c.data());
+        Implementation::Simd::multiply4(data, c.data());
+    });
+    CORRADE_COMPARE(y, x);
+
+    Debug() << "Vector4 add and multiply, scalar:" << scalar << "ns, SIMD:" << simd << "ns";
+    #endif
+}
+
+void SimdTest::benchmarkMatrixMultiply() {
+    #if !defined(MAGNUM_MATH_SIMD_SSE) && !defined(MAGNUM_MATH_SIMD_NEON)
+    CORRADE_SKIP("SIMD is not available on this target");
+    #else
+    /* Rotation matrix to not overflow during repeated multiplication */
+    const Matrix4 rotation = Matrix4::rotation(Deg(0.1f), Vector3(1.0f, 2.0f, 3.0f).normalized());
+    Matrix4 x, y;
+    const double scalar = benchmark(x.data(), [&rotation](Float* data) {
+        scalarMultiplyMatrix4(data, data, rotation.data());
+    });
+    const double simd = benchmark(y.data(), [&rotation](Float* data) {
+        Implementation::Simd::multiplyMatrix4(data, data, rotation.data());
+    });
+    for(std::size_t i = 0; i != 4; ++i)
+        CORRADE_VERIFY((y[i] - x[i]).length() < 1.0e-3f);
+
+    Debug() << "Matrix4 multiplication, scalar:" << scalar << "ns, SIMD:" << simd << "ns";
+    #endif
+}
+
+void SimdTest::benchmarkMatrixTransformVector() {
+    #if !defined(MAGNUM_MATH_SIMD_SSE) && !defined(MAGNUM_MATH_SIMD_NEON)
+    CORRADE_SKIP("SIMD is not available on this target");
+    #else
+    const Matrix4 rotation = Matrix4::rotation(Deg(0.1f), Vector3(1.0f, 2.0f, 3.0f).normalized());
+    Vector4 x(v), y(v);
+    const double scalar = benchmark(x.data(), [&rotation](Float* data) {
+        Float out[4];
+        scalarTransformVector4(out, rotation.data(), data);
+        std::copy(out, out + 4, data);
+    });
+    const double simd = benchmark(y.data(), [&rotation](Float* data) {
+        Implementation::Simd::transformVector4(data, rotation.data(), data);
+    });
+    CORRADE_VERIFY((y - x).length() < 1.0e-3f);
+
+    Debug() << "Matrix4 vector transformation, scalar:" << scalar << "ns, SIMD:" << simd << "ns";
+    #endif
+}
+
+void SimdTest::benchmarkQuaternionMultiply() {
+    #if !defined(MAGNUM_MATH_SIMD_SSE) && !defined(MAGNUM_MATH_SIMD_NEON)
+    CORRADE_SKIP("SIMD is not available on this target");
+    #else
+    const Float rotation[] = {q.vector().x(), q.vector().y(), q.vector().z(), q.scalar()};
+    Float x[] = {0.0f, 0.0f, 0.0f, 1.0f};
+    Float y[] = {0.0f, 0.0f, 0.0f, 1.0f};
+    const double scalar = benchmark(x, [&rotation](Float* data) {
+        scalarMultiplyQuaternion(data, data, rotation);
+    });
+    const double simd = benchmark(y, [&rotation](Float* data) {
+        Implementation::Simd::multiplyQuaternion(data, data, rotation);
+    });
+    CORRADE_VERIFY((fromArray(y) - fromArray(x)).length() < 1.0e-3f);
+
+    Debug() << "Quaternion multiplication, scalar:" << scalar << "ns, SIMD:" << simd << "ns";
+    #endif
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::SimdTest)
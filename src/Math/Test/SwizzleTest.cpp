@@ -22,9 +22,11 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <TestSuite/Tester.h>
 
 #include "Math/Swizzle.h"
+#include "Math/Vector4.h"
 
 namespace Magnum { namespace Math { namespace Test {
 
@@ -36,15 +38,31 @@ class SwizzleTest: public Corrade::TestSuite::Tester {
         void constants();
         void rgba();
         void sizes();
+
+        void array();
+        void arrayConstants();
+        void arrayFloat();
+        void arrayInPlace();
+        void arrayDifferentSize();
+        void arrayInvalid();
 };
 
 typedef Vector<4, Int> Vector4i;
+typedef Math::Vector4<UnsignedByte> Vector4ub;
+typedef Math::Vector4<Float> Vector4;
 
 SwizzleTest::SwizzleTest() {
     addTests({&SwizzleTest::components,
               &SwizzleTest::constants,
               &SwizzleTest::rgba,
-              &SwizzleTest::sizes});
+              &SwizzleTest::sizes,
+
+              &SwizzleTest::array,
+              &SwizzleTest::arrayConstants,
+              &SwizzleTest::arrayFloat,
+              &SwizzleTest::arrayInPlace,
+              &SwizzleTest::arrayDifferentSize,
+              &SwizzleTest::arrayInvalid});
 }
 
 void SwizzleTest::components() {
@@ -73,6 +91,76 @@ void SwizzleTest::sizes() {
     CORRADE_COMPARE(c, (Math::Vector<7, Int>(3, 1, 4, 2, 3, 2, 1)));
 }
 
+/* Nineteen pixels, so both the blocks and the remainder are processed */
+namespace {
+    std::vector<Vector4ub> pixels() {
+        std::vector<Vector4ub> out;
+        for(UnsignedByte i = 0; i != 19; ++i)
+            out.push_back(Vector4ub(i*4, i*4 + 1, i*4 + 2, i*4 + 3));
+        return out;
+    }
+}
+
+void SwizzleTest::array() {
+    const std::vector<Vector4ub> in = pixels();
+    std::vector<Vector4ub> out(in.size());
+    swizzle<'b', 'g', 'r', 'a'>(Corrade::Containers::ArrayReference<const Vector4ub>{in.data(), in.size()}, {out.data(), out.size()});
+
+    for(std::size_t i = 0; i != in.size(); ++i)
+        CORRADE_COMPARE(out[i], (swizzle<'b', 'g', 'r', 'a'>(in[i])));
+    CORRADE_COMPARE(out[18], Vector4ub(74, 73, 72, 75));
+}
+
+void SwizzleTest::arrayConstants() {
+    const std::vector<Vector4ub> in = pixels();
+    std::vector<Vector4ub> out(in.size());
+    swizzle<'1', 'w', '0', 'y'>(Corrade::Containers::ArrayReference<const Vector4ub>{in.data(), in.size()}, {out.data(), out.size()});
+
+    for(std::size_t i = 0; i != in.size(); ++i)
+        CORRADE_COMPARE(out[i], (swizzle<'1', 'w', '0', 'y'>(in[i])));
+    CORRADE_COMPARE(out[2], Vector4ub(1, 11, 0, 9));
+}
+
+void SwizzleTest::arrayFloat() {
+    const Vector4 in[]{{1.0f, 2.0f, 3.0f, 4.0f},
+                       {-1.5f, 0.5f, 7.0f, 1.0e10f},
+                       {0.0f, -0.0f, 3.5f, -2.0f}};
+    Vector4 out[3];
+    swizzle<'z', '1', 'x', '0'>(Corrade::Containers::ArrayReference<const Vector4>(in), out);
+
+    CORRADE_COMPARE(out[0], Vector4(3.0f, 1.0f, 1.0f, 0.0f));
+    CORRADE_COMPARE(out[1], Vector4(7.0f, 1.0f, -1.5f, 0.0f));
+    CORRADE_COMPARE(out[2], Vector4(3.5f, 1.0f, 0.0f, 0.0f));
+}
+
+void SwizzleTest::arrayInPlace() {
+    const std::vector<Vector4ub> in = pixels();
+    std::vector<Vector4ub> data = in;
+    swizzle<'a', 'b', 'g', 'r'>(Corrade::Containers::ArrayReference<const Vector4ub>{data.data(), data.size()}, {data.data(), data.size()});
+
+    for(std::size_t i = 0; i != in.size(); ++i)
+        CORRADE_COMPARE(data[i], (swizzle<'a', 'b', 'g', 'r'>(in[i])));
+}
+
+void SwizzleTest::arrayDifferentSize() {
+    /* No shuffles, generic code path */
+    const std::vector<Vector4ub> in = pixels();
+    std::vector<Math::Vector3<UnsignedByte>> out(in.size());
+    swizzle<'b', 'g', 'r'>(Corrade::Containers::ArrayReference<const Vector4ub>{in.data(), in.size()}, {out.data(), out.size()});
+
+    CORRADE_COMPARE(out[5], (Math::Vector3<UnsignedByte>(22, 21, 20)));
+}
+
+void SwizzleTest::arrayInvalid() {
+    std::ostringstream o;
+    Corrade::Utility::Error::setOutput(&o);
+
+    const Vector4 in[2];
+    Vector4 out[3];
+    swizzle<'x', 'y', 'z', 'w'>(Corrade::Containers::ArrayReference<const Vector4>(in), out);
+    CORRADE_COMPARE(o.str(), "Math::swizzle(): expected arrays of the same size\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::SwizzleTest)
@@ -37,6 +37,7 @@
 #include "Math/Angle.h"
 #include "Math/BoolVector.h"
 #include "Math/TypeTraits.h"
+#include "Math/Implementation/Simd.h"
 
 #include "magnumVisibility.h"
 
@@ -1304,6 +1305,48 @@ template<std::size_t size, class T> inline T Vector<size, T>::max() const {
     return out;
 }
 
+#if defined(MAGNUM_MATH_SIMD) && !defined(DOXYGEN_GENERATING_OUTPUT)
+template<> inline Vector<4, Float>& Vector<4, Float>::operator+=(const Vector<4, Float>& other) {
+    Implementation::Simd::add4(_data, other._data);
+    return *this;
+}
+
+template<> inline Vector<4, Float>& Vector<4, Float>::operator-=(const Vector<4, Float>& other) {
+    Implementation::Simd::subtract4(_data, other._data);
+    return *this;
+}
+
+template<> inline Vector<4, Float>& Vector<4, Float>::operator*=(const Float number) {
+    Implementation::Simd::multiply4(_data, number);
+    return *this;
+}
+
+template<> inline Vector<4, Float>& Vector<4, Float>::operator/=(const Float number) {
+    Implementation::Simd::divide4(_data, number);
+    return *this;
+}
+
+template<> inline Vector<4, Float>& Vector<4, Float>::operator*=(const Vector<4, Float>& other) {
+    Implementation::Simd::multiply4(_data, other._data);
+    return *this;
+}
+
+template<> inline Vector<4, Float>& Vector<4, Float>::operator/=(const Vector<4, Float>& other) {
+    Implementation::Simd::divide4(_data, other._data);
+    return *this;
+}
+
+template<> inline Vector<4, Float> Vector<4, Float>::operator-() const {
+    Vector<4, Float> out;
+    Implementation::Simd::negate4(out._data, _data);
+    return out;
+}
+
+template<> inline Float Vector<4, Float>::dot(const Vector<4, Float>& a, const Vector<4, Float>& b) {
+    return Implementation::Simd::dot4(a._data, b._data);
+}
+#endif
+
 }}
 
 namespace Corrade { namespace Utility {
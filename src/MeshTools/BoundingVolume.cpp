@@ -0,0 +1,229 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BoundingVolume.h"
+
+#include <algorithm>
+
+#include "Math/Functions.h"
+#include "Math/Matrix3.h"
+#include "Math/Matrix4.h"
+#include "Math/Algorithms/Svd.h"
+#include "Math/Implementation/Simd.h"
+#include "MeshTools/Implementation/Parallel.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Don't spawn threads for less than this, the overhead would outweigh the
+   gain */
+constexpr std::size_t MinPointsPerThread = 65536;
+
+template<std::size_t dimensions> Math::Range<dimensions, Float> combineRanges(const Math::Range<dimensions, Float>& a, const Math::Range<dimensions, Float>& b) {
+    return {Math::min(a.min(), b.min()), Math::max(a.max(), b.max())};
+}
+
+/* Range of points in [begin, end), expects non-empty range. Four points are
+   in `dimensions` registers, with components interleaved, the per-component
+   minima and maxima are extracted at the end. */
+template<std::size_t dimensions> Math::Range<dimensions, Float> rangeOf(const Math::Vector<dimensions, Float>* const points, std::size_t begin, const std::size_t end) {
+    Math::Vector<dimensions, Float> min = points[begin], max = points[begin];
+
+    #if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+    using namespace Math::Implementation::Simd;
+    if(end - begin >= 4) {
+        const Float* data = points[begin].data();
+        Register minimums[dimensions], maximums[dimensions];
+        for(std::size_t i = 0; i != dimensions; ++i)
+            minimums[i] = maximums[i] = load(data + 4*i);
+
+        for(begin += 4; begin + 4 <= end; begin += 4) {
+            data = points[begin].data();
+            for(std::size_t i = 0; i != dimensions; ++i) {
+                const Register value = load(data + 4*i);
+                minimums[i] = minimum(minimums[i], value);
+                maximums[i] = maximum(maximums[i], value);
+            }
+        }
+
+        Float minimumValues[4*dimensions], maximumValues[4*dimensions];
+        for(std::size_t i = 0; i != dimensions; ++i) {
+            store(minimumValues + 4*i, minimums[i]);
+            store(maximumValues + 4*i, maximums[i]);
+        }
+        for(std::size_t i = 0; i != 4*dimensions; ++i) {
+            min[i%dimensions] = Math::min(min[i%dimensions], minimumValues[i]);
+            max[i%dimensions] = Math::max(max[i%dimensions], maximumValues[i]);
+        }
+    }
+    #endif
+
+    for(; begin != end; ++begin) {
+        min = Math::min(min, points[begin]);
+        max = Math::max(max, points[begin]);
+    }
+
+    return {min, max};
+}
+
+template<std::size_t dimensions> Math::Range<dimensions, Float> boundingRangeInternal(const Containers::ArrayReference<const Math::Vector<dimensions, Float>> points) {
+    if(points.empty()) return {};
+
+    return Implementation::parallelReduce<Math::Range<dimensions, Float>>(points.size(), MinPointsPerThread, 4,
+        [&points](std::size_t begin, std::size_t end) { return rangeOf<dimensions>(points.data(), begin, end); },
+        combineRanges<dimensions>);
+}
+
+/* Index of the point farthest from given one */
+std::size_t farthestFrom(const Containers::ArrayReference<const Vector3> points, const Vector3& from) {
+    typedef std::pair<Float, std::size_t> Farthest;
+    return Implementation::parallelReduce<Farthest>(points.size(), MinPointsPerThread, 4, [&points, &from](std::size_t begin, const std::size_t end) {
+        Farthest farthest{-1.0f, begin};
+        for(; begin != end; ++begin) {
+            const Float distance = (points[begin] - from).dot();
+            if(distance > farthest.first) farthest = {distance, begin};
+        }
+        return farthest;
+    }, [](const Farthest& a, const Farthest& b) { return std::max(a, b); }).second;
+}
+
+typedef std::pair<Vector3, Float> Sphere;
+
+/* Smallest sphere enclosing both spheres */
+Sphere combineSpheres(const Sphere& a, const Sphere& b) {
+    const Vector3 direction = b.first - a.first;
+    const Float distance = direction.length();
+    if(distance + b.second <= a.second) return a;
+    if(distance + a.second <= b.second) return b;
+
+    const Float radius = (distance + a.second + b.second)*0.5f;
+    return {a.first + direction*((radius - a.second)/distance), radius};
+}
+
+}
+
+Range2D boundingRange(const Containers::ArrayReference<const Vector2> points) {
+    return boundingRangeInternal<2>({points.data(), points.size()});
+}
+
+Range3D boundingRange(const Containers::ArrayReference<const Vector3> points) {
+    return boundingRangeInternal<3>({points.data(), points.size()});
+}
+
+std::pair<Vector3, Float> boundingSphere(const Containers::ArrayReference<const Vector3> points) {
+    if(points.empty()) return {};
+
+    /* Initial sphere spanned by two distant points */
+    const Vector3 a = points[farthestFrom(points, points[0])];
+    const Vector3 b = points[farthestFrom(points, a)];
+    const Sphere initial{(a + b)*0.5f, (b - a).length()*0.5f};
+
+    /* Grow the sphere to contain all points, in each range separately */
+    return Implementation::parallelReduce<Sphere>(points.size(), MinPointsPerThread, 4, [&points, &initial](std::size_t begin, const std::size_t end) {
+        Vector3 center = initial.first;
+        Float radius = initial.second;
+        for(; begin != end; ++begin) {
+            const Vector3 direction = points[begin] - center;
+            const Float distanceSquared = direction.dot();
+            if(distanceSquared <= radius*radius) continue;
+
+            /* Move the center towards the point so the opposite side of the
+               sphere stays in place */
+            const Float distance = std::sqrt(distanceSquared);
+            const Float newRadius = (radius + distance)*0.5f;
+            center += direction*((newRadius - radius)/distance);
+            radius = newRadius;
+        }
+        return Sphere{center, radius};
+    }, combineSpheres);
+}
+
+Matrix4 orientedBoundingBox(const Containers::ArrayReference<const Vector3> points) {
+    if(points.empty()) return Matrix4(Matrix4::Zero);
+
+    /* Sums of coordinates and their products relative to the first point, in
+       double precision to avoid catastrophic cancellation when computing the
+       covariance */
+    struct Moments {
+        double sum[3];
+        double products[6];
+    };
+    const Vector3 origin = points[0];
+    const Moments moments = Implementation::parallelReduce<Moments>(points.size(), MinPointsPerThread, 4, [&points, &origin](std::size_t begin, const std::size_t end) {
+        Moments moments{};
+        for(; begin != end; ++begin) {
+            const Vector3 p = points[begin] - origin;
+            const double x = p.x(), y = p.y(), z = p.z();
+            moments.sum[0] += x;
+            moments.sum[1] += y;
+            moments.sum[2] += z;
+            moments.products[0] += x*x;
+            moments.products[1] += x*y;
+            moments.products[2] += x*z;
+            moments.products[3] += y*y;
+            moments.products[4] += y*z;
+            moments.products[5] += z*z;
+        }
+        return moments;
+    }, [](Moments a, const Moments& b) {
+        for(std::size_t i = 0; i != 3; ++i) a.sum[i] += b.sum[i];
+        for(std::size_t i = 0; i != 6; ++i) a.products[i] += b.products[i];
+        return a;
+    });
+
+    /* Covariance matrix */
+    const double count = points.size();
+    const double mean[3]{moments.sum[0]/count, moments.sum[1]/count, moments.sum[2]/count};
+    const std::size_t productIndex[3][3]{{0, 1, 2}, {1, 3, 4}, {2, 4, 5}};
+    Matrix3 covariance;
+    for(std::size_t col = 0; col != 3; ++col)
+        for(std::size_t row = 0; row != 3; ++row)
+            covariance[col][row] = Float(moments.products[productIndex[col][row]]/count - mean[col]*mean[row]);
+
+    /* The matrix is symmetric, so right singular vectors are its
+       eigenvectors. Jacobi rotations keep V a proper rotation. */
+    const Matrix3 axes = Matrix3(std::get<2>(Math::Algorithms::svd3(Math::Matrix<3, Float>(covariance))));
+    const Matrix3 axesTransposed = axes.transposed();
+
+    /* Extents of the points projected onto the axes */
+    const Range3D extents = Implementation::parallelReduce<Range3D>(points.size(), MinPointsPerThread, 4, [&points, &origin, &axesTransposed](std::size_t begin, const std::size_t end) {
+        Vector3 min = axesTransposed*(points[begin] - origin), max = min;
+        for(++begin; begin != end; ++begin) {
+            const Vector3 projected = axesTransposed*(points[begin] - origin);
+            min = Math::min(min, projected);
+            max = Math::max(max, projected);
+        }
+        return Range3D{min, max};
+    }, combineRanges<3>);
+
+    const Vector3 halfSize = extents.size()*0.5f;
+    Matrix3 rotationScaling;
+    for(std::size_t i = 0; i != 3; ++i)
+        rotationScaling[i] = axes[i]*halfSize[i];
+
+    return Matrix4::from(rotationScaling, origin + axes*extents.center());
+}
+
+}}
@@ -0,0 +1,100 @@
+#ifndef Magnum_MeshTools_BoundingVolume_h
+#define Magnum_MeshTools_BoundingVolume_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function Magnum::MeshTools::boundingRange(), Magnum::MeshTools::boundingSphere(), Magnum::MeshTools::orientedBoundingBox()
+ */
+
+#include <utility>
+#include <Containers/Array.h>
+
+#include "Math/Range.h"
+#include "Magnum.h"
+
+#include "magnumMeshToolsVisibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Axis-aligned bounding box of 2D points
+
+Returns range spanning all points, or zero range if @p points are empty. The
+points are processed four at a time using SSE or NEON instructions, if
+available. Large arrays are split across hardware threads.
+@see @ref boundingSphere(), @ref orientedBoundingBox()
+*/
+Range2D MAGNUM_MESHTOOLS_EXPORT boundingRange(Containers::ArrayReference<const Vector2> points);
+
+/**
+@brief Axis-aligned bounding box of 3D points
+
+Returns range spanning all points, or zero range if @p points are empty. The
+points are processed four at a time using SSE or NEON instructions, if
+available. Large arrays are split across hardware threads. Example usage:
+@code
+std::vector<Vector3> positions;
+Range3D bounds = MeshTools::boundingRange({positions.data(), positions.size()});
+@endcode
+@see @ref boundingSphere(), @ref orientedBoundingBox()
+*/
+Range3D MAGNUM_MESHTOOLS_EXPORT boundingRange(Containers::ArrayReference<const Vector3> points);
+
+/**
+@brief Bounding sphere of 3D points
+
+Returns center and radius of sphere enclosing all points, computed using
+Ritter's algorithm. Initial sphere is spanned by two distant points, found as
+the point farthest from the first point and the point farthest from that one.
+The sphere is then grown to include all points outside. The result is usually
+within 5-20% of the minimal enclosing sphere. Returns zero sphere if
+@p points are empty. Large arrays are split across hardware threads, each
+thread grows its own sphere and these are then merged together. The result
+can be directly used to construct @ref Shapes::Sphere3D.
+@see @ref boundingRange(), @ref orientedBoundingBox()
+*/
+std::pair<Vector3, Float> MAGNUM_MESHTOOLS_EXPORT boundingSphere(Containers::ArrayReference<const Vector3> points);
+
+/**
+@brief Oriented bounding box of 3D points
+
+Box axes are eigenvectors of covariance matrix of the points, computed using
+@ref Math::Algorithms::svd3(), the box extents are ranges of the points
+projected onto these axes. Returns transformation of unit box with half
+extents equal to 1 into the oriented bounding box, i.e. the columns are box
+axes scaled by half extents and the translation is box center. The axes form
+right-handed coordinate system. The result can be directly used to construct
+@ref Shapes::Box3D. Returns zero matrix if @p points are empty. Large arrays
+are split across hardware threads.
+
+For points with (nearly) uniform distribution along more axes, such as box
+corners, the axes are not unique and the box is not guaranteed to be minimal.
+@see @ref boundingRange(), @ref boundingSphere()
+*/
+Matrix4 MAGNUM_MESHTOOLS_EXPORT orientedBoundingBox(Containers::ArrayReference<const Vector3> points);
+
+}}
+
+#endif
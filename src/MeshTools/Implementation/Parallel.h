@@ -0,0 +1,87 @@
+#ifndef Magnum_MeshTools_Implementation_Parallel_h
+#define Magnum_MeshTools_Implementation_Parallel_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace Magnum { namespace MeshTools { namespace Implementation {
+
+/* Count of threads for processing given count of items, at most one per
+   hardware thread and each with at least minPerThread items */
+inline std::size_t threadCount(const std::size_t count, const std::size_t minPerThread) {
+    return std::max<std::size_t>(1, std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), count/minPerThread));
+}
+
+/* Splits [0, count) into given count of ranges with size rounded up to a
+   multiple of alignment, so only the last range can have a remainder, and
+   calls function(i, begin, end) for each of them in parallel. The last range
+   is processed on the calling thread. */
+template<class Function> void parallelRanges(const std::size_t threadCount, const std::size_t count, const std::size_t alignment, const Function& function) {
+    if(threadCount == 1) {
+        function(0, 0, count);
+        return;
+    }
+
+    const std::size_t perThread = (count/threadCount + alignment - 1)/alignment*alignment;
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    std::size_t begin = 0;
+    for(std::size_t i = 0; i != threadCount - 1; ++i, begin += perThread)
+        threads.emplace_back([&function, i, begin, perThread]() {
+            function(i, begin, begin + perThread);
+        });
+
+    /* The last range on this thread */
+    function(threadCount - 1, begin, count);
+
+    for(std::thread& thread: threads) thread.join();
+}
+
+/* Calls function(begin, end) on ranges of [0, count) in parallel */
+template<class Function> void parallelFor(const std::size_t count, const std::size_t minPerThread, const std::size_t alignment, const Function& function) {
+    parallelRanges(threadCount(count, minPerThread), count, alignment, [&function](std::size_t, std::size_t begin, std::size_t end) {
+        function(begin, end);
+    });
+}
+
+/* Calls function(begin, end) on ranges of [0, count) in parallel and
+   combines the partial results in order */
+template<class Result, class Function, class Combine> Result parallelReduce(const std::size_t count, const std::size_t minPerThread, const std::size_t alignment, const Function& function, const Combine& combine) {
+    std::vector<Result> results(threadCount(count, minPerThread));
+    parallelRanges(results.size(), count, alignment, [&function, &results](std::size_t i, std::size_t begin, std::size_t end) {
+        results[i] = function(begin, end);
+    });
+
+    Result result = results.front();
+    for(std::size_t i = 1; i != results.size(); ++i)
+        result = combine(result, results[i]);
+    return result;
+}
+
+}}}
+
+#endif
@@ -0,0 +1,117 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PackAttributes.h"
+
+#include "Math/Functions.h"
+#include "Math/Matrix4.h"
+
+namespace Magnum { namespace MeshTools {
+
+std::vector<Math::Vector3<UnsignedShort>> packPositions(const std::vector<Vector3>& positions, const Range3D& range) {
+    /* Avoid division by zero for flat ranges, all coordinates in given
+       dimension then end up as zero */
+    const Vector3 size = range.size();
+    Vector3 scale;
+    for(std::size_t i = 0; i != 3; ++i)
+        scale[i] = size[i] == 0.0f ? 0.0f : 65535.0f/size[i];
+
+    std::vector<Math::Vector3<UnsignedShort>> out;
+    out.reserve(positions.size());
+    for(const Vector3& position: positions)
+        out.push_back(Math::Vector3<UnsignedShort>(Math::round(Math::clamp((position - range.min())*scale, 0.0f, 65535.0f))));
+
+    return out;
+}
+
+Matrix4 packedPositionTransformation(const Range3D& range) {
+    return Matrix4::translation(range.min())*Matrix4::scaling(range.size());
+}
+
+namespace {
+
+/* Octahedral encoding of normalized vector into [-1, 1] square */
+Vector2 octahedronEncode(const Vector3& normal) {
+    const Vector2 p = normal.xy()/(std::abs(normal.x()) + std::abs(normal.y()) + std::abs(normal.z()));
+    if(normal.z() >= 0.0f) return p;
+
+    /* Fold the lower hemisphere over the diagonals */
+    return Vector2(p.x() >= 0.0f ? 1.0f - std::abs(p.y()) : std::abs(p.y()) - 1.0f,
+                   p.y() >= 0.0f ? 1.0f - std::abs(p.x()) : std::abs(p.x()) - 1.0f);
+}
+
+template<class T> Math::Vector2<T> packNormal(const Vector3& normal) {
+    constexpr Float max = std::numeric_limits<T>::max();
+    const Vector2 encoded = Math::clamp(octahedronEncode(normal), -1.0f, 1.0f)*max;
+
+    /* Pick the one of four nearest quantized values which decodes closest
+       to the original normal */
+    const Vector2 floor = Math::floor(encoded);
+    Math::Vector2<T> best;
+    Float bestDot = -2.0f;
+    for(std::size_t i = 0; i != 4; ++i) {
+        const Vector2 candidate(i & 1 ? Math::min(floor.x() + 1.0f, max) : floor.x(),
+                                i & 2 ? Math::min(floor.y() + 1.0f, max) : floor.y());
+        const Float dot = Vector3::dot(unpackNormal(candidate/max), normal);
+        if(dot > bestDot) {
+            bestDot = dot;
+            best = Math::Vector2<T>(candidate);
+        }
+    }
+
+    return best;
+}
+
+}
+
+template<class T> std::vector<Math::Vector2<T>> packNormals(const std::vector<Vector3>& normals) {
+    std::vector<Math::Vector2<T>> out;
+    out.reserve(normals.size());
+    for(const Vector3& normal: normals)
+        out.push_back(packNormal<T>(normal));
+
+    return out;
+}
+
+template MAGNUM_MESHTOOLS_EXPORT std::vector<Math::Vector2<Byte>> packNormals<Byte>(const std::vector<Vector3>&);
+template MAGNUM_MESHTOOLS_EXPORT std::vector<Math::Vector2<Short>> packNormals<Short>(const std::vector<Vector3>&);
+
+Vector3 unpackNormal(const Vector2& packed) {
+    Vector3 normal(packed, 1.0f - std::abs(packed.x()) - std::abs(packed.y()));
+    const Float t = Math::max(-normal.z(), 0.0f);
+    normal.x() += normal.x() >= 0.0f ? -t : t;
+    normal.y() += normal.y() >= 0.0f ? -t : t;
+    return normal.normalized();
+}
+
+std::vector<Math::Vector2<UnsignedShort>> packTextureCoordinates(const std::vector<Vector2>& textureCoordinates) {
+    std::vector<Math::Vector2<UnsignedShort>> out;
+    out.reserve(textureCoordinates.size());
+    for(const Vector2& coordinates: textureCoordinates)
+        out.push_back({Math::packHalf(coordinates.x()), Math::packHalf(coordinates.y())});
+
+    return out;
+}
+
+}}
@@ -0,0 +1,191 @@
+#ifndef Magnum_MeshTools_PackAttributes_h
+#define Magnum_MeshTools_PackAttributes_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function Magnum::MeshTools::packPositions(), Magnum::MeshTools::packNormals(), Magnum::MeshTools::packTextureCoordinates(), Magnum::MeshTools::packedPositionAttribute(), Magnum::MeshTools::packedNormalAttribute(), Magnum::MeshTools::packedTextureCoordinateAttribute()
+ */
+
+#include <vector>
+
+#include "Math/Range.h"
+#include "AbstractShaderProgram.h"
+
+#include "magnumMeshToolsVisibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace Implementation {
+    template<class> struct PackedNormalType;
+    template<> struct PackedNormalType<Byte> {
+        template<class Attribute> constexpr static typename Attribute::DataType dataType() {
+            return Attribute::DataType::Byte;
+        }
+    };
+    template<> struct PackedNormalType<Short> {
+        template<class Attribute> constexpr static typename Attribute::DataType dataType() {
+            return Attribute::DataType::Short;
+        }
+    };
+}
+
+/**
+@brief Pack positions into normalized 16-bit integers
+@param positions    Positions to pack
+@param range        Range to which the positions are quantized
+
+Maps the positions linearly from @p range to full range of
+@ref Magnum::UnsignedShort "UnsignedShort", rounding to nearest. Positions
+outside the range are clamped, zero-sized range dimensions result in zero
+coordinates. The quantization error is at most half of @f$ 1/65535 @f$ of range
+size in each dimension. Use @ref packedPositionAttribute() to describe the
+data to the mesh and pass @ref packedPositionTransformation() to the shader
+together with the transformation matrix to get the original positions back:
+@code
+Range3D range = ...;
+std::vector<Math::Vector3<UnsignedShort>> packed = MeshTools::packPositions(positions, range);
+
+Buffer buffer;
+buffer.setData(packed, BufferUsage::StaticDraw);
+mesh.addVertexBuffer(buffer, 0, MeshTools::packedPositionAttribute<Shaders::Generic3D::Position>());
+
+shader.setTransformationMatrix(transformation*MeshTools::packedPositionTransformation(range));
+@endcode
+
+Half the vertex data size compared to @ref Magnum::Vector3 "Vector3".
+@see @ref packNormals(), @ref packTextureCoordinates()
+*/
+std::vector<Math::Vector3<UnsignedShort>> MAGNUM_MESHTOOLS_EXPORT packPositions(const std::vector<Vector3>& positions, const Range3D& range);
+
+/**
+@brief Transformation of positions packed with @ref packPositions()
+
+Scales normalized position from @f$ [0, 1] @f$ to size of @p range and
+translates them to its minimal corner.
+*/
+Matrix4 MAGNUM_MESHTOOLS_EXPORT packedPositionTransformation(const Range3D& range);
+
+/**
+@brief Attribute description for positions packed with @ref packPositions()
+
+Three normalized @ref Magnum::UnsignedShort "UnsignedShort" components, usable
+with any three- or four-component floating-point position attribute, e.g.
+@ref Shaders::Generic3D::Position.
+*/
+template<class Attribute> constexpr Attribute packedPositionAttribute() {
+    return Attribute(Attribute::Components::Three, Attribute::DataType::UnsignedShort, Attribute::DataOption::Normalized);
+}
+
+/**
+@brief Pack normals using octahedral encoding
+@tparam T           Component type, either @ref Magnum::Byte "Byte" or
+    @ref Magnum::Short "Short"
+@param normals      Normalized vectors to pack
+
+Projects the normals onto octahedron, unfolds the octahedron into a square and
+stores the two coordinates as normalized signed integers. From the four nearest
+quantized values the one decoding closest to the original normal is chosen,
+resulting in maximal angular error of about @f$ 0.6° @f$ for
+@ref Magnum::Byte "Byte" and below @f$ 0.01° @f$ for @ref Magnum::Short "Short".
+That's a quarter or a half of the size compared to three-component
+@ref Magnum::Vector3 "Vector3", with error distributed uniformly over the
+sphere. Use @ref packedNormalAttribute() to describe the data to the mesh, the
+normal is then decoded in the shader like this:
+@code
+in mediump vec2 packedNormal;
+
+vec3 unpackNormal(vec2 p) {
+    vec3 n = vec3(p, 1.0 - abs(p.x) - abs(p.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+@endcode
+
+The same decoding on the CPU is done with @ref unpackNormal(). The choice of
+the nearest quantized value assumes that the integer @f$ c @f$ is converted to
+@f$ c / 127 @f$ for @ref Magnum::Byte "Byte" and @f$ c / 32767 @f$ for
+@ref Magnum::Short "Short", clamped to @f$ -1 @f$, which is the case for
+signed normalized attributes since OpenGL 4.2 and in OpenGL ES 3.0. Older
+versions map it to @f$ (2c + 1) / 255 @f$ or @f$ (2c + 1) / 65535 @f$, for
+which the choice isn't optimal and the error can be slightly larger.
+@see @ref packPositions(), @ref packTextureCoordinates()
+*/
+template<class T> std::vector<Math::Vector2<T>> packNormals(const std::vector<Vector3>& normals);
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+extern template MAGNUM_MESHTOOLS_EXPORT std::vector<Math::Vector2<Byte>> packNormals<Byte>(const std::vector<Vector3>&);
+extern template MAGNUM_MESHTOOLS_EXPORT std::vector<Math::Vector2<Short>> packNormals<Short>(const std::vector<Vector3>&);
+#endif
+
+/**
+@brief Unpack normal packed with @ref packNormals()
+@param packed       Packed normal converted to floating-point range
+    @f$ [-1, 1] @f$, e.g. using @ref Math::normalize()
+
+Returns normalized vector.
+*/
+Vector3 MAGNUM_MESHTOOLS_EXPORT unpackNormal(const Vector2& packed);
+
+/**
+@brief Attribute description for normals packed with @ref packNormals()
+@tparam Attribute   Two-component floating-point attribute
+@tparam T           Component type passed to @ref packNormals()
+
+Two normalized components of given type.
+*/
+template<class Attribute, class T> constexpr Attribute packedNormalAttribute() {
+    return Attribute(Attribute::Components::Two, Implementation::PackedNormalType<T>::template dataType<Attribute>(), Attribute::DataOption::Normalized);
+}
+
+/**
+@brief Pack texture coordinates into half-floats
+
+Converts the coordinates using @ref Math::packHalf(). Half-floats have 11-bit
+precision, which is enough to address texels of 2048x2048 texture exactly with
+coordinates in range @f$ [0, 1] @f$, while still allowing repeated
+textures. Use @ref packedTextureCoordinateAttribute() to describe the data to
+the mesh.
+@see @ref packPositions(), @ref packNormals()
+@requires_gl30 %Extension @extension{NV,half_float} for half-float vertex
+    attributes
+@requires_gles30 %Extension @es_extension{OES,vertex_half_float} for
+    half-float vertex attributes
+*/
+std::vector<Math::Vector2<UnsignedShort>> MAGNUM_MESHTOOLS_EXPORT packTextureCoordinates(const std::vector<Vector2>& textureCoordinates);
+
+/**
+@brief Attribute description for texture coordinates packed with @ref packTextureCoordinates()
+
+Two @ref Magnum::AbstractShaderProgram::Attribute::DataType "DataType::HalfFloat"
+components, usable e.g. with @ref Shaders::Generic3D::TextureCoordinates.
+*/
+template<class Attribute> constexpr Attribute packedTextureCoordinateAttribute() {
+    return Attribute(Attribute::Components::Two, Attribute::DataType::HalfFloat);
+}
+
+}}
+
+#endif
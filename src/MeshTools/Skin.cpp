@@ -0,0 +1,149 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Skin.h"
+
+#include <Utility/Assert.h>
+
+#include "Math/Vector4.h"
+#include "Math/Implementation/Simd.h"
+#include "MeshTools/Implementation/Parallel.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Skinning a vertex is a lot more work than transforming it, so the threads
+   pay off for smaller meshes than in transformPointsInPlace() */
+constexpr std::size_t MinVerticesPerThread = 16384;
+
+struct Skinning {
+    Containers::ArrayReference<const DualQuaternion> bones;
+    Containers::ArrayReference<const Math::Vector4<UnsignedShort>> boneIds;
+    Containers::ArrayReference<const Vector4> weights;
+    Containers::ArrayReference<const Vector3> positions;
+    Containers::ArrayReference<const Vector3> normals;
+    Containers::ArrayReference<Vector3> outPositions;
+    Containers::ArrayReference<Vector3> outNormals;
+};
+
+#if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+namespace Simd = Math::Implementation::Simd;
+
+static_assert(sizeof(DualQuaternion) == 8*sizeof(Float),
+    "dual quaternion memory layout doesn't match SIMD register");
+
+/* Weighted bone transformation, flipped to the same hemisphere as the first
+   bone. Dual quaternion is real part followed by dual part in memory. */
+inline void blend(Simd::Register& real, Simd::Register& dual, const Simd::Register firstReal, const DualQuaternion& bone, const Float weight) {
+    const Float* const data = reinterpret_cast<const Float*>(&bone);
+    const Simd::Register boneReal = Simd::load(data);
+    const Simd::Register w = Simd::flipSign(Simd::broadcast(weight), Simd::sum(Simd::multiply(firstReal, boneReal)));
+    real = Simd::add(real, Simd::multiply(w, boneReal));
+    dual = Simd::add(dual, Simd::multiply(w, Simd::load(data + 4)));
+}
+#endif
+
+/* Blended transformation of given vertex. Only the real part is normalized,
+   as the scalar part of the translation won't be used anyway. */
+inline void blendedTransformation(const Skinning& s, const std::size_t i, Quaternion& real, Quaternion& dual) {
+    const Math::Vector4<UnsignedShort>& ids = s.boneIds[i];
+    const Vector4& weights = s.weights[i];
+
+    #if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+    const Float* const first = reinterpret_cast<const Float*>(&s.bones[ids[0]]);
+    const Simd::Register firstReal = Simd::load(first);
+    const Simd::Register w = Simd::broadcast(weights[0]);
+    Simd::Register r = Simd::multiply(w, firstReal);
+    Simd::Register d = Simd::multiply(w, Simd::load(first + 4));
+    for(std::size_t j = 1; j != 4; ++j)
+        blend(r, d, firstReal, s.bones[ids[j]], weights[j]);
+
+    const Simd::Register length = Simd::squareRoot(Simd::sum(Simd::multiply(r, r)));
+    Simd::store(reinterpret_cast<Float*>(&real), Simd::divide(r, length));
+    Simd::store(reinterpret_cast<Float*>(&dual), Simd::divide(d, length));
+    #else
+    const Quaternion firstReal = s.bones[ids[0]].real();
+    real = weights[0]*firstReal;
+    dual = weights[0]*s.bones[ids[0]].dual();
+    for(std::size_t j = 1; j != 4; ++j) {
+        const DualQuaternion& bone = s.bones[ids[j]];
+        const Float w = Quaternion::dot(firstReal, bone.real()) < 0.0f ? -weights[j] : weights[j];
+        real += w*bone.real();
+        dual += w*bone.dual();
+    }
+
+    const Float length = real.length();
+    real /= length;
+    dual /= length;
+    #endif
+}
+
+void skinRange(const Skinning& s, std::size_t begin, const std::size_t end) {
+    const bool hasNormals = !s.normals.empty();
+
+    for(; begin != end; ++begin) {
+        Quaternion real, dual;
+        blendedTransformation(s, begin, real, dual);
+
+        /* Rotation expanded to v + 2r_V×(r_V×v + r_S v), translation is
+           2(d r^*)_V = 2(r_S d_V - d_S r_V + r_V×d_V) */
+        const Vector3 rv = real.vector();
+        const Float rs = real.scalar();
+        const Vector3 translation = 2.0f*(rs*dual.vector() - dual.scalar()*rv + Vector3::cross(rv, dual.vector()));
+
+        const Vector3 position = s.positions[begin];
+        s.outPositions[begin] = position + 2.0f*Vector3::cross(rv, Vector3::cross(rv, position) + rs*position) + translation;
+
+        if(hasNormals) {
+            const Vector3 normal = s.normals[begin];
+            s.outNormals[begin] = normal + 2.0f*Vector3::cross(rv, Vector3::cross(rv, normal) + rs*normal);
+        }
+    }
+}
+
+bool boneIdsInRange(const Containers::ArrayReference<const Math::Vector4<UnsignedShort>> boneIds, const std::size_t boneCount) {
+    for(const Math::Vector4<UnsignedShort>& ids: boneIds)
+        if(std::size_t(ids.max()) >= boneCount) return false;
+    return true;
+}
+
+}
+
+void skinDualQuaternions(const Containers::ArrayReference<const DualQuaternion> bones, const Containers::ArrayReference<const Math::Vector4<UnsignedShort>> boneIds, const Containers::ArrayReference<const Vector4> weights, const Containers::ArrayReference<const Vector3> positions, const Containers::ArrayReference<const Vector3> normals, const Containers::ArrayReference<Vector3> outPositions, const Containers::ArrayReference<Vector3> outNormals) {
+    CORRADE_ASSERT(weights.size() == boneIds.size() && positions.size() == boneIds.size() && outPositions.size() == boneIds.size(),
+        "MeshTools::skinDualQuaternions(): expected per-vertex arrays of the same size", );
+    CORRADE_ASSERT(normals.size() == outNormals.size() && (normals.empty() || normals.size() == boneIds.size()),
+        "MeshTools::skinDualQuaternions(): expected normal arrays to be either empty or of the same size as positions", );
+    CORRADE_ASSERT(boneIdsInRange(boneIds, bones.size()),
+        "MeshTools::skinDualQuaternions(): bone ID out of range for" << bones.size() << "bones", );
+
+    const Skinning s{bones, boneIds, weights, positions, normals, outPositions, outNormals};
+
+    Implementation::parallelFor(boneIds.size(), MinVerticesPerThread, 1, [&s](std::size_t begin, std::size_t end) {
+        skinRange(s, begin, end);
+    });
+}
+
+}}
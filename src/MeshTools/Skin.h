@@ -0,0 +1,88 @@
+#ifndef Magnum_MeshTools_Skin_h
+#define Magnum_MeshTools_Skin_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function Magnum::MeshTools::skinDualQuaternions()
+ */
+
+#include <Containers/Array.h>
+
+#include "Math/DualQuaternion.h"
+#include "Magnum.h"
+
+#include "magnumMeshToolsVisibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Skin mesh using dual quaternion linear blending
+@param bones            Bone transformations
+@param boneIds          Indices into @p bones for each vertex
+@param weights          Bone weights for each vertex
+@param positions        Vertex positions in bind pose
+@param normals          Vertex normals in bind pose
+@param[out] outPositions Skinned positions
+@param[out] outNormals  Skinned normals
+
+Each vertex is influenced by four bones. Their transformations are blended
+using dual quaternion linear blending, as described by Kavan et al. in
+*Geometric Skinning with Approximate Dual Quaternion Blending*: @f[
+     \hat q = \frac{\sum_i s_i w_i \hat q_i}{|\sum_i s_i w_i q_{0i}|} ~~~~~~~~~~
+     s_i = sign(q_{00} \cdot q_{0i})
+@f]
+where @f$ s_i @f$ flips the transformations to the same hemisphere as the
+first one, and the position and normal is then transformed with the
+resulting unit dual quaternion. Compared to linear blending of matrices this
+preserves volume around joints, without the "candy wrapper" artifacts.
+
+Expects that the transformations in @p bones are normalized (for example
+result of @ref Math::Batch::multiply() of bone transformations with their
+inverse bind pose), all bone IDs are smaller than size of @p bones and that
+the weights for each vertex have non-zero sum (unused influences can have
+zero weight). All per-vertex arrays are expected to have the same size,
+@p normals and @p outNormals can be empty if only positions are needed. The
+output arrays may be the same as input arrays. Large meshes are split across
+hardware threads. Example usage:
+@code
+std::vector<DualQuaternion> bones;
+std::vector<Math::Vector4<UnsignedShort>> boneIds;
+std::vector<Vector4> weights;
+std::vector<Vector3> positions, normals, skinnedPositions, skinnedNormals;
+
+MeshTools::skinDualQuaternions({bones.data(), bones.size()},
+    {boneIds.data(), boneIds.size()}, {weights.data(), weights.size()},
+    {positions.data(), positions.size()}, {normals.data(), normals.size()},
+    {skinnedPositions.data(), skinnedPositions.size()},
+    {skinnedNormals.data(), skinnedNormals.size()});
+@endcode
+@see @ref DualQuaternion::transformPointNormalized(),
+    @ref Math::Batch::lerpShortestPath()
+*/
+void MAGNUM_MESHTOOLS_EXPORT skinDualQuaternions(Containers::ArrayReference<const DualQuaternion> bones, Containers::ArrayReference<const Math::Vector4<UnsignedShort>> boneIds, Containers::ArrayReference<const Vector4> weights, Containers::ArrayReference<const Vector3> positions, Containers::ArrayReference<const Vector3> normals, Containers::ArrayReference<Vector3> outPositions, Containers::ArrayReference<Vector3> outNormals);
+
+}}
+
+#endif
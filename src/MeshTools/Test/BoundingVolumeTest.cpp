@@ -0,0 +1,225 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <random>
+#include <TestSuite/Tester.h>
+
+#include "Math/Functions.h"
+#include "Math/Matrix4.h"
+#include "MeshTools/BoundingVolume.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+class BoundingVolumeTest: public TestSuite::Tester {
+    public:
+        BoundingVolumeTest();
+
+        void range2D();
+        void range3D();
+        void rangeEmpty();
+        void rangeMultithreaded();
+        void sphere();
+        void sphereSinglePoint();
+        void sphereMultithreaded();
+        void orientedBox();
+        void orientedBoxFlat();
+        void orientedBoxEmpty();
+};
+
+BoundingVolumeTest::BoundingVolumeTest() {
+    addTests({&BoundingVolumeTest::range2D,
+              &BoundingVolumeTest::range3D,
+              &BoundingVolumeTest::rangeEmpty,
+              &BoundingVolumeTest::rangeMultithreaded,
+              &BoundingVolumeTest::sphere,
+              &BoundingVolumeTest::sphereSinglePoint,
+              &BoundingVolumeTest::sphereMultithreaded,
+              &BoundingVolumeTest::orientedBox,
+              &BoundingVolumeTest::orientedBoxFlat,
+              &BoundingVolumeTest::orientedBoxEmpty});
+}
+
+namespace {
+    /* Random points in a box, count not divisible by four to test the
+       remainder handling */
+    std::vector<Vector3> randomPoints(const std::size_t count) {
+        std::mt19937 generator;
+        std::uniform_real_distribution<Float> distribution(-1.0f, 1.0f);
+        std::vector<Vector3> points(count);
+        for(Vector3& point: points)
+            point = Vector3(distribution(generator), distribution(generator), distribution(generator))*Vector3(3.0f, 0.5f, 1.0f);
+        return points;
+    }
+
+    bool contains(const std::pair<Vector3, Float>& sphere, const Vector3& point) {
+        return (point - sphere.first).length() <= sphere.second*(1.0f + 1.0e-6f);
+    }
+}
+
+void BoundingVolumeTest::range2D() {
+    const std::vector<Vector2> points{
+        {1.0f, 2.0f}, {-3.0f, 0.5f}, {0.0f, 7.0f}, {2.0f, -1.0f},
+        {0.5f, 0.5f}, {4.0f, 3.0f}, {0.0f, -2.5f}};
+
+    CORRADE_COMPARE(MeshTools::boundingRange({points.data(), points.size()}),
+        Range2D({-3.0f, -2.5f}, {4.0f, 7.0f}));
+
+    /* Less than four points */
+    CORRADE_COMPARE(MeshTools::boundingRange({points.data(), 2}),
+        Range2D({-3.0f, 0.5f}, {1.0f, 2.0f}));
+}
+
+void BoundingVolumeTest::range3D() {
+    const std::vector<Vector3> points{
+        {1.0f, 2.0f, 3.0f}, {-3.0f, 0.5f, 1.0f}, {0.0f, 7.0f, -1.0f},
+        {2.0f, -1.0f, 0.0f}, {0.5f, 0.5f, 9.0f}, {4.0f, 3.0f, 2.0f},
+        {0.0f, -2.5f, 1.0f}, {1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, -4.0f}};
+
+    CORRADE_COMPARE(MeshTools::boundingRange({points.data(), points.size()}),
+        Range3D({-3.0f, -2.5f, -4.0f}, {4.0f, 7.0f, 9.0f}));
+
+    /* Extremes only in the three points after the last block of four */
+    const std::vector<Vector3> remainder{
+        {0.0f, 0.0f, 0.0f}, {1.0f, -1.0f, 0.5f}, {-1.0f, 1.0f, -0.5f},
+        {0.5f, 0.5f, 0.5f}, {-5.0f, 6.0f, 0.0f}, {0.0f, 0.0f, -7.0f},
+        {8.0f, -9.0f, 10.0f}};
+    CORRADE_COMPARE(MeshTools::boundingRange({remainder.data(), remainder.size()}),
+        Range3D({-5.0f, -9.0f, -7.0f}, {8.0f, 6.0f, 10.0f}));
+}
+
+void BoundingVolumeTest::rangeEmpty() {
+    CORRADE_COMPARE(MeshTools::boundingRange(Containers::ArrayReference<const Vector3>()), Range3D());
+    CORRADE_COMPARE(MeshTools::boundingRange(Containers::ArrayReference<const Vector2>()), Range2D());
+}
+
+void BoundingVolumeTest::rangeMultithreaded() {
+    /* Large enough to be split across threads if there is more than one
+       hardware thread */
+    std::vector<Vector3> points = randomPoints(500001);
+    points[317777] = {-5.0f, 0.0f, 0.0f};
+    points[499999] = {0.0f, 6.0f, 0.0f};
+    points[3] = {0.0f, 0.0f, 7.0f};
+
+    const Range3D range = MeshTools::boundingRange({points.data(), points.size()});
+    CORRADE_COMPARE(range.min().x(), -5.0f);
+    CORRADE_COMPARE(range.max().y(), 6.0f);
+    CORRADE_COMPARE(range.max().z(), 7.0f);
+
+    /* Verify against plain loop */
+    Vector3 min = points[0], max = points[0];
+    for(const Vector3& point: points) {
+        min = Math::min(min, point);
+        max = Math::max(max, point);
+    }
+    CORRADE_COMPARE(range, Range3D(min, max));
+}
+
+void BoundingVolumeTest::sphere() {
+    const std::vector<Vector3> points{
+        {1.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}, {0.0f, -1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, -1.0f},
+        {0.5f, 0.5f, 0.5f}};
+
+    const std::pair<Vector3, Float> sphere = MeshTools::boundingSphere({points.data(), points.size()});
+    CORRADE_COMPARE(sphere.first, Vector3());
+    CORRADE_COMPARE(sphere.second, 1.0f);
+
+    const std::vector<Vector3> random = randomPoints(1001);
+    const std::pair<Vector3, Float> randomSphere = MeshTools::boundingSphere({random.data(), random.size()});
+    for(const Vector3& point: random)
+        CORRADE_VERIFY(contains(randomSphere, point));
+
+    /* Not worse than sphere around the bounding box */
+    CORRADE_VERIFY(randomSphere.second <= Vector3(3.0f, 0.5f, 1.0f).length());
+}
+
+void BoundingVolumeTest::sphereSinglePoint() {
+    const Vector3 point{1.0f, 2.0f, 3.0f};
+    const std::pair<Vector3, Float> sphere = MeshTools::boundingSphere({&point, 1});
+    CORRADE_COMPARE(sphere.first, point);
+    CORRADE_COMPARE(sphere.second, 0.0f);
+}
+
+void BoundingVolumeTest::sphereMultithreaded() {
+    const std::vector<Vector3> points = randomPoints(500001);
+    const std::pair<Vector3, Float> sphere = MeshTools::boundingSphere({points.data(), points.size()});
+
+    std::size_t outside = 0;
+    for(const Vector3& point: points)
+        if(!contains(sphere, point)) ++outside;
+    CORRADE_COMPARE(outside, std::size_t(0));
+    CORRADE_VERIFY(sphere.second <= Vector3(3.0f, 0.5f, 1.0f).length());
+}
+
+void BoundingVolumeTest::orientedBox() {
+    /* Points in a box rotated and translated */
+    const Matrix4 transformation = Matrix4::translation({5.0f, -3.0f, 2.0f})*
+        Matrix4::rotationZ(Deg(30.0f))*Matrix4::rotationX(Deg(-45.0f));
+    std::vector<Vector3> points = randomPoints(10001);
+    for(Vector3& point: points) point = transformation.transformPoint(point);
+
+    const Matrix4 box = MeshTools::orientedBoundingBox({points.data(), points.size()});
+
+    /* Right-handed */
+    CORRADE_VERIFY(box.rotationScaling().determinant() > 0.0f);
+
+    /* All points are inside the box */
+    const Matrix4 inverted = box.inverted();
+    for(const Vector3& point: points)
+        CORRADE_VERIFY((Math::abs(inverted.transformPoint(point)) <= Vector3(1.0f + 1.0e-4f)).all());
+
+    /* Roughly matches the original box, axes sorted by extent */
+    CORRADE_VERIFY((box.translation() - transformation.translation()).length() < 0.05f);
+    CORRADE_VERIFY(Math::abs(box[0].xyz().length() - 3.0f) < 0.05f);
+    CORRADE_VERIFY(Math::abs(box[1].xyz().length() - 1.0f) < 0.05f);
+    CORRADE_VERIFY(Math::abs(box[2].xyz().length() - 0.5f) < 0.05f);
+    CORRADE_VERIFY(Math::abs(Vector3::dot(box[0].xyz().normalized(), transformation[0].xyz())) > 0.999f);
+    CORRADE_VERIFY(Math::abs(Vector3::dot(box[2].xyz().normalized(), transformation[1].xyz())) > 0.999f);
+
+    /* Tighter than the axis-aligned box */
+    const Vector3 rangeSize = MeshTools::boundingRange({points.data(), points.size()}).size();
+    CORRADE_VERIFY(8.0f*box.rotationScaling().determinant() < rangeSize.product());
+}
+
+void BoundingVolumeTest::orientedBoxFlat() {
+    /* Rectangle corners, the box has zero thickness */
+    const std::vector<Vector3> points{
+        {0.0f, 0.0f, 0.0f}, {4.0f, 0.0f, 0.0f},
+        {0.0f, 2.0f, 2.0f}, {4.0f, 2.0f, 2.0f}};
+
+    const Matrix4 box = MeshTools::orientedBoundingBox({points.data(), points.size()});
+    CORRADE_COMPARE(box.translation(), Vector3(2.0f, 1.0f, 1.0f));
+    CORRADE_COMPARE(box[0].xyz(), Vector3(2.0f, 0.0f, 0.0f));
+    CORRADE_COMPARE(Math::abs(box[1].xyz()), Vector3(0.0f, 1.0f, 1.0f));
+    CORRADE_COMPARE(box[2].xyz(), Vector3());
+}
+
+void BoundingVolumeTest::orientedBoxEmpty() {
+    CORRADE_COMPARE(MeshTools::orientedBoundingBox(nullptr), Matrix4(Matrix4::Zero));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::BoundingVolumeTest)
@@ -0,0 +1,174 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <TestSuite/Tester.h>
+
+#include "Math/Functions.h"
+#include "Math/Matrix4.h"
+#include "MeshTools/PackAttributes.h"
+#include "Shaders/Generic.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+class PackAttributesTest: public TestSuite::Tester {
+    public:
+        PackAttributesTest();
+
+        void positions();
+        void positionsOutOfRange();
+        void positionsFlatRange();
+        void normals();
+        void normalsPrecision();
+        void textureCoordinates();
+        void attributes();
+};
+
+PackAttributesTest::PackAttributesTest() {
+    addTests({&PackAttributesTest::positions,
+              &PackAttributesTest::positionsOutOfRange,
+              &PackAttributesTest::positionsFlatRange,
+              &PackAttributesTest::normals,
+              &PackAttributesTest::normalsPrecision,
+              &PackAttributesTest::textureCoordinates,
+              &PackAttributesTest::attributes});
+}
+
+void PackAttributesTest::positions() {
+    const Range3D range({-1.0f, 2.0f, 0.0f}, {3.0f, 4.0f, 10.0f});
+    const std::vector<Vector3> positions{
+        {-1.0f, 2.0f, 0.0f},
+        {3.0f, 4.0f, 10.0f},
+        {1.0f, 3.0f, 5.0f},
+        {0.1234f, 3.9f, 7.777f}};
+
+    const std::vector<Math::Vector3<UnsignedShort>> packed = MeshTools::packPositions(positions, range);
+    CORRADE_COMPARE(packed.size(), 4);
+    CORRADE_COMPARE(packed[0], Math::Vector3<UnsignedShort>(0, 0, 0));
+    CORRADE_COMPARE(packed[1], Math::Vector3<UnsignedShort>(65535, 65535, 65535));
+    CORRADE_COMPARE(packed[2], Math::Vector3<UnsignedShort>(32768, 32768, 32768));
+
+    /* Error is at most half of the quantization step */
+    const Matrix4 transformation = MeshTools::packedPositionTransformation(range);
+    const Vector3 maxError = range.size()/65535.0f/2.0f;
+    for(std::size_t i = 0; i != positions.size(); ++i) {
+        const Vector3 unpacked = transformation.transformPoint(Math::normalize<Vector3>(packed[i]));
+        CORRADE_VERIFY((Math::abs(unpacked - positions[i]) <= maxError*1.001f).all());
+    }
+}
+
+void PackAttributesTest::positionsOutOfRange() {
+    const std::vector<Math::Vector3<UnsignedShort>> packed = MeshTools::packPositions(
+        {{-2.0f, 0.5f, 7.0f}}, Range3D({}, {1.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(packed[0], Math::Vector3<UnsignedShort>(0, 32768, 65535));
+}
+
+void PackAttributesTest::positionsFlatRange() {
+    const Range3D range({0.0f, 1.0f, 0.0f}, {2.0f, 1.0f, 2.0f});
+    const std::vector<Math::Vector3<UnsignedShort>> packed = MeshTools::packPositions(
+        {{0.0f, 1.0f, 2.0f}}, range);
+    CORRADE_COMPARE(packed[0], Math::Vector3<UnsignedShort>(0, 0, 65535));
+    CORRADE_COMPARE(MeshTools::packedPositionTransformation(range).transformPoint(Math::normalize<Vector3>(packed[0])),
+        Vector3(0.0f, 1.0f, 2.0f));
+}
+
+void PackAttributesTest::normals() {
+    const std::vector<Vector3> normals{
+        Vector3::xAxis(), -Vector3::xAxis(),
+        Vector3::yAxis(), -Vector3::yAxis(),
+        Vector3::zAxis(), -Vector3::zAxis(),
+        Vector3(1.0f, -1.0f, -1.0f).normalized()};
+
+    const std::vector<Math::Vector2<Short>> packed = MeshTools::packNormals<Short>(normals);
+    CORRADE_COMPARE(packed.size(), normals.size());
+    CORRADE_COMPARE(packed[4], Math::Vector2<Short>(0, 0));
+    CORRADE_COMPARE(packed[0], Math::Vector2<Short>(32767, 0));
+    CORRADE_COMPARE(packed[3], Math::Vector2<Short>(0, -32767));
+
+    /* Axes are represented exactly */
+    for(std::size_t i = 0; i != 6; ++i)
+        CORRADE_COMPARE(MeshTools::unpackNormal(Math::normalize<Vector2>(packed[i])), normals[i]);
+
+    CORRADE_VERIFY(Vector3::dot(MeshTools::unpackNormal(Math::normalize<Vector2>(packed[6])), normals[6]) > 0.9999999f);
+}
+
+void PackAttributesTest::normalsPrecision() {
+    /* Fibonacci sphere */
+    std::vector<Vector3> normals;
+    for(std::size_t i = 0; i != 10000; ++i) {
+        const Float z = 1.0f - (2.0f*i + 1.0f)/10000.0f;
+        const Float r = std::sqrt(1.0f - z*z);
+        const Float phi = 2.399963f*i;
+        normals.push_back({r*std::cos(phi), r*std::sin(phi), z});
+    }
+
+    const std::vector<Math::Vector2<Byte>> packedByte = MeshTools::packNormals<Byte>(normals);
+    const std::vector<Math::Vector2<Short>> packedShort = MeshTools::packNormals<Short>(normals);
+
+    Float minDotByte = 1.0f, minDotShort = 1.0f;
+    for(std::size_t i = 0; i != normals.size(); ++i) {
+        minDotByte = Math::min(minDotByte, Vector3::dot(normals[i], MeshTools::unpackNormal(Math::normalize<Vector2>(packedByte[i]))));
+        minDotShort = Math::min(minDotShort, Vector3::dot(normals[i], MeshTools::unpackNormal(Math::normalize<Vector2>(packedShort[i]))));
+    }
+
+    /* cos(0.7°) and cos(0.05°), the latter limited by float precision */
+    CORRADE_VERIFY(minDotByte > 0.9999254f);
+    CORRADE_VERIFY(minDotShort > 0.9999996f);
+}
+
+void PackAttributesTest::textureCoordinates() {
+    const std::vector<Math::Vector2<UnsignedShort>> packed = MeshTools::packTextureCoordinates({
+        {0.0f, 1.0f}, {0.5f, 0.25f}, {1.0f/2048.0f, 3.0f}});
+
+    CORRADE_COMPARE(packed.size(), 3);
+    CORRADE_COMPARE(packed[0], Math::Vector2<UnsignedShort>(0x0000, 0x3c00));
+    CORRADE_COMPARE(packed[1], Math::Vector2<UnsignedShort>(0x3800, 0x3400));
+    CORRADE_COMPARE(packed[2], Math::Vector2<UnsignedShort>(0x1000, 0x4200));
+}
+
+void PackAttributesTest::attributes() {
+    typedef Shaders::Generic3D::Position Position;
+    constexpr Position position = MeshTools::packedPositionAttribute<Position>();
+    CORRADE_COMPARE(position.components(), Position::Components::Three);
+    CORRADE_COMPARE(position.dataType(), Position::DataType::UnsignedShort);
+    CORRADE_VERIFY(position.dataOptions() == Position::DataOption::Normalized);
+    CORRADE_COMPARE(position.dataSize(), 6);
+
+    typedef AbstractShaderProgram::Attribute<2, Vector2> PackedNormal;
+    constexpr PackedNormal normal = MeshTools::packedNormalAttribute<PackedNormal, Byte>();
+    CORRADE_COMPARE(normal.components(), PackedNormal::Components::Two);
+    CORRADE_COMPARE(normal.dataType(), PackedNormal::DataType::Byte);
+    CORRADE_VERIFY(normal.dataOptions() == PackedNormal::DataOption::Normalized);
+    CORRADE_COMPARE(normal.dataSize(), 2);
+    CORRADE_COMPARE((MeshTools::packedNormalAttribute<PackedNormal, Short>().dataSize()), 4);
+
+    typedef Shaders::Generic3D::TextureCoordinates TextureCoordinates;
+    constexpr TextureCoordinates textureCoordinates = MeshTools::packedTextureCoordinateAttribute<TextureCoordinates>();
+    CORRADE_COMPARE(textureCoordinates.components(), TextureCoordinates::Components::Two);
+    CORRADE_COMPARE(textureCoordinates.dataType(), TextureCoordinates::DataType::HalfFloat);
+    CORRADE_COMPARE(textureCoordinates.dataSize(), 4);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::PackAttributesTest)
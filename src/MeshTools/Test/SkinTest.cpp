@@ -0,0 +1,255 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <chrono>
+#include <sstream>
+#include <vector>
+#include <TestSuite/Tester.h>
+
+#include "Math/Vector4.h"
+#include "MeshTools/Skin.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+class SkinTest: public TestSuite::Tester {
+    public:
+        explicit SkinTest();
+
+        void singleBone();
+        void blend();
+        void blendOppositeHemisphere();
+        void noNormals();
+        void inPlace();
+        void large();
+        void invalid();
+
+        void benchmark();
+};
+
+SkinTest::SkinTest() {
+    addTests({&SkinTest::singleBone,
+              &SkinTest::blend,
+              &SkinTest::blendOppositeHemisphere,
+              &SkinTest::noNormals,
+              &SkinTest::inPlace,
+              &SkinTest::large,
+              &SkinTest::invalid,
+
+              &SkinTest::benchmark});
+}
+
+typedef Math::Vector4<UnsignedShort> Vector4us;
+
+namespace {
+    const DualQuaternion bones[] = {
+        DualQuaternion::translation({1.0f, -2.0f, 3.0f})*DualQuaternion::rotation(Deg(35.0f), Vector3::xAxis()),
+        DualQuaternion::rotation(Deg(-120.0f), Vector3(1.0f, 2.0f, -3.0f).normalized())*DualQuaternion::translation({0.5f, 0.0f, 1.5f}),
+        DualQuaternion::translation(Vector3::yAxis(4.0f))*DualQuaternion::rotation(Deg(270.0f), Vector3::zAxis()),
+        DualQuaternion::rotation(Deg(10.0f), Vector3::yAxis())
+    };
+
+    /* Blending the transformations one by one using DualQuaternion */
+    void skinReference(const std::vector<DualQuaternion>& bones, const Vector4us& ids, const Vector4& weights, const Vector3& position, const Vector3& normal, Vector3& outPosition, Vector3& outNormal) {
+        const Quaternion first = bones[ids[0]].real();
+        Quaternion real({}, 0.0f), dual({}, 0.0f);
+        for(std::size_t i = 0; i != 4; ++i) {
+            const Float weight = Quaternion::dot(first, bones[ids[i]].real()) < 0.0f ? -weights[i] : weights[i];
+            real += weight*bones[ids[i]].real();
+            dual += weight*bones[ids[i]].dual();
+        }
+
+        const DualQuaternion transformation = DualQuaternion(real, dual).normalized();
+        outPosition = transformation.transformPointNormalized(position);
+        outNormal = transformation.rotation().transformVectorNormalized(normal);
+    }
+
+    struct Mesh {
+        explicit Mesh(std::size_t count): boneIds(count), weights(count), positions(count), normals(count) {
+            for(std::size_t i = 0; i != count; ++i) {
+                boneIds[i] = Vector4us(i%4, (i + 1)%4, (i/3)%4, (i/7)%4);
+                weights[i] = Vector4(1.0f, Float(i%5), Float(i%3), 0.5f);
+                weights[i] /= weights[i].sum();
+                positions[i] = Vector3(Float(i%100)*0.1f, Float(i%7) - 3.0f, -Float(i%13));
+                normals[i] = Vector3(Float(i%3) - 1.0f, 1.0f, Float(i%5)*0.5f).normalized();
+            }
+        }
+
+        std::vector<Vector4us> boneIds;
+        std::vector<Vector4> weights;
+        std::vector<Vector3> positions, normals;
+    };
+}
+
+void SkinTest::singleBone() {
+    const Vector4us boneIds[] = {{2, 0, 0, 0}, {1, 3, 3, 3}};
+    const Vector4 weights[] = {{1.0f, 0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f, 0.0f}};
+    const Vector3 positions[] = {{1.0f, 2.0f, 3.0f}, {-0.5f, 0.0f, 4.0f}};
+    const Vector3 normals[] = {Vector3::xAxis(), Vector3(1.0f, 1.0f, 0.0f).normalized()};
+    Vector3 outPositions[2], outNormals[2];
+
+    MeshTools::skinDualQuaternions(bones, boneIds, weights, positions, normals, outPositions, outNormals);
+    CORRADE_COMPARE(outPositions[0], bones[2].transformPointNormalized(positions[0]));
+    CORRADE_COMPARE(outPositions[1], bones[1].transformPointNormalized(positions[1]));
+    CORRADE_COMPARE(outNormals[0], bones[2].rotation().transformVectorNormalized(normals[0]));
+    CORRADE_COMPARE(outNormals[1], bones[1].rotation().transformVectorNormalized(normals[1]));
+}
+
+void SkinTest::blend() {
+    const Mesh mesh(100);
+    std::vector<Vector3> outPositions(mesh.positions.size()), outNormals(mesh.normals.size());
+
+    MeshTools::skinDualQuaternions(bones, {mesh.boneIds.data(), mesh.boneIds.size()},
+        {mesh.weights.data(), mesh.weights.size()},
+        {mesh.positions.data(), mesh.positions.size()}, {mesh.normals.data(), mesh.normals.size()},
+        {outPositions.data(), outPositions.size()}, {outNormals.data(), outNormals.size()});
+
+    /* The reference is computed differently, so the results differ in a few
+       last bits */
+    const std::vector<DualQuaternion> bonesVector(bones, bones + 4);
+    Float maxPositionError = 0.0f, maxNormalError = 0.0f;
+    for(std::size_t i = 0; i != mesh.positions.size(); ++i) {
+        Vector3 position, normal;
+        skinReference(bonesVector, mesh.boneIds[i], mesh.weights[i], mesh.positions[i], mesh.normals[i], position, normal);
+        maxPositionError = std::max(maxPositionError, (outPositions[i] - position).length());
+        maxNormalError = std::max(maxNormalError, (outNormals[i] - normal).length());
+        CORRADE_COMPARE(outNormals[i].length(), 1.0f);
+    }
+    CORRADE_VERIFY(maxPositionError < 1.0e-5f);
+    CORRADE_VERIFY(maxNormalError < 1.0e-6f);
+}
+
+void SkinTest::blendOppositeHemisphere() {
+    /* Negated dual quaternion is the same transformation, blending them
+       without the sign flip would collapse the vertex to origin */
+    const DualQuaternion flippedBones[] = {bones[0], -bones[0]};
+    const Vector4us boneIds[] = {{0, 1, 0, 0}};
+    const Vector4 weights[] = {{0.5f, 0.5f, 0.0f, 0.0f}};
+    const Vector3 positions[] = {{1.0f, 2.0f, 3.0f}};
+    const Vector3 normals[] = {Vector3::zAxis()};
+    Vector3 outPositions[1], outNormals[1];
+
+    MeshTools::skinDualQuaternions(flippedBones, boneIds, weights, positions, normals, outPositions, outNormals);
+    CORRADE_COMPARE(outPositions[0], bones[0].transformPointNormalized(positions[0]));
+    CORRADE_COMPARE(outNormals[0], bones[0].rotation().transformVectorNormalized(normals[0]));
+}
+
+void SkinTest::noNormals() {
+    const Vector4us boneIds[] = {{0, 1, 2, 3}};
+    const Vector4 weights[] = {{0.25f, 0.25f, 0.25f, 0.25f}};
+    const Vector3 positions[] = {{1.0f, 2.0f, 3.0f}};
+    const Vector3 normals[] = {Vector3::zAxis()};
+    Vector3 outPositions[1], outNormals[1], outPositionsOnly[1];
+
+    MeshTools::skinDualQuaternions(bones, boneIds, weights, positions, normals, outPositions, outNormals);
+    MeshTools::skinDualQuaternions(bones, boneIds, weights, positions, nullptr, outPositionsOnly, nullptr);
+    CORRADE_COMPARE(outPositionsOnly[0], outPositions[0]);
+}
+
+void SkinTest::inPlace() {
+    Mesh mesh(100);
+    std::vector<Vector3> outPositions(mesh.positions.size()), outNormals(mesh.normals.size());
+    MeshTools::skinDualQuaternions(bones, {mesh.boneIds.data(), mesh.boneIds.size()},
+        {mesh.weights.data(), mesh.weights.size()},
+        {mesh.positions.data(), mesh.positions.size()}, {mesh.normals.data(), mesh.normals.size()},
+        {outPositions.data(), outPositions.size()}, {outNormals.data(), outNormals.size()});
+    MeshTools::skinDualQuaternions(bones, {mesh.boneIds.data(), mesh.boneIds.size()},
+        {mesh.weights.data(), mesh.weights.size()},
+        {mesh.positions.data(), mesh.positions.size()}, {mesh.normals.data(), mesh.normals.size()},
+        {mesh.positions.data(), mesh.positions.size()}, {mesh.normals.data(), mesh.normals.size()});
+
+    CORRADE_VERIFY(mesh.positions == outPositions);
+    CORRADE_VERIFY(mesh.normals == outNormals);
+}
+
+void SkinTest::large() {
+    /* Large enough to be split across threads if there is more than one
+       hardware thread */
+    const Mesh mesh(100003);
+    std::vector<Vector3> outPositions(mesh.positions.size()), outNormals(mesh.normals.size());
+
+    MeshTools::skinDualQuaternions(bones, {mesh.boneIds.data(), mesh.boneIds.size()},
+        {mesh.weights.data(), mesh.weights.size()},
+        {mesh.positions.data(), mesh.positions.size()}, {mesh.normals.data(), mesh.normals.size()},
+        {outPositions.data(), outPositions.size()}, {outNormals.data(), outNormals.size()});
+
+    /* Skinning the vertices one by one should give the same result */
+    std::size_t different = 0;
+    for(std::size_t i = 0; i != mesh.positions.size(); ++i) {
+        Vector3 position, normal;
+        MeshTools::skinDualQuaternions(bones, {&mesh.boneIds[i], 1}, {&mesh.weights[i], 1},
+            {&mesh.positions[i], 1}, {&mesh.normals[i], 1}, {&position, 1}, {&normal, 1});
+        if(position != outPositions[i] || normal != outNormals[i]) ++different;
+    }
+    CORRADE_COMPARE(different, std::size_t(0));
+}
+
+void SkinTest::invalid() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    const Vector4us boneIds[] = {{0, 1, 2, 3}, {0, 1, 4, 3}};
+    const Vector4 weights[2];
+    const Vector3 positions[2];
+    Vector3 outPositions[2];
+    Vector3 outNormals[1];
+    MeshTools::skinDualQuaternions(bones, boneIds, weights, positions, nullptr, {outPositions, 1}, nullptr);
+    MeshTools::skinDualQuaternions(bones, boneIds, weights, positions, positions, outPositions, outNormals);
+    MeshTools::skinDualQuaternions(bones, boneIds, weights, positions, nullptr, outPositions, nullptr);
+
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::skinDualQuaternions(): expected per-vertex arrays of the same size\n"
+        "MeshTools::skinDualQuaternions(): expected normal arrays to be either empty or of the same size as positions\n"
+        "MeshTools::skinDualQuaternions(): bone ID out of range for 4 bones\n");
+}
+
+void SkinTest::benchmark() {
+    const Mesh mesh(1000000);
+    const std::vector<DualQuaternion> bonesVector(bones, bones + 4);
+    std::vector<Vector3> positions(mesh.positions.size()), normals(mesh.normals.size());
+    std::vector<Vector3> batchedPositions(mesh.positions.size()), batchedNormals(mesh.normals.size());
+
+    const auto begin = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i != mesh.positions.size(); ++i)
+        skinReference(bonesVector, mesh.boneIds[i], mesh.weights[i], mesh.positions[i], mesh.normals[i], positions[i], normals[i]);
+    const auto middle = std::chrono::steady_clock::now();
+    MeshTools::skinDualQuaternions(bones, {mesh.boneIds.data(), mesh.boneIds.size()},
+        {mesh.weights.data(), mesh.weights.size()},
+        {mesh.positions.data(), mesh.positions.size()}, {mesh.normals.data(), mesh.normals.size()},
+        {batchedPositions.data(), batchedPositions.size()}, {batchedNormals.data(), batchedNormals.size()});
+    const auto end = std::chrono::steady_clock::now();
+
+    Float maxError = 0.0f;
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        maxError = std::max(maxError, (positions[i] - batchedPositions[i]).length());
+    CORRADE_VERIFY(maxError < 1.0e-5f);
+
+    Debug() << "Skinning" << positions.size() << "vertices, one by one:"
+        << std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(middle - begin).count() << "ms, batched:"
+        << std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(end - middle).count() << "ms";
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SkinTest)
@@ -23,6 +23,9 @@
 */
 
 #include <array>
+#include <chrono>
+#include <sstream>
+#include <vector>
 #include <TestSuite/Tester.h>
 
 #include "Math/Matrix3.h"
@@ -40,6 +43,17 @@ class TransformTest: public TestSuite::Tester {
 
         void transformPoints2D();
         void transformPoints3D();
+
+        void transformVectorsBatch();
+        void transformVectorsBatchSeparate();
+        void transformVectorsBatchStrided();
+        void transformPointsBatch();
+        void transformPointsBatchSeparate();
+        void transformPointsBatchStrided();
+        void transformPointsBatchLarge();
+        void transformBatchInvalid();
+
+        void benchmarkBatch();
 };
 
 TransformTest::TransformTest() {
@@ -47,7 +61,18 @@ TransformTest::TransformTest() {
               &TransformTest::transformVectors3D,
 
               &TransformTest::transformPoints2D,
-              &TransformTest::transformPoints3D});
+              &TransformTest::transformPoints3D,
+
+              &TransformTest::transformVectorsBatch,
+              &TransformTest::transformVectorsBatchSeparate,
+              &TransformTest::transformVectorsBatchStrided,
+              &TransformTest::transformPointsBatch,
+              &TransformTest::transformPointsBatchSeparate,
+              &TransformTest::transformPointsBatchStrided,
+              &TransformTest::transformPointsBatchLarge,
+              &TransformTest::transformBatchInvalid,
+
+              &TransformTest::benchmarkBatch});
 }
 
 /* GCC < 4.7 doesn't like constexpr here, don't know why */
@@ -125,6 +150,180 @@ void TransformTest::transformPoints3D() {
     CORRADE_COMPARE(quaternion, points3DRotatedTranslated);
 }
 
+namespace {
+    /* Seven points to test both whole blocks and the remainder */
+    std::vector<Vector3> batchPoints() {
+        return {{-3.0f, 4.0f, 34.0f},
+                {2.5f, -15.0f, 1.5f},
+                {0.0f, 1.0f, -2.0f},
+                {7.5f, 0.25f, 3.0f},
+                {-1.0f, -1.0f, -1.0f},
+                {12.0f, 0.5f, -8.0f},
+                {0.125f, 3.0f, 6.0f}};
+    }
+
+    /* Smaller values for comparing with quaternion transformation, which
+       rounds differently */
+    std::vector<Vector3> smallBatchPoints() {
+        std::vector<Vector3> points = batchPoints();
+        for(Vector3& point: points) point /= 64.0f;
+        return points;
+    }
+
+    const Matrix4 batchTransformation = Matrix4::translation({1.0f, -2.0f, 0.5f})*
+        Matrix4::rotation(Deg(35.0f), Vector3(1.0f, 2.0f, 3.0f).normalized())*
+        Matrix4::scaling({2.0f, 0.5f, 1.5f});
+
+    struct Vertex {
+        Vector2 textureCoordinates;
+        Vector3 position;
+        UnsignedByte padding;
+    };
+}
+
+void TransformTest::transformVectorsBatch() {
+    std::vector<Vector3> points = batchPoints();
+    MeshTools::transformVectorsInPlace(batchTransformation, {points.data(), points.size()});
+    CORRADE_COMPARE(points, MeshTools::transformVectors(batchTransformation, batchPoints()));
+
+    /* Quaternion overload */
+    const Quaternion rotation = Quaternion::rotation(Deg(35.0f), Vector3(1.0f, 2.0f, 3.0f).normalized());
+    points = smallBatchPoints();
+    MeshTools::transformVectorsInPlace(rotation, Containers::ArrayReference<Vector3>{points.data(), points.size()});
+    CORRADE_COMPARE(points, MeshTools::transformVectors(rotation, smallBatchPoints()));
+}
+
+void TransformTest::transformVectorsBatchSeparate() {
+    const std::vector<Vector3> points = batchPoints();
+    std::vector<Float> x, y, z;
+    for(const Vector3& point: points) {
+        x.push_back(point.x());
+        y.push_back(point.y());
+        z.push_back(point.z());
+    }
+
+    MeshTools::transformVectorsInPlace(batchTransformation, {x.data(), x.size()}, {y.data(), y.size()}, {z.data(), z.size()});
+
+    const std::vector<Vector3> expected = MeshTools::transformVectors(batchTransformation, points);
+    for(std::size_t i = 0; i != points.size(); ++i)
+        CORRADE_COMPARE(Vector3(x[i], y[i], z[i]), expected[i]);
+}
+
+void TransformTest::transformVectorsBatchStrided() {
+    const std::vector<Vector3> points = batchPoints();
+    std::vector<Vertex> vertices;
+    for(const Vector3& point: points)
+        vertices.push_back({{0.5f, 1.0f}, point, 0x3f});
+
+    MeshTools::transformVectorsInPlace(batchTransformation, &vertices[0].position, vertices.size(), sizeof(Vertex));
+
+    const std::vector<Vector3> expected = MeshTools::transformVectors(batchTransformation, points);
+    for(std::size_t i = 0; i != points.size(); ++i) {
+        CORRADE_COMPARE(vertices[i].position, expected[i]);
+        CORRADE_COMPARE(vertices[i].textureCoordinates, Vector2(0.5f, 1.0f));
+        CORRADE_COMPARE(vertices[i].padding, 0x3f);
+    }
+}
+
+void TransformTest::transformPointsBatch() {
+    std::vector<Vector3> points = batchPoints();
+    MeshTools::transformPointsInPlace(batchTransformation, {points.data(), points.size()});
+    CORRADE_COMPARE(points, MeshTools::transformPoints(batchTransformation, batchPoints()));
+
+    /* Dual quaternion overload */
+    const DualQuaternion transformation = DualQuaternion::translation({1.0f, -2.0f, 0.5f})*
+        DualQuaternion::rotation(Deg(35.0f), Vector3(1.0f, 2.0f, 3.0f).normalized());
+    points = smallBatchPoints();
+    MeshTools::transformPointsInPlace(transformation, Containers::ArrayReference<Vector3>{points.data(), points.size()});
+    CORRADE_COMPARE(points, MeshTools::transformPoints(transformation, smallBatchPoints()));
+}
+
+void TransformTest::transformPointsBatchSeparate() {
+    const std::vector<Vector3> points = batchPoints();
+    std::vector<Float> x, y, z;
+    for(const Vector3& point: points) {
+        x.push_back(point.x());
+        y.push_back(point.y());
+        z.push_back(point.z());
+    }
+
+    MeshTools::transformPointsInPlace(batchTransformation, {x.data(), x.size()}, {y.data(), y.size()}, {z.data(), z.size()});
+
+    const std::vector<Vector3> expected = MeshTools::transformPoints(batchTransformation, points);
+    for(std::size_t i = 0; i != points.size(); ++i)
+        CORRADE_COMPARE(Vector3(x[i], y[i], z[i]), expected[i]);
+}
+
+void TransformTest::transformPointsBatchStrided() {
+    const std::vector<Vector3> points = batchPoints();
+    std::vector<Vertex> vertices;
+    for(const Vector3& point: points)
+        vertices.push_back({{0.5f, 1.0f}, point, 0x3f});
+
+    MeshTools::transformPointsInPlace(batchTransformation, &vertices[0].position, vertices.size(), sizeof(Vertex));
+
+    const std::vector<Vector3> expected = MeshTools::transformPoints(batchTransformation, points);
+    for(std::size_t i = 0; i != points.size(); ++i) {
+        CORRADE_COMPARE(vertices[i].position, expected[i]);
+        CORRADE_COMPARE(vertices[i].textureCoordinates, Vector2(0.5f, 1.0f));
+        CORRADE_COMPARE(vertices[i].padding, 0x3f);
+    }
+}
+
+void TransformTest::transformPointsBatchLarge() {
+    /* Large enough to be split across threads if there is more than one
+       hardware thread, count not divisible by four */
+    std::vector<Vector3> points(1000003);
+    for(std::size_t i = 0; i != points.size(); ++i)
+        points[i] = Vector3(Float(i%1000), Float(i%7), -Float(i%13));
+    const std::vector<Vector3> expected = MeshTools::transformPoints(batchTransformation, points);
+
+    MeshTools::transformPointsInPlace(batchTransformation, {points.data(), points.size()});
+
+    std::size_t different = 0;
+    for(std::size_t i = 0; i != points.size(); ++i)
+        if(points[i] != expected[i]) ++different;
+    CORRADE_COMPARE(different, std::size_t(0));
+}
+
+void TransformTest::transformBatchInvalid() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    Float x[3]{}, y[3]{}, z[2]{};
+    MeshTools::transformPointsInPlace(Matrix4(), x, y, z);
+    MeshTools::transformVectorsInPlace(Matrix4(), x, y, z);
+
+    Vector3 points[2];
+    MeshTools::transformPointsInPlace(Matrix4(), points, 2, 8);
+    MeshTools::transformVectorsInPlace(Matrix4(), points, 2, 8);
+
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::transformPointsInPlace(): expected component arrays of the same size\n"
+        "MeshTools::transformVectorsInPlace(): expected component arrays of the same size\n"
+        "MeshTools::transformPointsInPlace(): expected stride at least 12 but got 8\n"
+        "MeshTools::transformVectorsInPlace(): expected stride at least 12 but got 8\n");
+}
+
+void TransformTest::benchmarkBatch() {
+    std::vector<Vector3> points(1000000);
+    for(std::size_t i = 0; i != points.size(); ++i)
+        points[i] = Vector3(Float(i%1000), Float(i%7), -Float(i%13));
+    std::vector<Vector3> batched = points;
+
+    const auto begin = std::chrono::steady_clock::now();
+    MeshTools::transformPointsInPlace(batchTransformation, points);
+    const auto middle = std::chrono::steady_clock::now();
+    MeshTools::transformPointsInPlace(batchTransformation, {batched.data(), batched.size()});
+    const auto end = std::chrono::steady_clock::now();
+
+    CORRADE_VERIFY(batched == points);
+
+    Debug() << "Transforming" << points.size() << "points, one by one:"
+        << std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(middle - begin).count() << "ms, batched:"
+        << std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(end - middle).count() << "ms";
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::TransformTest)
@@ -0,0 +1,243 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Transform.h"
+
+#include <Utility/Assert.h>
+
+#include "Math/Matrix4.h"
+#include "Math/Implementation/Simd.h"
+#include "MeshTools/Implementation/Parallel.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Points with stride between individual components and between consecutive
+   points. Covers all three layouts: array of Vector3 has component stride 4
+   and point stride 12, separate arrays have point stride 4 and each component
+   has its own pointer, interleaved data have component stride 4 and arbitrary
+   point stride. */
+struct Points {
+    char* x;
+    char* y;
+    char* z;
+    std::size_t stride;
+    std::size_t count;
+};
+
+inline Float& at(char* data, std::size_t stride, std::size_t i) {
+    return *reinterpret_cast<Float*>(data + i*stride);
+}
+
+/* Don't spawn threads for less than this, the overhead would outweigh the
+   gain */
+constexpr std::size_t MinPointsPerThread = 65536;
+
+/* Four columns with the translation zeroed for vectors */
+struct Transformation {
+    explicit Transformation(const Matrix4& matrix, bool translate) {
+        for(std::size_t col = 0; col != 3; ++col)
+            for(std::size_t row = 0; row != 3; ++row)
+                m[col][row] = matrix[col][row];
+        for(std::size_t row = 0; row != 3; ++row)
+            m[3][row] = translate ? matrix[3][row] : 0.0f;
+    }
+
+    Float m[4][3];
+};
+
+void transformScalar(const Transformation& t, const Points& points, std::size_t begin, const std::size_t end) {
+    for(; begin != end; ++begin) {
+        Float& x = at(points.x, points.stride, begin);
+        Float& y = at(points.y, points.stride, begin);
+        Float& z = at(points.z, points.stride, begin);
+        const Float px = x, py = y, pz = z;
+        x = t.m[0][0]*px + t.m[1][0]*py + t.m[2][0]*pz + t.m[3][0];
+        y = t.m[0][1]*px + t.m[1][1]*py + t.m[2][1]*pz + t.m[3][1];
+        z = t.m[0][2]*px + t.m[1][2]*py + t.m[2][2]*pz + t.m[3][2];
+    }
+}
+
+#if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+using namespace Math::Implementation::Simd;
+
+/* Four points in separate registers for each component, each output
+   component is computed for all four points at once. The operations are in
+   the same order as in the scalar code to have the same rounding. */
+void transformBlock(const Register (&m)[4][3], Register& x, Register& y, Register& z) {
+    const Register px = x, py = y, pz = z;
+    x = add(add(add(multiply(m[0][0], px), multiply(m[1][0], py)), multiply(m[2][0], pz)), m[3][0]);
+    y = add(add(add(multiply(m[0][1], px), multiply(m[1][1], py)), multiply(m[2][1], pz)), m[3][1]);
+    z = add(add(add(multiply(m[0][2], px), multiply(m[1][2], py)), multiply(m[2][2], pz)), m[3][2]);
+}
+
+void transformSimd(const Transformation& t, const Points& points, std::size_t begin, const std::size_t end) {
+    Register m[4][3];
+    for(std::size_t col = 0; col != 4; ++col)
+        for(std::size_t row = 0; row != 3; ++row)
+            m[col][row] = broadcast(t.m[col][row]);
+
+    /* Separate component arrays, direct loads */
+    if(points.stride == sizeof(Float)) {
+        Float* const x = reinterpret_cast<Float*>(points.x);
+        Float* const y = reinterpret_cast<Float*>(points.y);
+        Float* const z = reinterpret_cast<Float*>(points.z);
+        for(; begin + 4 <= end; begin += 4) {
+            Register px = load(x + begin), py = load(y + begin), pz = load(z + begin);
+            transformBlock(m, px, py, pz);
+            store(x + begin, px);
+            store(y + begin, py);
+            store(z + begin, pz);
+        }
+
+    /* Array of Vector3, four points are in three registers, shuffle them to
+       and from separate components */
+    } else if(points.stride == sizeof(Vector3) && points.y == points.x + sizeof(Float) && points.z == points.y + sizeof(Float)) {
+        Float* const data = reinterpret_cast<Float*>(points.x);
+        for(; begin + 4 <= end; begin += 4) {
+            Float* const block = data + begin*3;
+
+            #ifdef MAGNUM_MATH_SIMD_SSE
+            /* a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3 */
+            const __m128 a = _mm_loadu_ps(block);
+            const __m128 b = _mm_loadu_ps(block + 4);
+            const __m128 c = _mm_loadu_ps(block + 8);
+            /* x2 y2 x3 y3, y0 z0 y1 z1 and then separate components */
+            const __m128 x2y2x3y3 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+            const __m128 y0z0y1z1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+            __m128 px = _mm_shuffle_ps(a, x2y2x3y3, _MM_SHUFFLE(2, 0, 3, 0));
+            __m128 py = _mm_shuffle_ps(y0z0y1z1, x2y2x3y3, _MM_SHUFFLE(3, 1, 2, 0));
+            __m128 pz = _mm_shuffle_ps(y0z0y1z1, c, _MM_SHUFFLE(3, 0, 3, 1));
+
+            transformBlock(m, px, py, pz);
+
+            /* x0 x2 y0 y2, z0 z2 x1 x3, y1 y3 z1 z3 and back to interleaved */
+            const __m128 p = _mm_shuffle_ps(px, py, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 q = _mm_shuffle_ps(pz, px, _MM_SHUFFLE(3, 1, 2, 0));
+            const __m128 r = _mm_shuffle_ps(py, pz, _MM_SHUFFLE(3, 1, 3, 1));
+            _mm_storeu_ps(block,     _mm_shuffle_ps(p, q, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(block + 4, _mm_shuffle_ps(r, p, _MM_SHUFFLE(3, 1, 2, 0)));
+            _mm_storeu_ps(block + 8, _mm_shuffle_ps(q, r, _MM_SHUFFLE(3, 1, 3, 1)));
+            #else
+            float32x4x3_t p = vld3q_f32(block);
+            transformBlock(m, p.val[0], p.val[1], p.val[2]);
+            vst3q_f32(block, p);
+            #endif
+        }
+
+    /* Arbitrary stride, gather the components into registers */
+    } else for(; begin + 4 <= end; begin += 4) {
+        Float x[4], y[4], z[4];
+        for(std::size_t i = 0; i != 4; ++i) {
+            x[i] = at(points.x, points.stride, begin + i);
+            y[i] = at(points.y, points.stride, begin + i);
+            z[i] = at(points.z, points.stride, begin + i);
+        }
+
+        Register px = load(x), py = load(y), pz = load(z);
+        transformBlock(m, px, py, pz);
+        store(x, px);
+        store(y, py);
+        store(z, pz);
+
+        for(std::size_t i = 0; i != 4; ++i) {
+            at(points.x, points.stride, begin + i) = x[i];
+            at(points.y, points.stride, begin + i) = y[i];
+            at(points.z, points.stride, begin + i) = z[i];
+        }
+    }
+
+    /* Remaining points */
+    transformScalar(t, points, begin, end);
+}
+#endif
+
+void transformRange(const Transformation& t, const Points& points, const std::size_t begin, const std::size_t end) {
+    #if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+    transformSimd(t, points, begin, end);
+    #else
+    transformScalar(t, points, begin, end);
+    #endif
+}
+
+void transform(const Matrix4& matrix, const bool translate, const Points& points) {
+    const Transformation t(matrix, translate);
+
+    /* Split to ranges divisible by four so only the last one has scalar
+       remainder */
+    Implementation::parallelFor(points.count, MinPointsPerThread, 4, [&t, &points](std::size_t begin, std::size_t end) {
+        transformRange(t, points, begin, end);
+    });
+}
+
+Points arrayPoints(const Containers::ArrayReference<Vector3> points) {
+    char* const data = reinterpret_cast<char*>(points.data());
+    return {data, data + sizeof(Float), data + 2*sizeof(Float), sizeof(Vector3), points.size()};
+}
+
+Points separatePoints(const Containers::ArrayReference<Float> x, const Containers::ArrayReference<Float> y, const Containers::ArrayReference<Float> z) {
+    return {reinterpret_cast<char*>(x.data()), reinterpret_cast<char*>(y.data()), reinterpret_cast<char*>(z.data()), sizeof(Float), x.size()};
+}
+
+Points stridedPoints(void* const data, const std::size_t count, const std::size_t stride) {
+    char* const x = static_cast<char*>(data);
+    return {x, x + sizeof(Float), x + 2*sizeof(Float), stride, count};
+}
+
+}
+
+void transformVectorsInPlace(const Matrix4& matrix, const Containers::ArrayReference<Vector3> vectors) {
+    transform(matrix, false, arrayPoints(vectors));
+}
+
+void transformVectorsInPlace(const Matrix4& matrix, const Containers::ArrayReference<Float> x, const Containers::ArrayReference<Float> y, const Containers::ArrayReference<Float> z) {
+    CORRADE_ASSERT(x.size() == y.size() && x.size() == z.size(),
+        "MeshTools::transformVectorsInPlace(): expected component arrays of the same size", );
+    transform(matrix, false, separatePoints(x, y, z));
+}
+
+void transformVectorsInPlace(const Matrix4& matrix, void* const data, const std::size_t count, const std::size_t stride) {
+    CORRADE_ASSERT(stride >= sizeof(Vector3),
+        "MeshTools::transformVectorsInPlace(): expected stride at least" << sizeof(Vector3) << "but got" << stride, );
+    transform(matrix, false, stridedPoints(data, count, stride));
+}
+
+void transformPointsInPlace(const Matrix4& matrix, const Containers::ArrayReference<Vector3> points) {
+    transform(matrix, true, arrayPoints(points));
+}
+
+void transformPointsInPlace(const Matrix4& matrix, const Containers::ArrayReference<Float> x, const Containers::ArrayReference<Float> y, const Containers::ArrayReference<Float> z) {
+    CORRADE_ASSERT(x.size() == y.size() && x.size() == z.size(),
+        "MeshTools::transformPointsInPlace(): expected component arrays of the same size", );
+    transform(matrix, true, separatePoints(x, y, z));
+}
+
+void transformPointsInPlace(const Matrix4& matrix, void* const data, const std::size_t count, const std::size_t stride) {
+    CORRADE_ASSERT(stride >= sizeof(Vector3),
+        "MeshTools::transformPointsInPlace(): expected stride at least" << sizeof(Vector3) << "but got" << stride, );
+    transform(matrix, true, stridedPoints(data, count, stride));
+}
+
+}}
@@ -28,8 +28,13 @@
  * @brief Function Magnum::MeshTools::transformVectorsInPlace(), Magnum::MeshTools::transformVectors(), Magnum::MeshTools::transformPointsInPlace(), Magnum::MeshTools::transformPoints()
  */
 
+#include <Containers/Array.h>
+
 #include "Math/DualQuaternion.h"
 #include "Math/DualComplex.h"
+#include "Magnum.h"
+
+#include "magnumMeshToolsVisibility.h"
 
 namespace Magnum { namespace MeshTools {
 
@@ -75,6 +80,67 @@ template<class T, class U> void transformVectorsInPlace(const Math::Matrix4<T>&
     for(auto& vector: vectors) vector = matrix.transformVector(vector);
 }
 
+/**
+@brief Transform vectors in-place using given transformation, batched version
+@param matrix   Transformation matrix
+@param vectors  Vectors to transform
+
+Unlike the generic transformVectorsInPlace(const Math::Matrix4<T>&, U&), which
+transforms one vector at a time, this function transforms blocks of four
+vectors at once using SSE or NEON instructions if available and splits large
+arrays across all available hardware threads. The result is the same as
+transforming each vector with Matrix4::transformVector(). Useful for
+pretransforming large meshes, e.g.:
+@code
+std::vector<Vector3> positions;
+MeshTools::transformVectorsInPlace(transformation, {positions.data(), positions.size()});
+@endcode
+@see transformPointsInPlace(const Matrix4&, Containers::ArrayReference<Vector3>)
+*/
+void MAGNUM_MESHTOOLS_EXPORT transformVectorsInPlace(const Matrix4& matrix, Containers::ArrayReference<Vector3> vectors);
+
+/**
+@brief Transform vectors in-place using given transformation, batched version for separate components
+@param matrix   Transformation matrix
+@param x        X components of the vectors
+@param y        Y components of the vectors, expected to have the same size
+    as @p x
+@param z        Z components of the vectors, expected to have the same size
+    as @p x
+
+Same as transformVectorsInPlace(const Matrix4&, Containers::ArrayReference<Vector3>),
+but the vectors are stored as separate component arrays, which doesn't need
+any shuffling to be processed in SIMD registers.
+*/
+void MAGNUM_MESHTOOLS_EXPORT transformVectorsInPlace(const Matrix4& matrix, Containers::ArrayReference<Float> x, Containers::ArrayReference<Float> y, Containers::ArrayReference<Float> z);
+
+/**
+@brief Transform vectors in-place using given transformation, batched version for strided data
+@param matrix   Transformation matrix
+@param data     Pointer to the first vector
+@param count    Vector count
+@param stride   Distance between two consecutive vectors in bytes, expected
+    to be at least `sizeof(Vector3)`
+
+Same as transformVectorsInPlace(const Matrix4&, Containers::ArrayReference<Vector3>),
+but the vectors are three-component Float vectors at given stride, e.g. normals
+in interleaved vertex buffer (see MeshTools::interleave()). The data don't
+need to be aligned.
+*/
+void MAGNUM_MESHTOOLS_EXPORT transformVectorsInPlace(const Matrix4& matrix, void* data, std::size_t count, std::size_t stride);
+
+/**
+@brief Transform vectors in-place using given quaternion, batched version
+
+Expects that the quaternion is normalized. Converts the quaternion to matrix
+and calls transformVectorsInPlace(const Matrix4&, Containers::ArrayReference<Vector3>).
+*/
+inline void transformVectorsInPlace(const Quaternion& normalizedQuaternion, Containers::ArrayReference<Vector3> vectors) {
+    CORRADE_ASSERT(normalizedQuaternion.isNormalized(),
+        "MeshTools::transformVectorsInPlace(): quaternion must be normalized", );
+    transformVectorsInPlace(Matrix4::from(normalizedQuaternion.toMatrix(), {}), vectors);
+}
+
 /**
 @brief Transform vectors using given transformation
 
@@ -129,6 +195,62 @@ template<class T, class U> void transformPointsInPlace(const Math::Matrix4<T>& m
     for(auto& point: points) point = matrix.transformPoint(point);
 }
 
+/**
+@brief Transform points in-place using given transformation, batched version
+@param matrix   Transformation matrix
+@param points   Points to transform
+
+Unlike the generic transformPointsInPlace(const Math::Matrix4<T>&, U&), which
+transforms one point at a time, this function transforms blocks of four points
+at once using SSE or NEON instructions if available and splits large arrays
+across all available hardware threads. The result is the same as transforming
+each point with Matrix4::transformPoint(), i.e. without perspective division.
+@see transformVectorsInPlace(const Matrix4&, Containers::ArrayReference<Vector3>)
+*/
+void MAGNUM_MESHTOOLS_EXPORT transformPointsInPlace(const Matrix4& matrix, Containers::ArrayReference<Vector3> points);
+
+/**
+@brief Transform points in-place using given transformation, batched version for separate components
+@param matrix   Transformation matrix
+@param x        X components of the points
+@param y        Y components of the points, expected to have the same size
+    as @p x
+@param z        Z components of the points, expected to have the same size
+    as @p x
+
+Same as transformPointsInPlace(const Matrix4&, Containers::ArrayReference<Vector3>),
+but the points are stored as separate component arrays, which doesn't need any
+shuffling to be processed in SIMD registers.
+*/
+void MAGNUM_MESHTOOLS_EXPORT transformPointsInPlace(const Matrix4& matrix, Containers::ArrayReference<Float> x, Containers::ArrayReference<Float> y, Containers::ArrayReference<Float> z);
+
+/**
+@brief Transform points in-place using given transformation, batched version for strided data
+@param matrix   Transformation matrix
+@param data     Pointer to the first point
+@param count    Point count
+@param stride   Distance between two consecutive points in bytes, expected
+    to be at least `sizeof(Vector3)`
+
+Same as transformPointsInPlace(const Matrix4&, Containers::ArrayReference<Vector3>),
+but the points are three-component Float vectors at given stride, e.g.
+positions in interleaved vertex buffer (see MeshTools::interleave()). The data
+don't need to be aligned.
+*/
+void MAGNUM_MESHTOOLS_EXPORT transformPointsInPlace(const Matrix4& matrix, void* data, std::size_t count, std::size_t stride);
+
+/**
+@brief Transform points in-place using given dual quaternion, batched version
+
+Expects that the dual quaternion is normalized. Converts the dual quaternion
+to matrix and calls transformPointsInPlace(const Matrix4&, Containers::ArrayReference<Vector3>).
+*/
+inline void transformPointsInPlace(const DualQuaternion& normalizedDualQuaternion, Containers::ArrayReference<Vector3> points) {
+    CORRADE_ASSERT(normalizedDualQuaternion.isNormalized(),
+        "MeshTools::transformPointsInPlace(): dual quaternion must be normalized", );
+    transformPointsInPlace(normalizedDualQuaternion.toMatrix(), points);
+}
+
 /**
 @brief Transform points using given transformation
 
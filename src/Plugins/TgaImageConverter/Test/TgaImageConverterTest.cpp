@@ -46,6 +46,8 @@ class TgaImageConverterTest: public TestSuite::Tester {
         void wrongType();
 
         void data();
+        void dataRle();
+        void dataRleGrayscale();
 };
 
 namespace {
@@ -66,7 +68,9 @@ TgaImageConverterTest::TgaImageConverterTest() {
     addTests({&TgaImageConverterTest::wrongFormat,
               &TgaImageConverterTest::wrongType,
 
-              &TgaImageConverterTest::data});
+              &TgaImageConverterTest::data,
+              &TgaImageConverterTest::dataRle,
+              &TgaImageConverterTest::dataRleGrayscale});
 }
 
 void TgaImageConverterTest::wrongFormat() {
@@ -110,6 +114,56 @@ void TgaImageConverterTest::data() {
                     std::string(reinterpret_cast<const char*>(original.data()), 2*3*3));
 }
 
+void TgaImageConverterTest::dataRle() {
+    const auto data = TgaImageConverter().setCompression(TgaImageConverter::Compression::Rle).exportToData(original);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data[2], 10);
+
+    TgaImporter importer;
+    CORRADE_VERIFY(importer.openData(data));
+    std::optional<Trade::ImageData2D> converted = importer.image2D(0);
+    CORRADE_VERIFY(converted);
+
+    CORRADE_COMPARE(converted->size(), Vector2i(2, 3));
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(converted->format(), ColorFormat::BGR);
+    #else
+    CORRADE_COMPARE(converted->format(), ColorFormat::RGB);
+    #endif
+    CORRADE_COMPARE(converted->type(), ColorType::UnsignedByte);
+    CORRADE_COMPARE(std::string(reinterpret_cast<const char*>(converted->data()), 2*3*3),
+                    std::string(reinterpret_cast<const char*>(original.data()), 2*3*3));
+}
+
+void TgaImageConverterTest::dataRleGrayscale() {
+    const char pixels[] = {
+        1, 1, 1, 1, 2, 3, 4, 4, 5, 6,
+        7, 7, 7, 7, 7, 7, 7, 7, 7, 7
+    };
+    const ImageReference2D image(ColorFormat::Red, ColorType::UnsignedByte, {10, 2}, pixels);
+
+    const auto data = TgaImageConverter().setCompression(TgaImageConverter::Compression::Rle).exportToData(image);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data[2], 11);
+
+    /* Runs of repeated pixels are packed, packets don't cross scanlines */
+    const char compressed[] = {
+        char(0x83), 1, 0x01, 2, 3, char(0x81), 4, 0x01, 5, 6,
+        char(0x89), 7
+    };
+    CORRADE_COMPARE(data.size(), 18 + sizeof(compressed));
+    CORRADE_COMPARE(std::string(reinterpret_cast<const char*>(data.begin()) + 18, data.size() - 18),
+                    std::string(compressed, sizeof(compressed)));
+
+    TgaImporter importer;
+    CORRADE_VERIFY(importer.openData(data));
+    std::optional<Trade::ImageData2D> converted = importer.image2D(0);
+    CORRADE_VERIFY(converted);
+    CORRADE_COMPARE(converted->size(), Vector2i(10, 2));
+    CORRADE_COMPARE(std::string(reinterpret_cast<const char*>(converted->data()), 10*2),
+                    std::string(pixels, 10*2));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImageConverterTest)
@@ -24,6 +24,7 @@
 
 #include "TgaImageConverter.h"
 
+#include <cstring>
 #include <fstream>
 #include <tuple>
 
@@ -34,18 +35,65 @@
 #include "Image.h"
 
 #ifdef MAGNUM_TARGET_GLES
-#include <algorithm>
-#include "Math/Swizzle.h"
-#include "Math/Vector4.h"
+#include "Trade/PixelConversion.h"
 #endif
 
 #include "TgaImporter/TgaHeader.h"
 
 namespace Magnum { namespace Trade {
 
-TgaImageConverter::TgaImageConverter() = default;
+namespace {
 
-TgaImageConverter::TgaImageConverter(PluginManager::AbstractManager& manager, std::string plugin): AbstractImageConverter(manager, std::move(plugin)) {}
+#ifdef MAGNUM_TARGET_GLES
+void swizzle(const ColorFormat format, const unsigned char* const in, const std::size_t size, unsigned char* const out) {
+    if(format == ColorFormat::RGB)
+        swizzleBgrToRgb({in, size}, {out, size});
+    else if(format == ColorFormat::RGBA)
+        swizzleBgraToRgba({in, size}, {out, size});
+}
+#endif
+
+/* Encodes one scanline into RLE packets, returns end of the output */
+unsigned char* encodeRle(const unsigned char* in, const std::size_t width, const std::size_t pixelSize, unsigned char* out) {
+    const unsigned char* const end = in + width*pixelSize;
+    while(in != end) {
+        /* Count repeated pixels, at most 128 fit into one packet */
+        const unsigned char* next = in + pixelSize;
+        std::size_t count = 1;
+        while(next != end && count != 128 && std::memcmp(next, in, pixelSize) == 0) {
+            next += pixelSize;
+            ++count;
+        }
+
+        /* Run-length packet with single pixel */
+        if(count != 1) {
+            *out++ = 0x80|(count - 1);
+            std::memcpy(out, in, pixelSize);
+            out += pixelSize;
+
+        /* Raw packet until the next run of repeated pixels */
+        } else {
+            while(next != end && count != 128 && (next + pixelSize == end || std::memcmp(next, next + pixelSize, pixelSize) != 0)) {
+                next += pixelSize;
+                ++count;
+            }
+
+            *out++ = count - 1;
+            std::memcpy(out, in, count*pixelSize);
+            out += count*pixelSize;
+        }
+
+        in = next;
+    }
+
+    return out;
+}
+
+}
+
+TgaImageConverter::TgaImageConverter(): _compression(Compression::None) {}
+
+TgaImageConverter::TgaImageConverter(PluginManager::AbstractManager& manager, std::string plugin): AbstractImageConverter(manager, std::move(plugin)), _compression(Compression::None) {}
 
 auto TgaImageConverter::doFeatures() const -> Features { return Feature::ConvertData; }
 
@@ -69,32 +117,52 @@ Containers::Array<unsigned char> TgaImageConverter::doExportToData(const ImageRe
         return nullptr;
     }
 
-    /* Initialize data buffer */
-    const auto pixelSize = UnsignedByte(image.pixelSize());
-    auto data = Containers::Array<unsigned char>::zeroInitialized(sizeof(TgaHeader) + pixelSize*image.size().product());
-
     /* Fill header */
-    auto header = reinterpret_cast<TgaHeader*>(data.begin());
-    header->imageType = image.format() == ColorFormat::Red ? 3 : 2;
-    header->bpp = pixelSize*8;
-    header->width = UnsignedShort(Utility::Endianness::littleEndian(image.size().x()));
-    header->height = UnsignedShort(Utility::Endianness::littleEndian(image.size().y()));
-
-    /* Fill data */
-    std::copy(image.data(), image.data()+pixelSize*image.size().product(), data.begin()+sizeof(TgaHeader));
+    const auto pixelSize = UnsignedByte(image.pixelSize());
+    TgaHeader header{};
+    header.imageType = (image.format() == ColorFormat::Red ? 3 : 2) | (_compression == Compression::Rle ? 8 : 0);
+    header.bpp = pixelSize*8;
+    header.width = UnsignedShort(Utility::Endianness::littleEndian(image.size().x()));
+    header.height = UnsignedShort(Utility::Endianness::littleEndian(image.size().y()));
+
+    /* Uncompressed data, convert them while copying */
+    const std::size_t dataSize = pixelSize*image.size().product();
+    if(_compression == Compression::None) {
+        Containers::Array<unsigned char> data(sizeof(TgaHeader) + dataSize);
+        std::memcpy(data.begin(), &header, sizeof(TgaHeader));
+
+        #ifdef MAGNUM_TARGET_GLES
+        if(image.format() == ColorFormat::RGB || image.format() == ColorFormat::RGBA)
+            swizzle(image.format(), image.data(), dataSize, data.begin()+sizeof(TgaHeader));
+        else
+        #endif
+        {
+            std::copy(image.data(), image.data()+dataSize, data.begin()+sizeof(TgaHeader));
+        }
+
+        return std::move(data);
+    }
 
+    const unsigned char* pixels = image.data();
     #ifdef MAGNUM_TARGET_GLES
-    if(image.format() == ColorFormat::RGB) {
-        auto pixels = reinterpret_cast<Math::Vector3<UnsignedByte>*>(data.begin()+sizeof(TgaHeader));
-        std::transform(pixels, pixels + image.size().product(), pixels,
-            [](Math::Vector3<UnsignedByte> pixel) { return Math::swizzle<'b', 'g', 'r'>(pixel); });
-    } else if(image.format() == ColorFormat::RGBA) {
-        auto pixels = reinterpret_cast<Math::Vector4<UnsignedByte>*>(data.begin()+sizeof(TgaHeader));
-        std::transform(pixels, pixels + image.size().product(), pixels,
-            [](Math::Vector4<UnsignedByte> pixel) { return Math::swizzle<'b', 'g', 'r', 'a'>(pixel); });
+    Containers::Array<unsigned char> converted;
+    if(image.format() == ColorFormat::RGB || image.format() == ColorFormat::RGBA) {
+        converted = Containers::Array<unsigned char>(dataSize);
+        swizzle(image.format(), image.data(), dataSize, converted.begin());
+        pixels = converted.begin();
     }
     #endif
 
+    /* Compress the data scanline by scanline into buffer large enough for the
+       worst case, i.e. one packet per pixel, and then copy to the output */
+    Containers::Array<unsigned char> compressed(dataSize + image.size().product());
+    unsigned char* out = compressed.begin();
+    for(Int y = 0; y != image.size().y(); ++y)
+        out = encodeRle(pixels + y*image.size().x()*pixelSize, image.size().x(), pixelSize, out);
+
+    Containers::Array<unsigned char> data(sizeof(TgaHeader) + (out - compressed.begin()));
+    std::memcpy(data.begin(), &header, sizeof(TgaHeader));
+    std::copy(compressed.begin(), out, data.begin()+sizeof(TgaHeader));
     return std::move(data);
 }
 
@@ -49,7 +49,9 @@ namespace Magnum { namespace Trade {
 @brief TGA image converter plugin
 
 Supports images with format @ref ColorFormat::BGR, @ref ColorFormat::BGRA or
-@ref ColorFormat::Red and type @ref ColorType::UnsignedByte.
+@ref ColorFormat::Red and type @ref ColorType::UnsignedByte. The output is
+uncompressed by default, use @ref setCompression() to produce RLE-compressed
+files.
 
 This plugin is built if `WITH_TGAIMAGECONVERTER` is enabled when building
 %Magnum. To use dynamic plugin, you need to load `%TgaImageConverter` plugin
@@ -61,15 +63,46 @@ component of `%Magnum` package in CMake and link to
 */
 class MAGNUM_TRADE_TGAIMAGECONVERTER_EXPORT TgaImageConverter: public AbstractImageConverter {
     public:
+        /**
+         * @brief Output compression
+         *
+         * @see @ref setCompression()
+         */
+        enum class Compression: UnsignedByte {
+            None,   /**< Uncompressed output */
+
+            /**
+             * Run-length encoded output. Packets don't cross scanline
+             * boundaries.
+             */
+            Rle
+        };
+
         /** @brief Default constructor */
         explicit TgaImageConverter();
 
         /** @brief Plugin manager constructor */
         explicit TgaImageConverter(PluginManager::AbstractManager& manager, std::string plugin);
 
+        /** @brief Output compression */
+        Compression compression() const { return _compression; }
+
+        /**
+         * @brief Set output compression
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref Compression::None.
+         */
+        TgaImageConverter& setCompression(Compression compression) {
+            _compression = compression;
+            return *this;
+        }
+
     private:
         Features MAGNUM_TRADE_TGAIMAGECONVERTER_LOCAL doFeatures() const override;
         Containers::Array<unsigned char> MAGNUM_TRADE_TGAIMAGECONVERTER_LOCAL doExportToData(const ImageReference2D& image) const override;
+
+        Compression _compression;
 };
 
 }}
@@ -41,8 +41,9 @@ class TgaImporterTest: public TestSuite::Tester {
 
         void openNonexistent();
         void openShort();
-        void paletted();
-        void compressed();
+        void unsupportedType();
+        void palettedWithoutColorMap();
+        void colorMapBits16();
 
         void colorBits16();
         void colorBits24();
@@ -51,14 +52,27 @@ class TgaImporterTest: public TestSuite::Tester {
         void grayscaleBits8();
         void grayscaleBits16();
 
+        void paletted();
+        void compressedColorBits24();
+        void compressedGrayscale();
+        void compressedPaletted();
+        void compressedTooShort();
+        void compressedOverflow();
+
+        void dataTooShort();
+        void identificationField();
+
         void file();
+        void reference();
+        void referenceCompressed();
 };
 
 TgaImporterTest::TgaImporterTest() {
     addTests({&TgaImporterTest::openNonexistent,
               &TgaImporterTest::openShort,
-              &TgaImporterTest::paletted,
-              &TgaImporterTest::compressed,
+              &TgaImporterTest::unsupportedType,
+              &TgaImporterTest::palettedWithoutColorMap,
+              &TgaImporterTest::colorMapBits16,
 
               &TgaImporterTest::colorBits16,
               &TgaImporterTest::colorBits24,
@@ -67,7 +81,19 @@ TgaImporterTest::TgaImporterTest() {
               &TgaImporterTest::grayscaleBits8,
               &TgaImporterTest::grayscaleBits16,
 
-              &TgaImporterTest::file});
+              &TgaImporterTest::paletted,
+              &TgaImporterTest::compressedColorBits24,
+              &TgaImporterTest::compressedGrayscale,
+              &TgaImporterTest::compressedPaletted,
+              &TgaImporterTest::compressedTooShort,
+              &TgaImporterTest::compressedOverflow,
+
+              &TgaImporterTest::dataTooShort,
+              &TgaImporterTest::identificationField,
+
+              &TgaImporterTest::file,
+              &TgaImporterTest::reference,
+              &TgaImporterTest::referenceCompressed});
 }
 
 void TgaImporterTest::openNonexistent() {
@@ -90,26 +116,37 @@ void TgaImporterTest::openShort() {
     CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): the file is too short: 17 bytes\n");
 }
 
-void TgaImporterTest::paletted() {
+void TgaImporterTest::unsupportedType() {
+    TgaImporter importer;
+    const unsigned char data[] = { 0, 0, 32, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    CORRADE_VERIFY(importer.openData(data));
+
+    std::ostringstream debug;
+    Error::setOutput(&debug);
+    CORRADE_VERIFY(!importer.image2D(0));
+    CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): unsupported image type: 32\n");
+}
+
+void TgaImporterTest::palettedWithoutColorMap() {
     TgaImporter importer;
-    const unsigned char data[] = { 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    const unsigned char data[] = { 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 8, 0 };
     CORRADE_VERIFY(importer.openData(data));
 
     std::ostringstream debug;
     Error::setOutput(&debug);
     CORRADE_VERIFY(!importer.image2D(0));
-    CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): paletted files are not supported\n");
+    CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): paletted image without color map\n");
 }
 
-void TgaImporterTest::compressed() {
+void TgaImporterTest::colorMapBits16() {
     TgaImporter importer;
-    const unsigned char data[] = { 0, 0, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    const unsigned char data[] = { 0, 1, 1, 0, 0, 0, 0, 16, 0, 0, 0, 0, 0, 0, 0, 0, 8, 0 };
     CORRADE_VERIFY(importer.openData(data));
 
     std::ostringstream debug;
     Error::setOutput(&debug);
     CORRADE_VERIFY(!importer.image2D(0));
-    CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): unsupported (compressed?) image type: 9\n");
+    CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): unsupported color map bits-per-pixel: 16\n");
 }
 
 void TgaImporterTest::colorBits16() {
@@ -219,6 +256,188 @@ void TgaImporterTest::grayscaleBits16() {
     CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): unsupported grayscale bits-per-pixel: 16\n");
 }
 
+void TgaImporterTest::paletted() {
+    TgaImporter importer;
+    const unsigned char data[] = {
+        0, 1, 1, 1, 0, 2, 0, 24, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        1, 2, 3, 4, 5, 6,
+        1, 2,
+        2, 1,
+        0, 2
+    };
+    #ifndef MAGNUM_TARGET_GLES
+    const char pixels[] = {
+        1, 2, 3, 4, 5, 6,
+        4, 5, 6, 1, 2, 3,
+        0, 0, 0, 4, 5, 6
+    };
+    #else
+    const char pixels[] = {
+        3, 2, 1, 6, 5, 4,
+        6, 5, 4, 3, 2, 1,
+        0, 0, 0, 6, 5, 4
+    };
+    #endif
+    CORRADE_VERIFY(importer.openData(data));
+
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(image->format(), ColorFormat::BGR);
+    #else
+    CORRADE_COMPARE(image->format(), ColorFormat::RGB);
+    #endif
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE(image->type(), ColorType::UnsignedByte);
+    CORRADE_COMPARE(std::string(reinterpret_cast<const char*>(image->data()), 2*3*3), std::string(pixels, 2*3*3));
+}
+
+void TgaImporterTest::compressedColorBits24() {
+    TgaImporter importer;
+    const unsigned char data[] = {
+        0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 0, 3, 0, 24, 0,
+        0x80|19, 1, 2, 3,
+        0x00, 4, 5, 6
+    };
+    std::string pixels;
+    #ifndef MAGNUM_TARGET_GLES
+    for(std::size_t i = 0; i != 20; ++i) pixels += "\x01\x02\x03";
+    pixels += "\x04\x05\x06";
+    #else
+    for(std::size_t i = 0; i != 20; ++i) pixels += "\x03\x02\x01";
+    pixels += "\x06\x05\x04";
+    #endif
+    CORRADE_VERIFY(importer.openData(data));
+
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(image->format(), ColorFormat::BGR);
+    #else
+    CORRADE_COMPARE(image->format(), ColorFormat::RGB);
+    #endif
+    CORRADE_COMPARE(image->size(), Vector2i(7, 3));
+    CORRADE_COMPARE(image->type(), ColorType::UnsignedByte);
+    CORRADE_COMPARE(std::string(reinterpret_cast<const char*>(image->data()), 7*3*3), pixels);
+}
+
+void TgaImporterTest::compressedGrayscale() {
+    TgaImporter importer;
+    const unsigned char data[] = {
+        0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        0x82, 7,
+        0x02, 1, 2, 3
+    };
+    const char pixels[] = { 7, 7, 7, 1, 2, 3 };
+    CORRADE_VERIFY(importer.openData(data));
+
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(image->format(), ColorFormat::Red);
+    #else
+    CORRADE_COMPARE(image->format(), ColorFormat::Luminance);
+    #endif
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE(image->type(), ColorType::UnsignedByte);
+    CORRADE_COMPARE(std::string(reinterpret_cast<const char*>(image->data()), 2*3), std::string(pixels, 2*3));
+}
+
+void TgaImporterTest::compressedPaletted() {
+    TgaImporter importer;
+    const unsigned char data[] = {
+        0, 1, 9, 0, 0, 2, 0, 32, 0, 0, 0, 0, 4, 0, 2, 0, 8, 0,
+        1, 2, 3, 4, 5, 6, 7, 8,
+        0x84, 0,
+        0x02, 1, 0, 1
+    };
+    #ifndef MAGNUM_TARGET_GLES
+    const char pixels[] = {
+        1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4,
+        1, 2, 3, 4, 5, 6, 7, 8, 1, 2, 3, 4, 5, 6, 7, 8
+    };
+    #else
+    const char pixels[] = {
+        3, 2, 1, 4, 3, 2, 1, 4, 3, 2, 1, 4, 3, 2, 1, 4,
+        3, 2, 1, 4, 7, 6, 5, 8, 3, 2, 1, 4, 7, 6, 5, 8
+    };
+    #endif
+    CORRADE_VERIFY(importer.openData(data));
+
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(image->format(), ColorFormat::BGRA);
+    #else
+    CORRADE_COMPARE(image->format(), ColorFormat::RGBA);
+    #endif
+    CORRADE_COMPARE(image->size(), Vector2i(4, 2));
+    CORRADE_COMPARE(image->type(), ColorType::UnsignedByte);
+    CORRADE_COMPARE(std::string(reinterpret_cast<const char*>(image->data()), 4*2*4), std::string(pixels, 4*2*4));
+}
+
+void TgaImporterTest::compressedTooShort() {
+    TgaImporter importer;
+    const unsigned char data[] = {
+        0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 24, 0,
+        0x05, 1, 2, 3
+    };
+    CORRADE_VERIFY(importer.openData(data));
+
+    std::ostringstream debug;
+    Error::setOutput(&debug);
+    CORRADE_VERIFY(!importer.image2D(0));
+    CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): RLE data are too short\n");
+}
+
+void TgaImporterTest::compressedOverflow() {
+    TgaImporter importer;
+    const unsigned char data[] = {
+        0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        0x86, 5
+    };
+    CORRADE_VERIFY(importer.openData(data));
+
+    std::ostringstream debug;
+    Error::setOutput(&debug);
+    CORRADE_VERIFY(!importer.image2D(0));
+    CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): RLE packet overflows the image\n");
+}
+
+void TgaImporterTest::dataTooShort() {
+    TgaImporter importer;
+    const unsigned char data[] = {
+        0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        1, 2,
+        3, 4,
+        5
+    };
+    CORRADE_VERIFY(importer.openData(data));
+
+    std::ostringstream debug;
+    Error::setOutput(&debug);
+    CORRADE_VERIFY(!importer.image2D(0));
+    CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): the file is too short, expected 24 bytes but got 23\n");
+}
+
+void TgaImporterTest::identificationField() {
+    TgaImporter importer;
+    const unsigned char data[] = {
+        3, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        'h', 'e', 'y',
+        1, 2,
+        3, 4,
+        5, 6
+    };
+    CORRADE_VERIFY(importer.openData(data));
+
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE(std::string(reinterpret_cast<const char*>(image->data()), 2*3),
+                    std::string(reinterpret_cast<const char*>(data) + 21, 2*3));
+}
+
 void TgaImporterTest::file() {
     TgaImporter importer;
     const unsigned char data[] = {
@@ -242,6 +461,50 @@ void TgaImporterTest::file() {
                     std::string(reinterpret_cast<const char*>(data) + 18, 2*3));
 }
 
+void TgaImporterTest::reference() {
+    TgaImporter importer;
+    const unsigned char data[] = {
+        0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        1, 2,
+        3, 4,
+        5, 6
+    };
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(TGAIMPORTER_TEST_DIR, "file.tga")));
+
+    std::optional<ImageReference2D> image = importer.image2DReference(0);
+    CORRADE_VERIFY(image);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(image->format(), ColorFormat::Red);
+    #else
+    CORRADE_COMPARE(image->format(), ColorFormat::Luminance);
+    #endif
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE(image->type(), ColorType::UnsignedByte);
+    CORRADE_COMPARE(std::string(reinterpret_cast<const char*>(image->data()), 2*3),
+                    std::string(reinterpret_cast<const char*>(data) + 18, 2*3));
+
+    /* Returned data are the same as if copied */
+    std::optional<Trade::ImageData2D> copy = importer.image2D(0);
+    CORRADE_VERIFY(copy);
+    CORRADE_VERIFY(copy->data() != image->data());
+    CORRADE_COMPARE(std::string(reinterpret_cast<const char*>(copy->data()), 2*3),
+                    std::string(reinterpret_cast<const char*>(image->data()), 2*3));
+}
+
+void TgaImporterTest::referenceCompressed() {
+    TgaImporter importer;
+    const unsigned char data[] = {
+        0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        0x85, 1
+    };
+    CORRADE_VERIFY(importer.openData(data));
+
+    std::ostringstream debug;
+    Error::setOutput(&debug);
+    CORRADE_VERIFY(!importer.image2DReference(0));
+    CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2DReference(): compressed and paletted data need to be decoded, use image2D() instead\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImporterTest)
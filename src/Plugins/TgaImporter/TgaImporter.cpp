@@ -24,18 +24,18 @@
 
 #include "TgaImporter.h"
 
-#include <fstream>
-#include <sstream>
+#include <algorithm>
+#include <cstring>
+#include <Utility/Assert.h>
 #include <Utility/Endianness.h>
 #include <Containers/Array.h>
 
 #include "ColorFormat.h"
 #include "Trade/ImageData.h"
+#include "Implementation/MappedFile.h"
 
 #ifdef MAGNUM_TARGET_GLES
-#include <algorithm>
-#include "Math/Swizzle.h"
-#include "Math/Vector4.h"
+#include "Trade/PixelConversion.h"
 #include "Context.h"
 #include "Extensions.h"
 #endif
@@ -44,119 +44,332 @@
 
 namespace Magnum { namespace Trade {
 
-TgaImporter::TgaImporter(): in(nullptr) {}
-
-TgaImporter::TgaImporter(PluginManager::AbstractManager& manager, std::string plugin): AbstractImporter(manager, std::move(plugin)), in(nullptr) {}
-
-TgaImporter::~TgaImporter() { close(); }
-
-auto TgaImporter::doFeatures() const -> Features { return Feature::OpenData; }
-
-bool TgaImporter::doIsOpened() const { return in; }
-
-void TgaImporter::doOpenData(const Containers::ArrayReference<const unsigned char> data) {
-    in = new std::istringstream(std::string(reinterpret_cast<const char*>(data.begin()), data.size()));
-}
-
-void TgaImporter::doOpenFile(const std::string& filename) {
-    in = new std::ifstream(filename);
-    if(in->good()) return;
+namespace {
 
-    Error() << "Trade::TgaImporter::openFile(): cannot open file" << filename;
-    close();
-}
-
-void TgaImporter::doClose() {
-    delete in;
-    in = nullptr;
+/* Parsed header with references to the pixel data and color map */
+struct Info {
+    ColorFormat format;
+    Vector2i size;
+    bool compressed;
+    /* Size of stored pixel, index size for paletted images */
+    std::size_t pixelSize;
+    /* Size of color map entry, zero if the image is not paletted */
+    std::size_t paletteEntrySize;
+    Containers::ArrayReference<const unsigned char> palette;
+    UnsignedShort paletteStart;
+    /* Pixel data to the end of the file */
+    Containers::ArrayReference<const unsigned char> data;
+};
+
+ColorFormat colorFormat(const UnsignedByte bpp) {
+    #ifndef MAGNUM_TARGET_GLES
+    return bpp == 24 ? ColorFormat::BGR : ColorFormat::BGRA;
+    #else
+    return bpp == 24 ? ColorFormat::RGB : ColorFormat::RGBA;
+    #endif
 }
 
-UnsignedInt TgaImporter::doImage2DCount() const { return 1; }
-
-std::optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt) {
+std::optional<Info> parse(const Containers::ArrayReference<const unsigned char> in, const char* const prefix) {
     /* Check if the file is long enough */
-    in->seekg(0, std::istream::end);
-    std::streampos filesize = in->tellg();
-    in->seekg(0, std::istream::beg);
-    if(filesize < std::streampos(sizeof(TgaHeader))) {
-        Error() << "Trade::TgaImporter::image2D(): the file is too short:" << filesize << "bytes";
+    if(in.size() < sizeof(TgaHeader)) {
+        Error() << prefix << "the file is too short:" << in.size() << "bytes";
         return std::nullopt;
     }
 
-    TgaHeader header;
-    in->read(reinterpret_cast<char*>(&header), sizeof(TgaHeader));
+    TgaHeader header(*reinterpret_cast<const TgaHeader*>(in.begin()));
 
     /* Convert to machine endian */
+    header.colorMapStart = Utility::Endianness::littleEndian(header.colorMapStart);
+    header.colorMapLength = Utility::Endianness::littleEndian(header.colorMapLength);
     header.width = Utility::Endianness::littleEndian(header.width);
     header.height = Utility::Endianness::littleEndian(header.height);
 
-    /* Image format */
-    ColorFormat format;
-    if(header.colorMapType != 0) {
-        Error() << "Trade::TgaImporter::image2D(): paletted files are not supported";
+    Info info;
+    info.size = {header.width, header.height};
+    info.compressed = header.imageType & 8;
+    info.paletteEntrySize = 0;
+    info.paletteStart = header.colorMapStart;
+
+    /* Color map, if present, is between identification field and pixel data */
+    if(header.colorMapType > 1) {
+        Error() << prefix << "unsupported color map type:" << header.colorMapType;
         return std::nullopt;
     }
+    std::size_t offset = sizeof(TgaHeader) + header.identsize;
+    std::size_t paletteSize = 0;
+    if(header.colorMapType == 1) {
+        if(header.colorMapBpp != 24 && header.colorMapBpp != 32) {
+            Error() << prefix << "unsupported color map bits-per-pixel:" << header.colorMapBpp;
+            return std::nullopt;
+        }
+        paletteSize = std::size_t(header.colorMapLength)*header.colorMapBpp/8;
+    }
+
+    /* Paletted */
+    if((header.imageType & ~8) == 1) {
+        if(header.colorMapType != 1) {
+            Error() << prefix << "paletted image without color map";
+            return std::nullopt;
+        }
+        if(header.bpp != 8) {
+            Error() << prefix << "unsupported color map index bits-per-pixel:" << header.bpp;
+            return std::nullopt;
+        }
+        info.format = colorFormat(header.colorMapBpp);
+        info.paletteEntrySize = header.colorMapBpp/8;
 
     /* Color */
-    if(header.imageType == 2) {
-        switch(header.bpp) {
-            case 24:
-                #ifndef MAGNUM_TARGET_GLES
-                format = ColorFormat::BGR;
-                #else
-                format = ColorFormat::RGB;
-                #endif
-                break;
-            case 32:
-                #ifndef MAGNUM_TARGET_GLES
-                format = ColorFormat::BGRA;
-                #else
-                format = ColorFormat::RGBA;
-                #endif
-                break;
-            default:
-                Error() << "Trade::TgaImporter::image2D(): unsupported color bits-per-pixel:" << header.bpp;
-                return std::nullopt;
+    } else if((header.imageType & ~8) == 2) {
+        if(header.bpp != 24 && header.bpp != 32) {
+            Error() << prefix << "unsupported color bits-per-pixel:" << header.bpp;
+            return std::nullopt;
         }
+        info.format = colorFormat(header.bpp);
 
     /* Grayscale */
-    } else if(header.imageType == 3) {
+    } else if((header.imageType & ~8) == 3) {
         #ifdef MAGNUM_TARGET_GLES2
-        format = Context::current() && Context::current()->isExtensionSupported<Extensions::GL::EXT::texture_rg>() ?
+        info.format = Context::current() && Context::current()->isExtensionSupported<Extensions::GL::EXT::texture_rg>() ?
             ColorFormat::Red : ColorFormat::Luminance;
         #else
-        format = ColorFormat::Red;
+        info.format = ColorFormat::Red;
         #endif
         if(header.bpp != 8) {
-            Error() << "Trade::TgaImporter::image2D(): unsupported grayscale bits-per-pixel:" << header.bpp;
+            Error() << prefix << "unsupported grayscale bits-per-pixel:" << header.bpp;
             return std::nullopt;
         }
 
-    /* Compressed files */
+    /* Huffman-compressed and other exotic files */
     } else {
-        Error() << "Trade::TgaImporter::image2D(): unsupported (compressed?) image type:" << header.imageType;
+        Error() << prefix << "unsupported image type:" << header.imageType;
+        return std::nullopt;
+    }
+
+    info.pixelSize = header.bpp/8;
+
+    /* Check that the color map and uncompressed pixel data fit into the file,
+       the size of compressed data is checked during decoding */
+    const std::size_t dataSize = info.compressed ? 0 : std::size_t(header.width)*header.height*info.pixelSize;
+    if(in.size() < offset + paletteSize + dataSize) {
+        Error() << prefix << "the file is too short, expected" << offset + paletteSize + dataSize << "bytes but got" << in.size();
         return std::nullopt;
     }
 
-    const std::size_t dataSize = header.width*header.height*header.bpp/8;
-    char* const data = new char[dataSize];
-    in->read(data, dataSize);
+    if(info.paletteEntrySize) info.palette = {in.begin() + offset, paletteSize};
+    offset += paletteSize;
+    info.data = {in.begin() + offset, in.size() - offset};
+    return info;
+}
+
+/* Fills given count of bytes with repeated pixel. The pixel is replicated
+   into 16-byte pattern which is then written out with wide unaligned stores,
+   for three-byte pixels the pattern contains five pixels and the output
+   advances by 15 bytes. */
+void fillRun(unsigned char* out, std::size_t size, const unsigned char* const pixel, const std::size_t pixelSize) {
+    if(size < 16) {
+        for(unsigned char* const end = out + size; out != end; out += pixelSize)
+            std::memcpy(out, pixel, pixelSize);
+        return;
+    }
+
+    unsigned char pattern[16];
+    std::memcpy(pattern, pixel, pixelSize);
+    for(std::size_t filled = pixelSize; filled < 16; filled *= 2)
+        std::memcpy(pattern + filled, pattern, std::min(filled, 16 - filled));
+
+    const std::size_t step = 16 - 16%pixelSize;
+    for(; size >= 16; out += step, size -= step)
+        std::memcpy(out, pattern, 16);
+    std::memcpy(out, pattern, size);
+}
+
+/* Expands RLE packets into fixed-size pixels filling the whole output */
+bool decodeRle(Containers::ArrayReference<const unsigned char> in, unsigned char* out, unsigned char* const outEnd, const std::size_t pixelSize, const char* const prefix) {
+    const unsigned char* input = in.begin();
+    while(out != outEnd) {
+        if(input == in.end()) {
+            Error() << prefix << "RLE data are too short";
+            return false;
+        }
+
+        /* Lower seven bits are pixel count minus one */
+        const std::size_t size = ((*input & 0x7f) + 1)*pixelSize;
+        if(std::size_t(outEnd - out) < size) {
+            Error() << prefix << "RLE packet overflows the image";
+            return false;
+        }
+
+        /* Run-length packet, one pixel repeated */
+        if(*input++ & 0x80) {
+            if(std::size_t(in.end() - input) < pixelSize) {
+                Error() << prefix << "RLE data are too short";
+                return false;
+            }
+
+            fillRun(out, size, input, pixelSize);
+            input += pixelSize;
+
+        /* Raw packet */
+        } else {
+            if(std::size_t(in.end() - input) < size) {
+                Error() << prefix << "RLE data are too short";
+                return false;
+            }
+
+            std::memcpy(out, input, size);
+            input += size;
+        }
+
+        out += size;
+    }
+
+    return true;
+}
 
-    Vector2i size(header.width, header.height);
+/* Looks up palette entries for 8-bit indices. The input may overlap end of
+   the output, as every index is read before its entry is written. */
+template<std::size_t entrySize> void applyPalette(const unsigned char* in, const std::size_t count, const unsigned char* const palette, unsigned char* out) {
+    for(const unsigned char* const end = in + count; in != end; ++in, out += entrySize)
+        std::memcpy(out, palette + *in*entrySize, entrySize);
+}
+
+}
+
+struct TgaImporter::File {
+    /* Either the mapped file or copy of data passed to openData() */
+    Implementation::MappedFile file;
+    Containers::Array<unsigned char> copy;
+    Containers::ArrayReference<const unsigned char> data;
+};
+
+TgaImporter::TgaImporter() = default;
+
+TgaImporter::TgaImporter(PluginManager::AbstractManager& manager, std::string plugin): AbstractImporter(manager, std::move(plugin)) {}
+
+TgaImporter::~TgaImporter() { close(); }
+
+auto TgaImporter::doFeatures() const -> Features { return Feature::OpenData; }
+
+bool TgaImporter::doIsOpened() const { return !!_in; }
+
+void TgaImporter::doOpenData(const Containers::ArrayReference<const unsigned char> data) {
+    /* The data don't need to outlive openData(), thus we need a copy */
+    _in.reset(new File);
+    _in->copy = Containers::Array<unsigned char>(data.size());
+    std::copy(data.begin(), data.end(), _in->copy.begin());
+    _in->data = _in->copy;
+}
+
+void TgaImporter::doOpenFile(const std::string& filename) {
+    Implementation::MappedFile file(filename);
+    if(!file) {
+        Error() << "Trade::TgaImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+
+    _in.reset(new File);
+    _in->file = std::move(file);
+    _in->data = _in->file.data();
+}
+
+void TgaImporter::doClose() { _in.reset(); }
+
+UnsignedInt TgaImporter::doImage2DCount() const { return 1; }
+
+std::optional<ImageReference2D> TgaImporter::doImage2DReference(UnsignedInt) {
+    const std::optional<Info> info = parse(_in->data, "Trade::TgaImporter::image2DReference():");
+    if(!info) return std::nullopt;
+
+    if(info->compressed || info->paletteEntrySize) {
+        Error() << "Trade::TgaImporter::image2DReference(): compressed and paletted data need to be decoded, use image2D() instead";
+        return std::nullopt;
+    }
 
     #ifdef MAGNUM_TARGET_GLES
-    if(format == ColorFormat::RGB) {
-        auto pixels = reinterpret_cast<Math::Vector3<UnsignedByte>*>(data);
-        std::transform(pixels, pixels + size.product(), pixels,
-            [](Math::Vector3<UnsignedByte> pixel) { return Math::swizzle<'b', 'g', 'r'>(pixel); });
-    } else if(format == ColorFormat::RGBA) {
-        auto pixels = reinterpret_cast<Math::Vector4<UnsignedByte>*>(data);
-        std::transform(pixels, pixels + size.product(), pixels,
-            [](Math::Vector4<UnsignedByte> pixel) { return Math::swizzle<'b', 'g', 'r', 'a'>(pixel); });
+    if(info->format == ColorFormat::RGB || info->format == ColorFormat::RGBA) {
+        Error() << "Trade::TgaImporter::image2DReference(): BGR and BGRA data need to be converted on OpenGL ES, use image2D() instead";
+        return std::nullopt;
     }
     #endif
 
-    return ImageData2D(format, ColorType::UnsignedByte, size, data);
+    return ImageReference2D(info->format, ColorType::UnsignedByte, info->size, info->data.begin());
+}
+
+std::optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt) {
+    const char* const prefix = "Trade::TgaImporter::image2D():";
+    const std::optional<Info> info = parse(_in->data, prefix);
+    if(!info) return std::nullopt;
+
+    /* Each dimension fits into 16 bits, but the product of both and the pixel
+       size doesn't fit into Int */
+    const std::size_t pixelCount = std::size_t(info->size.x())*std::size_t(info->size.y());
+    const std::size_t outputPixelSize = info->paletteEntrySize ? info->paletteEntrySize : info->pixelSize;
+    const std::size_t dataSize = outputPixelSize*pixelCount;
+    std::unique_ptr<unsigned char[]> data(new unsigned char[dataSize]);
+
+    /* Paletted image. Expand the color map to all 256 possible indices so the
+       lookup doesn't need any range checks, entries outside of the map are
+       black. */
+    if(info->paletteEntrySize) {
+        unsigned char palette[256*4]{};
+        const std::size_t paletteLength = info->palette.size()/info->paletteEntrySize;
+        if(info->paletteStart < 256) std::copy(info->palette.begin(),
+            info->palette.begin() + std::min<std::size_t>(paletteLength, 256 - info->paletteStart)*info->paletteEntrySize,
+            palette + info->paletteStart*info->paletteEntrySize);
+
+        /* On ES convert the color map instead of all the pixels */
+        #ifdef MAGNUM_TARGET_GLES
+        if(info->paletteEntrySize == 3)
+            swizzleBgrToRgb({palette, 256*3}, {palette, 256*3});
+        else
+            swizzleBgraToRgba({palette, 256*4}, {palette, 256*4});
+        #endif
+
+        /* Decode the indices into the end of the output, so the lookup can be
+           done in place */
+        const unsigned char* indices = info->data.begin();
+        if(info->compressed) {
+            unsigned char* const out = data.get() + (outputPixelSize - 1)*pixelCount;
+            if(!decodeRle(info->data, out, out + pixelCount, 1, prefix))
+                return std::nullopt;
+            indices = out;
+        }
+
+        if(info->paletteEntrySize == 3)
+            applyPalette<3>(indices, pixelCount, palette, data.get());
+        else
+            applyPalette<4>(indices, pixelCount, palette, data.get());
+
+    /* RLE-compressed image */
+    } else if(info->compressed) {
+        if(!decodeRle(info->data, data.get(), data.get() + dataSize, info->pixelSize, prefix))
+            return std::nullopt;
+
+        #ifdef MAGNUM_TARGET_GLES
+        if(info->format == ColorFormat::RGB)
+            swizzleBgrToRgb({data.get(), dataSize}, {data.get(), dataSize});
+        else if(info->format == ColorFormat::RGBA)
+            swizzleBgraToRgba({data.get(), dataSize}, {data.get(), dataSize});
+        #endif
+
+    /* Uncompressed image, convert the pixels while copying them to avoid
+       another pass */
+    } else {
+        const unsigned char* const pixels = info->data.begin();
+
+        #ifdef MAGNUM_TARGET_GLES
+        if(info->format == ColorFormat::RGB)
+            swizzleBgrToRgb({pixels, dataSize}, {data.get(), dataSize});
+        else if(info->format == ColorFormat::RGBA)
+            swizzleBgraToRgba({pixels, dataSize}, {data.get(), dataSize});
+        else
+        #endif
+        {
+            std::copy(pixels, pixels + dataSize, data.get());
+        }
+    }
+
+    return ImageData2D(info->format, ColorType::UnsignedByte, info->size, data.release());
 }
 
 }}
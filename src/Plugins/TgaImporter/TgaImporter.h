@@ -28,8 +28,10 @@
  * @brief Class Magnum::Trade::TgaImporter
  */
 
+#include <memory>
 #include <Utility/Visibility.h>
 
+#include "ImageReference.h"
 #include "Trade/AbstractImporter.h"
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -50,7 +52,9 @@ namespace Magnum { namespace Trade {
 /**
 @brief TGA importer plugin
 
-Supports uncompressed BGR, BGRA or grayscale images with 8 bits per channel.
+Supports uncompressed and RLE-compressed BGR, BGRA or grayscale images with 8
+bits per channel and uncompressed or RLE-compressed paletted images with 8-bit
+indices into BGR or BGRA color map.
 
 This plugin is built if `WITH_TGAIMPORTER` is enabled when building %Magnum. To
 use dynamic plugin, you need to load `%TgaImporter` plugin from
@@ -60,13 +64,22 @@ package in CMake and link to `${MAGNUM_TGAIMPORTER_LIBRARIES}`. See
 @ref building, @ref cmake and @ref plugins for more information.
 
 The images are imported with @ref ColorType::UnsignedByte and @ref ColorFormat::BGR,
-@ref ColorFormat::BGRA or @ref ColorFormat::Red, respectively. Grayscale images
-require extension @extension{ARB,texture_rg}.
+@ref ColorFormat::BGRA or @ref ColorFormat::Red, respectively. Paletted images
+are expanded to the format of their color map. Grayscale images require
+extension @extension{ARB,texture_rg}.
 
 In OpenGL ES BGR and BGRA images are converted to @ref ColorFormat::RGB
 and @ref ColorFormat::RGBA. In OpenGL ES 2.0, if @es_extension{EXT,texture_rg}
 is not supported, grayscale images use @ref ColorFormat::Luminance instead of
 @ref ColorFormat::Red.
+
+Files opened with @ref openFile() are memory-mapped on platforms which support
+it and parsed in place, data passed to @ref openData() are copied once. The
+pixel data are copied only when calling @ref image2D(). Uncompressed
+non-paletted images can be also accessed without any copy using
+@ref image2DReference(). RLE-compressed and paletted images (and BGR and BGRA
+images in OpenGL ES) can't be referenced, they are available only through
+@ref image2D().
 */
 class MAGNUM_TRADE_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
     public:
@@ -79,6 +92,8 @@ class MAGNUM_TRADE_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
         ~TgaImporter();
 
     private:
+        struct MAGNUM_TRADE_TGAIMPORTER_LOCAL File;
+
         Features MAGNUM_TRADE_TGAIMPORTER_LOCAL doFeatures() const override;
         bool MAGNUM_TRADE_TGAIMPORTER_LOCAL doIsOpened() const override;
         void MAGNUM_TRADE_TGAIMPORTER_LOCAL doOpenData(Containers::ArrayReference<const unsigned char> data) override;
@@ -86,8 +101,9 @@ class MAGNUM_TRADE_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
         void MAGNUM_TRADE_TGAIMPORTER_LOCAL doClose() override;
         UnsignedInt MAGNUM_TRADE_TGAIMPORTER_LOCAL doImage2DCount() const override;
         std::optional<ImageData2D> MAGNUM_TRADE_TGAIMPORTER_LOCAL doImage2D(UnsignedInt id) override;
+        std::optional<ImageReference2D> MAGNUM_TRADE_TGAIMPORTER_LOCAL doImage2DReference(UnsignedInt id) override;
 
-        std::istream* in;
+        std::unique_ptr<File> _in;
 };
 
 }}
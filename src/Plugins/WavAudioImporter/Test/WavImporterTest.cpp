@@ -22,7 +22,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
+#include <vector>
 #include <Containers/Array.h>
 #include <TestSuite/Tester.h>
 #include <Utility/Directory.h>
@@ -43,6 +46,20 @@ class WavImporterTest: public TestSuite::Tester {
         void unsupportedChannelCount();
         void mono16();
         void stereo8();
+
+        void stream();
+        void streamData();
+
+        void extraChunks();
+        void noDataChunk();
+        void riffSizeOverflow();
+        void shortFormatChunk();
+        void mono24();
+        void stereo32();
+        void monoFloat32();
+        void stereoFloat64();
+        void extensible();
+        void streamConverted();
 };
 
 WavImporterTest::WavImporterTest() {
@@ -51,7 +68,71 @@ WavImporterTest::WavImporterTest() {
               &WavImporterTest::unsupportedFormat,
               &WavImporterTest::unsupportedChannelCount,
               &WavImporterTest::mono16,
-              &WavImporterTest::stereo8});
+              &WavImporterTest::stereo8,
+
+              &WavImporterTest::stream,
+              &WavImporterTest::streamData,
+
+              &WavImporterTest::extraChunks,
+              &WavImporterTest::noDataChunk,
+              &WavImporterTest::riffSizeOverflow,
+              &WavImporterTest::shortFormatChunk,
+              &WavImporterTest::mono24,
+              &WavImporterTest::stereo32,
+              &WavImporterTest::monoFloat32,
+              &WavImporterTest::stereoFloat64,
+              &WavImporterTest::extensible,
+              &WavImporterTest::streamConverted});
+}
+
+namespace {
+
+template<class T> void append(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+std::string chunk(const std::string& id, const std::string& data) {
+    std::string out = id;
+    append(out, UnsignedInt(data.size()));
+    out += data;
+    if(data.size() & 1) out += '\0';
+    return out;
+}
+
+std::string formatChunk(UnsignedShort format, UnsignedShort channels, UnsignedShort bits, const std::string& extension = {}) {
+    std::string data;
+    append(data, format);
+    append(data, channels);
+    append(data, UnsignedInt(22050));
+    append(data, UnsignedInt(22050*channels*bits/8));
+    append(data, UnsignedShort(channels*bits/8));
+    append(data, bits);
+    return chunk("fmt ", data + extension);
+}
+
+/* Little-endian data are assumed, as the importer asserts that anyway */
+std::string file(const std::string& chunks) {
+    std::string out = "RIFF";
+    append(out, UnsignedInt(chunks.size() + 4));
+    return out + "WAVE" + chunks;
+}
+
+template<class T> std::string samples(std::initializer_list<T> values) {
+    std::string out;
+    for(T value: values) append(out, value);
+    return out;
+}
+
+Containers::ArrayReference<const unsigned char> view(const std::string& data) {
+    return {reinterpret_cast<const unsigned char*>(data.data()), data.size()};
+}
+
+std::vector<Short> shorts(const Containers::Array<unsigned char>& data) {
+    std::vector<Short> out(data.size()/2);
+    std::memcpy(out.data(), data.begin(), data.size());
+    return out;
+}
+
 }
 
 void WavImporterTest::wrongSize() {
@@ -69,7 +150,7 @@ void WavImporterTest::wrongSignature() {
 
     WavImporter importer;
     CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "wrongSignature.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): the file signature is invalid\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): the file signature is invalid\n");
 }
 
 void WavImporterTest::unsupportedFormat() {
@@ -78,7 +159,7 @@ void WavImporterTest::unsupportedFormat() {
 
     WavImporter importer;
     CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "unsupportedFormat.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported audio format 2\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): unsupported audio format 2\n");
 }
 
 void WavImporterTest::unsupportedChannelCount() {
@@ -87,7 +168,7 @@ void WavImporterTest::unsupportedChannelCount() {
 
     WavImporter importer;
     CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "unsupportedChannelCount.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported channel count 6 with 8 bits per sample\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): unsupported channel count 6 with 8 bits per sample\n");
 }
 
 void WavImporterTest::mono16() {
@@ -118,6 +199,193 @@ void WavImporterTest::stereo8() {
     CORRADE_COMPARE(data[3], 0x7e);
 }
 
+void WavImporterTest::stream() {
+    WavImporter importer;
+    CORRADE_VERIFY(importer.features() & AbstractImporter::Feature::Stream);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "mono16.wav")));
+    CORRADE_COMPARE(importer.dataSize(), 4);
+
+    /* Only whole samples are read */
+    unsigned char buffer[3]{};
+    CORRADE_COMPARE(importer.read(buffer), 2);
+    CORRADE_COMPARE(buffer[0], 0x1d);
+    CORRADE_COMPARE(buffer[1], 0x10);
+    CORRADE_COMPARE(importer.read(buffer), 2);
+    CORRADE_COMPARE(buffer[0], 0x71);
+    CORRADE_COMPARE(buffer[1], 0xC5);
+    CORRADE_COMPARE(importer.read(buffer), 0);
+
+    /* Buffer too small for single sample */
+    importer.seek(0);
+    CORRADE_COMPARE(importer.read({buffer, 1}), 0);
+
+    /* Seeking is rounded down to whole samples */
+    importer.seek(3);
+    CORRADE_COMPARE(importer.read(buffer), 2);
+    CORRADE_COMPARE(buffer[0], 0x71);
+    CORRADE_COMPARE(buffer[1], 0xC5);
+
+    /* Seeking past the end is clamped */
+    importer.seek(100);
+    CORRADE_COMPARE(importer.read(buffer), 0);
+}
+
+void WavImporterTest::streamData() {
+    Containers::Array<unsigned char> file = Utility::Directory::read(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo8.wav"));
+
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openData(file));
+
+    /* The data are copied, thus they don't need to be kept around */
+    std::fill(file.begin(), file.end(), 0);
+
+    unsigned char buffer[4]{};
+    CORRADE_COMPARE(importer.read(buffer), 4);
+    CORRADE_COMPARE(buffer[0], 0xde);
+    CORRADE_COMPARE(buffer[1], 0xfe);
+    CORRADE_COMPARE(buffer[2], 0xca);
+    CORRADE_COMPARE(buffer[3], 0x7e);
+}
+
+void WavImporterTest::extraChunks() {
+    /* Odd-sized chunk is padded */
+    const std::string data = file(chunk("LIST", "abc") +
+        formatChunk(1, 1, 16) + chunk("fact", samples<UnsignedInt>({2})) +
+        chunk("data", samples<Short>({-3, 1234})) + chunk("cue ", "x"));
+
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openData(view(data)));
+    CORRADE_COMPARE(importer.format(), Buffer::Format::Mono16);
+    CORRADE_COMPARE(importer.frequency(), 22050);
+    CORRADE_COMPARE(shorts(importer.data()), (std::vector<Short>{-3, 1234}));
+}
+
+void WavImporterTest::noDataChunk() {
+    const std::string data = file(formatChunk(1, 1, 16) + chunk("LIST", "abcd") + chunk("fact", "abcd"));
+
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    WavImporter importer;
+    CORRADE_VERIFY(!importer.openData(view(data)));
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): the file signature is invalid\n");
+}
+
+void WavImporterTest::riffSizeOverflow() {
+    /* Size of the RIFF chunk plus its header doesn't fit into 32 bits */
+    std::string data = file(formatChunk(1, 1, 16) + chunk("data", samples<Short>({1, 2})));
+    const UnsignedInt size = 0xfffffff8u;
+    data.replace(4, 4, reinterpret_cast<const char*>(&size), 4);
+
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    WavImporter importer;
+    CORRADE_VERIFY(!importer.openData(view(data)));
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): the file has improper size, expected 4294967296 but got 48\n");
+}
+
+void WavImporterTest::shortFormatChunk() {
+    /* Format chunk at the very end of the file with only part of the fields */
+    const std::string data = file(chunk("data", samples<Short>({1, 2, 3, 4, 5, 6, 7, 8})) + chunk("fmt ", samples<UnsignedShort>({1, 1, 0x5622, 0})));
+
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    WavImporter importer;
+    CORRADE_VERIFY(!importer.openData(view(data)));
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): the file is corrupted\n");
+}
+
+void WavImporterTest::mono24() {
+    /* Nine samples to test both vectorized and scalar code */
+    std::string data;
+    std::vector<Short> expected;
+    for(Int i = 0; i != 9; ++i) {
+        const Int value = (i - 4)*0x123456 + 0x42;
+        data.append(reinterpret_cast<const char*>(&value), 3);
+        expected.push_back(Short(value >> 8));
+    }
+
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openData(view(file(formatChunk(1, 1, 24) + chunk("data", data)))));
+    CORRADE_COMPARE(importer.format(), Buffer::Format::Mono16);
+    CORRADE_COMPARE(shorts(importer.data()), expected);
+}
+
+void WavImporterTest::stereo32() {
+    std::vector<Int> values;
+    std::vector<Short> expected;
+    for(Int i = 0; i != 10; ++i) {
+        values.push_back((i - 5)*0x12345678 + 0x42);
+        expected.push_back(Short(values.back() >> 16));
+    }
+    std::string data(reinterpret_cast<const char*>(values.data()), values.size()*4);
+
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openData(view(file(formatChunk(1, 2, 32) + chunk("data", data)))));
+    CORRADE_COMPARE(importer.format(), Buffer::Format::Stereo16);
+    CORRADE_COMPARE(shorts(importer.data()), expected);
+}
+
+void WavImporterTest::monoFloat32() {
+    const std::string data = samples<Float>({0.0f, 0.25f, -0.25f, 1.0f, -1.0f, 2.0f, -2.0f, 0.75f, -0.75f, 0.125f});
+
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openData(view(file(formatChunk(3, 1, 32) + chunk("data", data)))));
+    CORRADE_COMPARE(importer.format(), Buffer::Format::Mono16);
+    CORRADE_COMPARE(shorts(importer.data()), (std::vector<Short>{0, 8192, -8192, 32767, -32767, 32767, -32767, 24575, -24575, 4096}));
+}
+
+void WavImporterTest::stereoFloat64() {
+    const std::string data = samples<double>({0.25, -3.0});
+
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openData(view(file(formatChunk(3, 2, 64) + chunk("data", data)))));
+    CORRADE_COMPARE(importer.format(), Buffer::Format::Stereo16);
+    CORRADE_COMPARE(shorts(importer.data()), (std::vector<Short>{8192, -32767}));
+}
+
+void WavImporterTest::extensible() {
+    /* Extension size, valid bits, channel mask and PCM subformat GUID */
+    std::string extension;
+    append(extension, UnsignedShort(22));
+    append(extension, UnsignedShort(24));
+    append(extension, UnsignedInt(0x4));
+    extension += std::string("\x01\x00\x00\x00\x00\x00\x10\x00\x80\x00\x00\xaa\x00\x38\x9b\x71", 16);
+
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openData(view(file(formatChunk(0xfffe, 1, 24, extension) + chunk("data", std::string("\x00\x34\x12", 3))))));
+    CORRADE_COMPARE(importer.format(), Buffer::Format::Mono16);
+    CORRADE_COMPARE(shorts(importer.data()), (std::vector<Short>{0x1234}));
+}
+
+void WavImporterTest::streamConverted() {
+    std::string data;
+    for(Int i = 0; i != 5; ++i) {
+        const Int value = i*0x10000;
+        data.append(reinterpret_cast<const char*>(&value), 3);
+    }
+
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openData(view(file(formatChunk(1, 1, 24) + chunk("data", data)))));
+    CORRADE_COMPARE(importer.dataSize(), 10);
+
+    /* Size of converted sample is used */
+    Short buffer[3]{};
+    CORRADE_COMPARE(importer.read({reinterpret_cast<unsigned char*>(buffer), 5}), 4);
+    CORRADE_COMPARE(buffer[0], 0x000);
+    CORRADE_COMPARE(buffer[1], 0x100);
+    CORRADE_COMPARE(importer.read({reinterpret_cast<unsigned char*>(buffer), 6}), 6);
+    CORRADE_COMPARE(buffer[0], 0x200);
+    CORRADE_COMPARE(buffer[2], 0x400);
+    CORRADE_COMPARE(importer.read({reinterpret_cast<unsigned char*>(buffer), 6}), 0);
+
+    importer.seek(7);
+    CORRADE_COMPARE(importer.read({reinterpret_cast<unsigned char*>(buffer), 6}), 4);
+    CORRADE_COMPARE(buffer[0], 0x300);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::WavImporterTest)
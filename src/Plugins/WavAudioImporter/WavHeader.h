@@ -25,7 +25,7 @@
 */
 
 /** @file
- * @brief Struct Magnum::Audio::WavHeader
+ * @brief Struct Magnum::Audio::RiffChunk, Magnum::Audio::WavHeader, Magnum::Audio::WavFormatChunk
  */
 
 #include "Types.h"
@@ -33,27 +33,33 @@
 namespace Magnum { namespace Audio {
 
 #pragma pack(1)
+/** @brief RIFF chunk header */
+struct RiffChunk {
+    char chunkId[4];                /**< @brief Chunk identifier */
+    UnsignedInt chunkSize;          /**< @brief Size of the chunk data, without padding */
+};
+
 /** @brief WAV file header */
 struct WavHeader {
-    char chunkId[4];                /**< @brief `RIFF` characters */
-    UnsignedInt chunkSize;          /**< @brief Size of the rest of the file */
+    RiffChunk chunk;                /**< @brief `RIFF` chunk header */
     char format[4];                 /**< @brief `WAVE` characters */
+};
 
-    char subChunk1Id[4];            /**< @brief `fmt ` characters */
-    UnsignedInt subChunk1Size;      /**< @brief 16 for PCM */
-    UnsignedShort audioFormat;      /**< @brief 1 = PCM */
+/** @brief WAV format chunk */
+struct WavFormatChunk {
+    RiffChunk chunk;                /**< @brief `fmt ` chunk header */
+    UnsignedShort audioFormat;      /**< @brief 1 = PCM, 3 = IEEE float, 0xFFFE = extensible */
     UnsignedShort numChannels;      /**< @brief 1 = Mono, 2 = Stereo */
     UnsignedInt sampleRate;         /**< @brief Sample rate in Hz */
     UnsignedInt byteRate;           /**< @brief Bytes per second */
     UnsignedShort blockAlign;       /**< @brief Bytes per sample (all channels) */
     UnsignedShort bitsPerSample;    /**< @brief Bits per sample (one channel) */
-
-    char subChunk2Id[4];            /**< @brief `data` characters */
-    UnsignedInt subChunk2Size;      /**< @brief Size of the following data */
 };
 #pragma pack()
 
-static_assert(sizeof(WavHeader) == 44, "WavHeader size is not 44 bytes");
+static_assert(sizeof(RiffChunk) == 8, "RiffChunk size is not 8 bytes");
+static_assert(sizeof(WavHeader) == 12, "WavHeader size is not 12 bytes");
+static_assert(sizeof(WavFormatChunk) == 24, "WavFormatChunk size is not 24 bytes");
 
 }}
 
@@ -24,107 +24,345 @@
 
 #include "WavImporter.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <Utility/Assert.h>
 #include <Utility/Debug.h>
 #include <Utility/Endianness.h>
 
+#include "Implementation/MappedFile.h"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "WavHeader.h"
 
 namespace Magnum { namespace Audio {
 
+namespace {
+
+/* Conversion of given count of samples to signed 16-bit. The data are always
+   little-endian. */
+typedef void(*Converter)(const unsigned char*, unsigned char*, std::size_t);
+
+/* Upper two bytes of each three-byte sample */
+void convert24(const unsigned char* const in, unsigned char* const out, const std::size_t count) {
+    std::size_t i = 0;
+
+    /* Eight samples at once, the first five from one 16-byte load, the rest
+       from second overlapping load */
+    #ifdef __SSSE3__
+    const __m128i shuffleLow = _mm_setr_epi8(1, 2, 4, 5, 7, 8, 10, 11, 13, 14, -1, -1, -1, -1, -1, -1);
+    const __m128i shuffleHigh = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 8, 9, 11, 12, 14, 15);
+    for(; i + 8 <= count; i += 8) {
+        const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i*3));
+        const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i*3 + 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i*2),
+            _mm_or_si128(_mm_shuffle_epi8(low, shuffleLow), _mm_shuffle_epi8(high, shuffleHigh)));
+    }
+    #endif
+
+    for(; i != count; ++i) {
+        out[i*2] = in[i*3 + 1];
+        out[i*2 + 1] = in[i*3 + 2];
+    }
+}
+
+/* Upper two bytes of each four-byte sample */
+void convert32(const unsigned char* const in, unsigned char* const out, const std::size_t count) {
+    std::size_t i = 0;
+
+    /* The shifted values always fit, so the saturating pack is exact */
+    #ifdef __SSE2__
+    for(; i + 8 <= count; i += 8) {
+        const __m128i a = _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i*4)), 16);
+        const __m128i b = _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i*4 + 16)), 16);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i*2), _mm_packs_epi32(a, b));
+    }
+    #endif
+
+    for(; i != count; ++i) {
+        out[i*2] = in[i*4 + 2];
+        out[i*2 + 1] = in[i*4 + 3];
+    }
+}
+
+template<class T> Short floatToShort(const T value) {
+    /* Rounding to nearest even, same as the SSE conversion */
+    return Short(std::nearbyint(std::min(std::max(value, T(-1.0)), T(1.0))*T(32767.0)));
+}
+
+/* Floats clamped to [-1, 1] and scaled */
+void convertFloat32(const unsigned char* const in, unsigned char* const out, const std::size_t count) {
+    std::size_t i = 0;
+
+    #ifdef __SSE2__
+    const __m128 min = _mm_set1_ps(-1.0f);
+    const __m128 max = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(32767.0f);
+    for(; i + 8 <= count; i += 8) {
+        const __m128 a = _mm_loadu_ps(reinterpret_cast<const Float*>(in + i*4));
+        const __m128 b = _mm_loadu_ps(reinterpret_cast<const Float*>(in + i*4 + 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i*2), _mm_packs_epi32(
+            _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(a, min), max), scale)),
+            _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(b, min), max), scale))));
+    }
+    #endif
+
+    for(; i != count; ++i) {
+        Float value;
+        std::memcpy(&value, in + i*4, 4);
+        const Short converted = floatToShort(value);
+        std::memcpy(out + i*2, &converted, 2);
+    }
+}
+
+void convertFloat64(const unsigned char* const in, unsigned char* const out, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i) {
+        double value;
+        std::memcpy(&value, in + i*8, 8);
+        const Short converted = floatToShort(value);
+        std::memcpy(out + i*2, &converted, 2);
+    }
+}
+
+}
+
+struct WavImporter::File {
+    /* Either the mapped file or copy of data passed to openData() */
+    Implementation::MappedFile file;
+    Containers::Array<unsigned char> copy;
+    Containers::ArrayReference<const unsigned char> data;
+
+    /* Sample data in the file, converter to 16-bit samples or nullptr if the
+       samples are copied as-is */
+    Containers::ArrayReference<const unsigned char> samples;
+    Converter converter;
+    std::size_t channelCount;
+    std::size_t inputBlockAlign;
+    std::size_t outputBlockAlign;
+
+    /* Count of samples for all channels and stream position in them */
+    std::size_t frameCount;
+    std::size_t position;
+
+    /* Copies or converts given count of samples for all channels */
+    void decode(std::size_t from, std::size_t count, unsigned char* out) const;
+};
+
+void WavImporter::File::decode(const std::size_t from, const std::size_t count, unsigned char* const out) const {
+    const unsigned char* const in = samples.begin() + from*inputBlockAlign;
+    if(converter) converter(in, out, count*channelCount);
+    else std::memcpy(out, in, count*inputBlockAlign);
+}
+
 WavImporter::WavImporter() = default;
 
 WavImporter::WavImporter(PluginManager::AbstractManager& manager, std::string plugin): AbstractImporter(manager, std::move(plugin)) {}
 
 WavImporter::~WavImporter() { close(); }
 
-auto WavImporter::doFeatures() const -> Features { return Feature::OpenData; }
+auto WavImporter::doFeatures() const -> Features { return Feature::OpenData|Feature::Stream; }
 
-bool WavImporter::doIsOpened() const { return _data; }
+bool WavImporter::doIsOpened() const { return !!_in; }
 
 void WavImporter::doOpenData(Containers::ArrayReference<const unsigned char> data) {
-    /* Check file size */
-    if(data.size() < sizeof(WavHeader)) {
-        Error() << "Audio::WavImporter::openData(): the file is too short:" << data.size() << "bytes";
+    /* The data don't need to outlive openData(), thus we need a copy */
+    std::unique_ptr<File> file(new File);
+    file->copy = Containers::Array<unsigned char>(data.size());
+    std::copy(data.begin(), data.end(), file->copy.begin());
+    file->data = file->copy;
+    parse(std::move(file), "Audio::WavImporter::openData():");
+}
+
+void WavImporter::doOpenFile(const std::string& filename) {
+    std::unique_ptr<File> file(new File);
+    file->file = Implementation::MappedFile(filename);
+    if(!file->file) {
+        Error() << "Audio::WavImporter::openFile(): cannot open file" << filename;
         return;
     }
 
-    /* Get header contents and fix endianness */
-    WavHeader header(*reinterpret_cast<const WavHeader*>(data.begin()));
-    Utility::Endianness::littleEndianInPlace(header.chunkSize,
-        header.subChunk1Size, header.audioFormat, header.numChannels,
-        header.sampleRate, header.byteRate, header.blockAlign,
-        header.bitsPerSample, header.subChunk2Size);
+    file->data = file->file.data();
+    parse(std::move(file), "Audio::WavImporter::openFile():");
+}
+
+void WavImporter::parse(std::unique_ptr<File> file, const char* const prefix) {
+    const Containers::ArrayReference<const unsigned char> data = file->data;
+
+    /* Check file size, there has to be at least the header, format chunk and
+       data chunk header */
+    if(data.size() < sizeof(WavHeader) + sizeof(WavFormatChunk) + sizeof(RiffChunk)) {
+        Error() << prefix << "the file is too short:" << data.size() << "bytes";
+        return;
+    }
 
     /* Check file signature */
-    if(std::strncmp(header.chunkId, "RIFF", 4) != 0 ||
-       std::strncmp(header.format, "WAVE", 4) != 0 ||
-       std::strncmp(header.subChunk1Id, "fmt ", 4) != 0 ||
-       std::strncmp(header.subChunk2Id, "data", 4) != 0) {
-        Error() << "Audio::WavImporter::openData(): the file signature is invalid";
+    WavHeader header(*reinterpret_cast<const WavHeader*>(data.begin()));
+    Utility::Endianness::littleEndianInPlace(header.chunk.chunkSize);
+    if(std::strncmp(header.chunk.chunkId, "RIFF", 4) != 0 ||
+       std::strncmp(header.format, "WAVE", 4) != 0) {
+        Error() << prefix << "the file signature is invalid";
+        return;
+    }
+
+    /* Check file size, trailing data after the RIFF chunk are ignored */
+    const std::size_t riffSize = std::size_t(header.chunk.chunkSize) + sizeof(RiffChunk);
+    if(riffSize > data.size()) {
+        Error() << prefix << "the file has improper size, expected"
+                << riffSize << "but got" << data.size();
+        return;
+    }
+
+    /* Walk the chunks and remember the format and data chunk, skip all others
+       (LIST, fact, cue, ...) without touching their contents */
+    const unsigned char* formatChunk = nullptr;
+    std::size_t formatSize = 0;
+    Containers::ArrayReference<const unsigned char> samples;
+    const unsigned char* const end = data.begin() + riffSize;
+    for(const unsigned char* chunk = data.begin() + sizeof(WavHeader); std::size_t(end - chunk) >= sizeof(RiffChunk); ) {
+        RiffChunk chunkHeader(*reinterpret_cast<const RiffChunk*>(chunk));
+        Utility::Endianness::littleEndianInPlace(chunkHeader.chunkSize);
+        const std::size_t chunkSize = chunkHeader.chunkSize;
+        if(chunkSize > std::size_t(end - chunk) - sizeof(RiffChunk)) {
+            Error() << prefix << "the file is corrupted";
+            return;
+        }
+
+        if(std::strncmp(chunkHeader.chunkId, "fmt ", 4) == 0 && !formatChunk) {
+            formatChunk = chunk;
+            formatSize = chunkSize;
+        } else if(std::strncmp(chunkHeader.chunkId, "data", 4) == 0 && !samples)
+            samples = {chunk + sizeof(RiffChunk), chunkSize};
+
+        /* Chunks are padded to even size */
+        chunk += std::min<std::size_t>(sizeof(RiffChunk) + chunkSize + (chunkSize & 1), end - chunk);
+    }
+
+    if(!formatChunk || !samples.data()) {
+        Error() << prefix << "the file signature is invalid";
         return;
     }
 
-    /* Check file size */
-    if(header.chunkSize + 8 != data.size()) {
-        Error() << "Audio::WavImporter::openData(): the file has improper size, expected"
-                << header.chunkSize + 8 << "but got" << data.size();
+    /* Check that the format chunk has at least the basic fields before
+       touching them, it can be at the very end of the file */
+    if(formatSize < sizeof(WavFormatChunk) - sizeof(RiffChunk)) {
+        Error() << prefix << "the file is corrupted";
         return;
     }
 
+    /* Get format chunk contents and fix endianness */
+    WavFormatChunk format;
+    std::memcpy(&format, formatChunk, sizeof(WavFormatChunk));
+    Utility::Endianness::littleEndianInPlace(format.chunk.chunkSize,
+        format.audioFormat, format.numChannels, format.sampleRate,
+        format.byteRate, format.blockAlign, format.bitsPerSample);
+
+    /* Extensible format has the actual format in first two bytes of
+       subformat GUID, after extension size, valid bits and channel mask */
+    UnsignedShort audioFormat = format.audioFormat;
+    if(audioFormat == 0xfffe) {
+        if(formatSize < 40) {
+            Error() << prefix << "the file is corrupted";
+            return;
+        }
+
+        audioFormat = formatChunk[sizeof(WavFormatChunk) + 8]|(formatChunk[sizeof(WavFormatChunk) + 9] << 8);
+    }
+
     /* Check PCM format */
-    if(header.audioFormat != 1) {
-        Error() << "Audio::WavImporter::openData(): unsupported audio format" << header.audioFormat;
+    if(audioFormat != 1 && audioFormat != 3) {
+        Error() << prefix << "unsupported audio format" << audioFormat;
         return;
     }
 
     /* Verify more things */
-    if(header.subChunk1Size != 16 ||
-       header.subChunk2Size + 44 != data.size() ||
-       header.blockAlign != header.numChannels*header.bitsPerSample/8 ||
-       header.byteRate != header.sampleRate*header.blockAlign) {
-        Error() << "Audio::WavImporter::openData(): the file is corrupted";
+    if(format.blockAlign != format.numChannels*format.bitsPerSample/8 ||
+       format.byteRate != format.sampleRate*format.blockAlign) {
+        Error() << prefix << "the file is corrupted";
         return;
     }
 
+    /* Decide about the converter, everything above 16 bits is converted to 16
+       bits, as that's the widest format supported by the buffer */
+    Converter converter = nullptr;
+    UnsignedInt outputBits = format.bitsPerSample;
+    if(audioFormat == 1 && format.bitsPerSample == 24) {
+        converter = convert24;
+        outputBits = 16;
+    } else if(audioFormat == 1 && format.bitsPerSample == 32) {
+        converter = convert32;
+        outputBits = 16;
+    } else if(audioFormat == 3 && format.bitsPerSample == 32) {
+        converter = convertFloat32;
+        outputBits = 16;
+    } else if(audioFormat == 3 && format.bitsPerSample == 64) {
+        converter = convertFloat64;
+        outputBits = 16;
+    } else if(audioFormat == 3 || (format.bitsPerSample != 8 && format.bitsPerSample != 16))
+        outputBits = 0;
+
     /* Decide about format */
-    if(header.numChannels == 1 && header.bitsPerSample == 8)
+    if(format.numChannels == 1 && outputBits == 8)
         _format = Buffer::Format::Mono8;
-    else if(header.numChannels == 1 && header.bitsPerSample == 16)
+    else if(format.numChannels == 1 && outputBits == 16)
         _format = Buffer::Format::Mono16;
-    else if(header.numChannels == 2 && header.bitsPerSample == 8)
+    else if(format.numChannels == 2 && outputBits == 8)
         _format = Buffer::Format::Stereo8;
-    else if(header.numChannels == 2 && header.bitsPerSample == 16)
+    else if(format.numChannels == 2 && outputBits == 16)
         _format = Buffer::Format::Stereo16;
     else {
-        Error() << "Audio::WavImporter::openData(): unsupported channel count"
-                << header.numChannels << "with" << header.bitsPerSample
+        Error() << prefix << "unsupported channel count"
+                << format.numChannels << "with" << format.bitsPerSample
                 << "bits per sample";
         return;
     }
 
     /* Save frequency */
-    _frequency = header.sampleRate;
+    _frequency = format.sampleRate;
 
     /** @todo Convert the data from little endian too */
     CORRADE_INTERNAL_ASSERT(!Utility::Endianness::isBigEndian());
 
-    /* Copy the data */
-    _data = Containers::Array<unsigned char>(header.subChunk2Size);
-    std::copy(data.begin()+sizeof(WavHeader), data.end(), _data.begin());
-    return;
+    /* Reference the data, no copy is made */
+    file->samples = samples;
+    file->converter = converter;
+    file->channelCount = format.numChannels;
+    file->inputBlockAlign = format.blockAlign;
+    file->outputBlockAlign = format.numChannels*outputBits/8;
+    file->frameCount = samples.size()/format.blockAlign;
+    file->position = 0;
+    _in = std::move(file);
 }
 
-void WavImporter::doClose() { _data = nullptr; }
+void WavImporter::doClose() { _in.reset(); }
 
 Buffer::Format WavImporter::doFormat() const { return _format; }
 
 UnsignedInt WavImporter::doFrequency() const { return _frequency; }
 
 Containers::Array<unsigned char> WavImporter::doData() {
-    Containers::Array<unsigned char> copy(_data.size());
-    std::copy(_data.begin(), _data.end(), copy.begin());
-    return copy;
+    Containers::Array<unsigned char> out(_in->frameCount*_in->outputBlockAlign);
+    _in->decode(0, _in->frameCount, out.begin());
+    return out;
+}
+
+std::size_t WavImporter::doDataSize() const { return _in->frameCount*_in->outputBlockAlign; }
+
+std::size_t WavImporter::doRead(const Containers::ArrayReference<unsigned char> buffer) {
+    /* Decode only whole samples for all channels */
+    const std::size_t count = std::min(buffer.size()/_in->outputBlockAlign, _in->frameCount - _in->position);
+    _in->decode(_in->position, count, buffer.begin());
+    _in->position += count;
+    return count*_in->outputBlockAlign;
+}
+
+void WavImporter::doSeek(const std::size_t position) {
+    _in->position = std::min(position/_in->outputBlockAlign, _in->frameCount);
 }
 
 }}
@@ -28,6 +28,7 @@
  * @brief Class Magnum::Audio::WavImporter
  */
 
+#include <memory>
 #include <Containers/Array.h>
 #include <Utility/Visibility.h>
 
@@ -38,9 +39,19 @@ namespace Magnum { namespace Audio {
 /**
 @brief WAV importer plugin
 
-Supports mono and stereo PCM files with 8 or 16 bits per channel. The files are
-imported with @ref Buffer::Format::Mono8, @ref Buffer::Format::Mono16,
-@ref Buffer::Format::Stereo8 or @ref Buffer::Format::Stereo16, respectively.
+Supports mono and stereo PCM files with 8, 16, 24 or 32 bits per channel and
+IEEE float files with 32 or 64 bits per channel, including files using the
+extensible format header. Chunks other than format and data are skipped. The
+files are imported with @ref Buffer::Format::Mono8, @ref Buffer::Format::Mono16,
+@ref Buffer::Format::Stereo8 or @ref Buffer::Format::Stereo16, respectively,
+samples wider than 16 bits are converted to 16 bits, float samples are clamped
+to @f$ [-1; 1] @f$ range. The conversion is vectorized if compiled with SSE2
+(or SSSE3 for 24-bit samples) instructions enabled.
+
+Files opened with @ref openFile() are memory-mapped on platforms which support
+it, data passed to @ref openData() are copied once. The importer supports
+@ref Feature::Stream, the samples are then copied directly from the file in
+chunks of requested size, without decoding the whole file at once.
 
 This plugin is built if `WITH_WAVAUDIOIMPORTER` is enabled when building
 %Magnum. To use dynamic plugin, you need to load `%WavAudioImporter` plugin
@@ -60,16 +71,24 @@ class WavImporter: public AbstractImporter {
         ~WavImporter();
 
     private:
+        struct File;
+
         Features doFeatures() const override;
         bool doIsOpened() const override;
         void doOpenData(Containers::ArrayReference<const unsigned char> data) override;
+        void doOpenFile(const std::string& filename) override;
         void doClose() override;
 
         Buffer::Format doFormat() const override;
         UnsignedInt doFrequency() const override;
         Containers::Array<unsigned char> doData() override;
+        std::size_t doDataSize() const override;
+        std::size_t doRead(Containers::ArrayReference<unsigned char> buffer) override;
+        void doSeek(std::size_t position) override;
+
+        void parse(std::unique_ptr<File> file, const char* prefix);
 
-        Containers::Array<unsigned char> _data;
+        std::unique_ptr<File> _in;
         Buffer::Format _format;
         UnsignedInt _frequency;
 };
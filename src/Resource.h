@@ -127,22 +127,22 @@ class Resource {
          * Creates empty resource. Resources are acquired from the manager by
          * calling ResourceManager::get().
          */
-        explicit Resource(): manager(nullptr), lastCheck(0), _state(ResourceState::Final), data(nullptr) {}
+        explicit Resource(): manager(nullptr), _slot(0), _version(0), _state(ResourceState::Final), data(nullptr) {}
 
         /** @brief Copy constructor */
-        Resource(const Resource<T, U>& other): manager(other.manager), _key(other._key), lastCheck(other.lastCheck), _state(other._state), data(other.data) {
-            if(manager) manager->incrementReferenceCount(_key);
+        Resource(const Resource<T, U>& other): manager(other.manager), _key(other._key), _slot(other._slot), _version(other._version), _state(other._state), data(other.data) {
+            if(manager) manager->incrementReferenceCount(_slot);
         }
 
         /** @brief Move constructor */
-        Resource(Resource<T, U>&& other): manager(other.manager), _key(other._key), lastCheck(other.lastCheck), _state(other._state), data(other.data) {
+        Resource(Resource<T, U>&& other): manager(other.manager), _key(other._key), _slot(other._slot), _version(other._version), _state(other._state), data(other.data) {
             /** @brief Make other's state well-defined */
             other.manager = nullptr;
         }
 
         /** @brief Destructor */
         ~Resource() {
-            if(manager) manager->decrementReferenceCount(_key);
+            if(manager) manager->decrementReferenceCount(_slot);
         }
 
         /** @brief Copy assignment */
@@ -214,39 +214,42 @@ class Resource {
         }
 
     private:
-        Resource(Implementation::ResourceManagerData<T>* manager, ResourceKey key): manager(manager), _key(key), lastCheck(0), _state(ResourceState::NotLoaded), data(nullptr) {
-            manager->incrementReferenceCount(key);
+        Resource(Implementation::ResourceManagerData<T>* manager, ResourceKey key, UnsignedInt slot): manager(manager), _key(key), _slot(slot), _version(0), _state(ResourceState::NotLoaded), data(nullptr) {
+            manager->incrementReferenceCount(slot);
         }
 
         void acquire();
 
         Implementation::ResourceManagerData<T>* manager;
         ResourceKey _key;
-        std::size_t lastCheck;
+        UnsignedInt _slot;
+        std::size_t _version;
         ResourceState _state;
         T* data;
 };
 
 template<class T, class U> Resource<T, U>& Resource<T, U>::operator=(const Resource<T, U>& other) {
-    if(manager) manager->decrementReferenceCount(_key);
+    if(manager) manager->decrementReferenceCount(_slot);
 
     manager = other.manager;
     _key = other._key;
-    lastCheck = other.lastCheck;
+    _slot = other._slot;
+    _version = other._version;
     _state = other._state;
     data = other.data;
 
-    if(manager) manager->incrementReferenceCount(_key);
+    if(manager) manager->incrementReferenceCount(_slot);
     return *this;
 }
 
 template<class T, class U> Resource<T, U>& Resource<T, U>::operator=(Resource<T, U>&& other) {
     /** @todo Just swap the values */
-    if(manager) manager->decrementReferenceCount(_key);
+    if(manager) manager->decrementReferenceCount(_slot);
 
     manager = other.manager;
     _key = other._key;
-    lastCheck = other.lastCheck;
+    _slot = other._slot;
+    _version = other._version;
     _state = other._state;
     data = other.data;
 
@@ -259,11 +262,11 @@ template<class T, class U> void Resource<T, U>::acquire() {
     if(_state == ResourceState::Final) return;
 
     /* Nothing changed since last check */
-    if(manager->lastChange() < lastCheck) return;
+    const typename Implementation::ResourceManagerData<T>::Data& d = manager->data(_slot);
+    if(d.version == _version) return;
 
-    /* Acquire new data and save last check time */
-    const typename Implementation::ResourceManagerData<T>::Data& d = manager->data(_key);
-    lastCheck = manager->lastChange();
+    /* Acquire new data and save the version */
+    _version = d.version;
 
     /* Try to get the data */
     data = d.data;
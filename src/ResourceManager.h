@@ -28,7 +28,9 @@
  * @brief Class Magnum::ResourceManager, enum Magnum::ResourceDataState, Magnum::ResourcePolicy
  */
 
+#include <limits>
 #include <unordered_map>
+#include <vector>
 
 #include "Resource.h"
 
@@ -84,7 +86,15 @@ enum class ResourcePolicy: UnsignedByte {
     Manual,
 
     /** The resource will be unloaded when last reference to it is gone. */
-    ReferenceCounted
+    ReferenceCounted,
+
+    /**
+     * The resource will be kept after last reference to it is gone and
+     * unloaded only when memory budget of given resource type is exceeded,
+     * least recently used first, or when calling ResourceManager::free().
+     * @see ResourceManager::setMemoryBudget()
+     */
+    Cached
 };
 
 template<class> class AbstractResourceLoader;
@@ -93,6 +103,12 @@ namespace Implementation {
 
 /** @todo Print either resource key or name string based on loader capabilities */
 
+/* The resources are stored in dense slot array, the hash map is used only for
+   translating keys to slot indices in get(), set() and state queries. Resource
+   instances cache the slot index and slot version, which is incremented on
+   every change of the slot, so checking for changes on access is single
+   comparison. Referenced slots are never released, so the cached index stays
+   valid for the whole lifetime of Resource instance. */
 template<class T> class ResourceManagerData {
     template<class, class> friend class Magnum::Resource;
     friend class AbstractResourceLoader<T>;
@@ -105,9 +121,7 @@ template<class T> class ResourceManagerData {
     public:
         virtual ~ResourceManagerData();
 
-        std::size_t lastChange() const { return _lastChange; }
-
-        std::size_t count() const { return _data.size(); }
+        std::size_t count() const { return _keys.size(); }
 
         std::size_t referenceCount(ResourceKey key) const;
 
@@ -115,7 +129,16 @@ template<class T> class ResourceManagerData {
 
         template<class U> Resource<T, U> get(ResourceKey key);
 
-        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy);
+        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size);
+
+        std::size_t memoryUsage() const { return _memoryUsage; }
+
+        std::size_t memoryBudget() const { return _memoryBudget; }
+
+        void setMemoryBudget(std::size_t budget) {
+            _memoryBudget = budget;
+            evict();
+        }
 
         T* fallback() { return _fallback; }
         const T* fallback() const { return _fallback; }
@@ -124,7 +147,7 @@ template<class T> class ResourceManagerData {
 
         void free();
 
-        void clear() { _data.clear(); }
+        void clear();
 
         AbstractResourceLoader<T>* loader() { return _loader; }
         const AbstractResourceLoader<T>* loader() const { return _loader; }
@@ -134,23 +157,44 @@ template<class T> class ResourceManagerData {
         void setLoader(AbstractResourceLoader<T>* loader);
 
     protected:
-        ResourceManagerData(): _fallback(nullptr), _loader(nullptr), _lastChange(0) {}
+        ResourceManagerData(): _fallback(nullptr), _loader(nullptr), _lruFirst(NoSlot), _lruLast(NoSlot), _memoryUsage(0), _memoryBudget(std::numeric_limits<std::size_t>::max()) {}
 
     private:
         struct Data;
 
-        const Data& data(ResourceKey key) { return _data[key]; }
+        enum: UnsignedInt { NoSlot = ~UnsignedInt(0) };
 
-        void incrementReferenceCount(ResourceKey key) {
-            ++_data[key].referenceCount;
-        }
+        const Data& data(UnsignedInt slot) const { return _slots[slot]; }
 
-        void decrementReferenceCount(ResourceKey key);
+        /* Slot for given key, added if not already present */
+        UnsignedInt slot(ResourceKey key);
 
-        std::unordered_map<ResourceKey, Data> _data;
+        /* Deletes slot data and puts it to free list, doesn't remove the key */
+        void release(UnsignedInt slot);
+
+        /* Removes the resource if nothing references it */
+        void remove(ResourceKey key);
+
+        /* Unreferenced cached resources are in doubly-linked LRU list
+           threaded through the slots, least recently used first */
+        void link(UnsignedInt slot);
+        void unlink(UnsignedInt slot);
+
+        /* Releases least recently used cached resources until the memory
+           usage fits into the budget */
+        void evict();
+
+        void incrementReferenceCount(UnsignedInt slot);
+
+        void decrementReferenceCount(UnsignedInt slot);
+
+        std::unordered_map<ResourceKey, UnsignedInt> _keys;
+        std::vector<Data> _slots;
+        std::vector<UnsignedInt> _freeSlots;
         T* _fallback;
         AbstractResourceLoader<T>* _loader;
-        std::size_t _lastChange;
+        UnsignedInt _lruFirst, _lruLast;
+        std::size_t _memoryUsage, _memoryBudget;
 };
 
 }
@@ -176,11 +220,13 @@ instead of failing on null pointer dereference. Availability and state of each
 resource can be queried through function state() on the manager or
 Resource::state() on each resource.
 
-The resources can be managed in three ways - resident resources, which stay in
+The resources can be managed in four ways - resident resources, which stay in
 memory for whole lifetime of the manager, manually managed resources, which
-can be deleted by calling free() if nothing references them anymore, and
+can be deleted by calling free() if nothing references them anymore,
 reference counted resources, which are deleted as soon as the last reference
-to them is removed.
+to them is removed, and cached resources, which are kept when nothing
+references them and deleted least recently used first only when memory budget
+set with setMemoryBudget() is exceeded.
 
 %Resource state and policy is configured when setting the resource data in
 set() and can be changed each time the data are updated, although already
@@ -309,8 +355,7 @@ template<class... Types> class ResourceManager: private Implementation::Resource
          * @see referenceCount(), state()
          */
         template<class T> ResourceManager<Types...>& set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy) {
-            this->Implementation::ResourceManagerData<T>::set(key, data, state, policy);
-            return *this;
+            return set(key, data, state, policy, 0);
         }
 
         /** @overload */
@@ -318,6 +363,24 @@ template<class... Types> class ResourceManager: private Implementation::Resource
             return set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy);
         }
 
+        /**
+         * @brief Set resource data with known size
+         * @return Reference to self (for method chaining)
+         *
+         * Same as above, @p size is memory used by the resource in bytes,
+         * counted towards memory usage of given resource type.
+         * @see memoryUsage(), setMemoryBudget()
+         */
+        template<class T> ResourceManager<Types...>& set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size) {
+            this->Implementation::ResourceManagerData<T>::set(key, data, state, policy, size);
+            return *this;
+        }
+
+        /** @overload */
+        template<class U> ResourceManager<Types...>& set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy, std::size_t size) {
+            return set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy, size);
+        }
+
         /**
          * @brief Set resource data
          * @return Reference to self (for method chaining)
@@ -334,6 +397,34 @@ template<class... Types> class ResourceManager: private Implementation::Resource
             return set(key, new typename std::decay<U>::type(std::forward<U>(data)));
         }
 
+        /**
+         * @brief Memory used by resources of given type
+         *
+         * Sum of sizes passed to set().
+         */
+        template<class T> std::size_t memoryUsage() const {
+            return this->Implementation::ResourceManagerData<T>::memoryUsage();
+        }
+
+        /** @brief Memory budget for resources of given type */
+        template<class T> std::size_t memoryBudget() const {
+            return this->Implementation::ResourceManagerData<T>::memoryBudget();
+        }
+
+        /**
+         * @brief Set memory budget for resources of given type
+         * @return Reference to self (for method chaining)
+         *
+         * If @ref memoryUsage() exceeds the budget, unreferenced resources
+         * with @ref ResourcePolicy::Cached are unloaded, least recently used
+         * first, until it fits or there are no such resources left. Default
+         * is unlimited.
+         */
+        template<class T> ResourceManager<Types...>& setMemoryBudget(std::size_t budget) {
+            this->Implementation::ResourceManagerData<T>::setMemoryBudget(budget);
+            return *this;
+        }
+
         /** @brief Fallback for not found resources */
         template<class T> T* fallback() {
             return this->Implementation::ResourceManagerData<T>::fallback();
@@ -464,95 +555,184 @@ template<class T> ResourceManagerData<T>::~ResourceManagerData() {
 }
 
 template<class T> std::size_t ResourceManagerData<T>::referenceCount(const ResourceKey key) const {
-    auto it = _data.find(key);
-    if(it == _data.end()) return 0;
-    return it->second.referenceCount;
+    auto it = _keys.find(key);
+    if(it == _keys.end()) return 0;
+    return _slots[it->second].referenceCount;
 }
 
 template<class T> ResourceState ResourceManagerData<T>::state(const ResourceKey key) const {
-    const auto it = _data.find(key);
+    const auto it = _keys.find(key);
+    const Data* const d = it == _keys.end() ? nullptr : &_slots[it->second];
 
     /* Resource not loaded */
-    if(it == _data.end() || !it->second.data) {
+    if(!d || !d->data) {
         /* Fallback found, add *Fallback to state */
         if(_fallback) {
-            if(it != _data.end() && it->second.state == ResourceDataState::Loading)
+            if(d && d->state == ResourceDataState::Loading)
                 return ResourceState::LoadingFallback;
-            else if(it != _data.end() && it->second.state == ResourceDataState::NotFound)
+            else if(d && d->state == ResourceDataState::NotFound)
                 return ResourceState::NotFoundFallback;
             else return ResourceState::NotLoadedFallback;
         }
 
         /* Fallback not found, loading didn't start yet */
-        if(it == _data.end() || (it->second.state != ResourceDataState::Loading && it->second.state != ResourceDataState::NotFound))
+        if(!d || (d->state != ResourceDataState::Loading && d->state != ResourceDataState::NotFound))
             return ResourceState::NotLoaded;
     }
 
     /* Loading / NotFound without fallback, Mutable / Final */
-    return static_cast<ResourceState>(it->second.state);
+    return static_cast<ResourceState>(d->state);
 }
 
 template<class T> template<class U> Resource<T, U> ResourceManagerData<T>::get(ResourceKey key) {
-    /* Ask loader for the data, if they aren't there yet */
-    if(_loader && _data.find(key) == _data.end())
-        _loader->load(key);
+    /* Ask loader for the data, if they aren't there yet. Reference the slot
+       first so the loader sees the reference count of the request. */
+    const bool load = _loader && _keys.find(key) == _keys.end();
+    Resource<T, U> resource(this, key, slot(key));
+    if(load) _loader->load(key);
+
+    return resource;
+}
+
+template<class T> UnsignedInt ResourceManagerData<T>::slot(const ResourceKey key) {
+    const auto found = _keys.find(key);
+    if(found != _keys.end()) return found->second;
+
+    /* Reuse released slot, if any */
+    UnsignedInt slot;
+    if(!_freeSlots.empty()) {
+        slot = _freeSlots.back();
+        _freeSlots.pop_back();
+    } else {
+        slot = _slots.size();
+        _slots.emplace_back();
+    }
+
+    _slots[slot].key = key;
+    _keys.insert({key, slot});
+    return slot;
+}
+
+template<class T> void ResourceManagerData<T>::release(const UnsignedInt slot) {
+    Data& d = _slots[slot];
+    if(d.policy == ResourcePolicy::Cached && !d.referenceCount) unlink(slot);
+    _memoryUsage -= d.size;
+    d.size = 0;
+    safeDelete(d.data);
+    d.data = nullptr;
+    d.state = ResourceDataState::Mutable;
+    d.policy = ResourcePolicy::Manual;
+
+    /* Version is never reset, so nothing can mistake the slot for its
+       previous occupant */
+    ++d.version;
+    _freeSlots.push_back(slot);
+}
+
+template<class T> void ResourceManagerData<T>::link(const UnsignedInt slot) {
+    Data& d = _slots[slot];
+    d.lruPrevious = _lruLast;
+    d.lruNext = NoSlot;
+    if(_lruLast != NoSlot) _slots[_lruLast].lruNext = slot;
+    else _lruFirst = slot;
+    _lruLast = slot;
+}
+
+template<class T> void ResourceManagerData<T>::unlink(const UnsignedInt slot) {
+    Data& d = _slots[slot];
+    if(d.lruPrevious != NoSlot) _slots[d.lruPrevious].lruNext = d.lruNext;
+    else _lruFirst = d.lruNext;
+    if(d.lruNext != NoSlot) _slots[d.lruNext].lruPrevious = d.lruPrevious;
+    else _lruLast = d.lruPrevious;
+}
+
+template<class T> void ResourceManagerData<T>::evict() {
+    while(_memoryUsage > _memoryBudget && _lruFirst != NoSlot) {
+        const UnsignedInt slot = _lruFirst;
+        _keys.erase(_slots[slot].key);
+        release(slot);
+    }
+}
 
-    return Resource<T, U>(this, key);
+template<class T> void ResourceManagerData<T>::remove(const ResourceKey key) {
+    const auto it = _keys.find(key);
+    if(it == _keys.end() || _slots[it->second].referenceCount) return;
+
+    release(it->second);
+    _keys.erase(it);
 }
 
-template<class T> void ResourceManagerData<T>::set(const ResourceKey key, T* const data, const ResourceDataState state, const ResourcePolicy policy) {
-    auto it = _data.find(key);
+template<class T> void ResourceManagerData<T>::set(const ResourceKey key, T* const data, const ResourceDataState state, const ResourcePolicy policy, const std::size_t size) {
+    auto it = _keys.find(key);
 
     /* NotFound / Loading state shouldn't have any data */
     CORRADE_ASSERT((data == nullptr) == (state == ResourceDataState::NotFound || state == ResourceDataState::Loading),
         "ResourceManager::set(): data should be null if and only if state is NotFound or Loading", );
 
     /* Cannot change resource with already final state */
-    CORRADE_ASSERT(it == _data.end() || it->second.state != ResourceDataState::Final,
+    CORRADE_ASSERT(it == _keys.end() || _slots[it->second].state != ResourceDataState::Final,
         "ResourceManager::set(): cannot change already final resource" << key, );
 
     /* If nothing is referencing reference-counted resource, we're done */
-    if(policy == ResourcePolicy::ReferenceCounted && (it == _data.end() || it->second.referenceCount == 0)) {
+    if(policy == ResourcePolicy::ReferenceCounted && (it == _keys.end() || _slots[it->second].referenceCount == 0)) {
         Warning() << "ResourceManager: Reference-counted resource with key" << key << "isn't referenced from anywhere, deleting it immediately";
         safeDelete(data);
 
         /* Delete also already present resource (it could be here
             because previous policy could be other than
             ReferenceCounted) */
-        if(it != _data.end()) _data.erase(it);
+        if(it != _keys.end()) {
+            release(it->second);
+            _keys.erase(it);
+        }
 
         return;
+    }
 
-    /* Insert it, if not already here */
-    } else if(it == _data.end())
-        #ifndef CORRADE_GCC46_COMPATIBILITY
-        it = _data.emplace(key, Data()).first;
-        #else
-        it = _data.insert({key, Data()}).first;
-        #endif
-
-    /* Replace previous data */
-    safeDelete(it->second.data);
-    it->second.data = data;
-    it->second.state = state;
-    it->second.policy = policy;
-    ++_lastChange;
+    /* Insert it, if not already here, and replace previous data */
+    const UnsignedInt slot = it == _keys.end() ? this->slot(key) : it->second;
+    Data& d = _slots[slot];
+    if(d.policy == ResourcePolicy::Cached && !d.referenceCount) unlink(slot);
+    safeDelete(d.data);
+    d.data = data;
+    d.state = state;
+    d.policy = policy;
+    ++d.version;
+
+    /* Unreferenced cached resource is the most recently used one now */
+    _memoryUsage += size - d.size;
+    d.size = size;
+    if(policy == ResourcePolicy::Cached && !d.referenceCount) link(slot);
+    evict();
 }
 
 template<class T> void ResourceManagerData<T>::setFallback(T* const data) {
     safeDelete(_fallback);
     _fallback = data;
+
+    /* Resources without data need to pick up the new fallback */
+    for(Data& d: _slots) ++d.version;
 }
 
 template<class T> void ResourceManagerData<T>::free() {
     /* Delete all non-referenced non-resident resources */
-    for(auto it = _data.begin(); it != _data.end(); ) {
-        if(it->second.policy != ResourcePolicy::Resident && !it->second.referenceCount)
-            it = _data.erase(it);
-        else ++it;
+    for(auto it = _keys.begin(); it != _keys.end(); ) {
+        const Data& d = _slots[it->second];
+        if(d.policy != ResourcePolicy::Resident && !d.referenceCount) {
+            release(it->second);
+            it = _keys.erase(it);
+        } else ++it;
     }
 }
 
+template<class T> void ResourceManagerData<T>::clear() {
+    _keys.clear();
+    _slots.clear();
+    _freeSlots.clear();
+    _lruFirst = _lruLast = NoSlot;
+    _memoryUsage = 0;
+}
+
 template<class T> void ResourceManagerData<T>::setLoader(AbstractResourceLoader<T>* const loader) {
     /* Delete previous loader */
     delete _loader;
@@ -568,13 +748,29 @@ template<class T> void ResourceManagerData<T>::freeLoader() {
     delete _loader;
 }
 
-template<class T> void ResourceManagerData<T>::decrementReferenceCount(ResourceKey key) {
-    auto it = _data.find(key);
-    CORRADE_INTERNAL_ASSERT(it != _data.end());
+template<class T> inline void ResourceManagerData<T>::incrementReferenceCount(const UnsignedInt slot) {
+    Data& d = _slots[slot];
+
+    /* Referenced cached resource can't be evicted */
+    if(d.referenceCount++ == 0 && d.policy == ResourcePolicy::Cached)
+        unlink(slot);
+}
+
+template<class T> void ResourceManagerData<T>::decrementReferenceCount(const UnsignedInt slot) {
+    CORRADE_INTERNAL_ASSERT(slot < _slots.size());
+    Data& d = _slots[slot];
+    if(--d.referenceCount) return;
 
     /* Free the resource if it is reference counted */
-    if(--it->second.referenceCount == 0 && it->second.policy == ResourcePolicy::ReferenceCounted)
-        _data.erase(it);
+    if(d.policy == ResourcePolicy::ReferenceCounted) {
+        _keys.erase(d.key);
+        release(slot);
+
+    /* Keep cached resource for later, unless over budget */
+    } else if(d.policy == ResourcePolicy::Cached) {
+        link(slot);
+        evict();
+    }
 }
 
 template<class T> struct ResourceManagerData<T>::Data {
@@ -582,9 +778,10 @@ template<class T> struct ResourceManagerData<T>::Data {
     Data& operator=(const Data&) = delete;
     Data& operator=(Data&&) = delete;
 
-    Data(): data(nullptr), state(ResourceDataState::Mutable), policy(ResourcePolicy::Manual), referenceCount(0) {}
+    /* Version starts at 1, so newly created Resource always fetches the data */
+    Data(): data(nullptr), state(ResourceDataState::Mutable), policy(ResourcePolicy::Manual), referenceCount(0), version(1), size(0), lruPrevious(NoSlot), lruNext(NoSlot) {}
 
-    Data(Data&& other): data(other.data), state(other.state), policy(other.policy), referenceCount(other.referenceCount) {
+    Data(Data&& other): data(other.data), state(other.state), policy(other.policy), referenceCount(other.referenceCount), key(other.key), version(other.version), size(other.size), lruPrevious(other.lruPrevious), lruNext(other.lruNext) {
         other.data = nullptr;
         other.referenceCount = 0;
     }
@@ -595,6 +792,9 @@ template<class T> struct ResourceManagerData<T>::Data {
     ResourceDataState state;
     ResourcePolicy policy;
     std::size_t referenceCount;
+    ResourceKey key;
+    std::size_t version, size;
+    UnsignedInt lruPrevious, lruNext;
 };
 
 template<class T> inline ResourceManagerData<T>::Data::~Data() {
@@ -0,0 +1,149 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <vector>
+#include <TestSuite/Tester.h>
+
+#include "FixedTimestep.h"
+
+namespace Magnum { namespace Test {
+
+class FixedTimestepTest: public TestSuite::Tester {
+    public:
+        explicit FixedTimestepTest();
+
+        void construct();
+        void update();
+        void updateNoCallbacks();
+        void catchUp();
+        void setTickDuration();
+        void reset();
+};
+
+FixedTimestepTest::FixedTimestepTest() {
+    addTests({&FixedTimestepTest::construct,
+              &FixedTimestepTest::update,
+              &FixedTimestepTest::updateNoCallbacks,
+              &FixedTimestepTest::catchUp,
+              &FixedTimestepTest::setTickDuration,
+              &FixedTimestepTest::reset});
+}
+
+void FixedTimestepTest::construct() {
+    FixedTimestep s(0.25f);
+    CORRADE_COMPARE(s.tickDuration(), 0.25f);
+    CORRADE_COMPARE(s.maxTicksPerFrame(), 5);
+    CORRADE_COMPARE(s.time(), 0.0f);
+    CORRADE_COMPARE(s.alpha(), 0.0f);
+    CORRADE_COMPARE(s.tickCount(), 0);
+    CORRADE_COMPARE(s.droppedTickCount(), 0);
+}
+
+void FixedTimestepTest::update() {
+    std::vector<Float> times, otherTimes;
+    FixedTimestep s(0.25f);
+    s.addCallback([this, &times](Float time, Float delta) {
+        CORRADE_COMPARE(delta, 0.25f);
+        times.push_back(time);
+    }).addCallback([&otherTimes](Float time, Float) {
+        otherTimes.push_back(time);
+    });
+
+    /* Not enough for a tick */
+    CORRADE_COMPARE(s.update(0.125f), 0);
+    CORRADE_COMPARE(s.alpha(), 0.5f);
+    CORRADE_VERIFY(times.empty());
+
+    /* Enough for two ticks with a quarter of tick remaining */
+    CORRADE_COMPARE(s.update(0.4375f), 2);
+    CORRADE_COMPARE(s.alpha(), 0.25f);
+    CORRADE_COMPARE(s.time(), 0.5f);
+    CORRADE_COMPARE(s.tickCount(), 2);
+    CORRADE_COMPARE(times, (std::vector<Float>{0.0f, 0.25f}));
+    CORRADE_COMPARE(otherTimes, times);
+
+    /* Exactly one tick */
+    CORRADE_COMPARE(s.update(0.25f), 1);
+    CORRADE_COMPARE(s.alpha(), 0.25f);
+    CORRADE_COMPARE(times, (std::vector<Float>{0.0f, 0.25f, 0.5f}));
+}
+
+void FixedTimestepTest::updateNoCallbacks() {
+    FixedTimestep s(0.5f);
+    CORRADE_COMPARE(s.update(1.25f), 2);
+    CORRADE_COMPARE(s.time(), 1.0f);
+    CORRADE_COMPARE(s.alpha(), 0.5f);
+}
+
+void FixedTimestepTest::catchUp() {
+    UnsignedInt count = 0;
+    FixedTimestep s(0.25f);
+    s.setMaxTicksPerFrame(3)
+        .addCallback([&count](Float, Float) { ++count; });
+
+    /* Long frame, only three ticks executed, the rest dropped except for the
+       fraction */
+    CORRADE_COMPARE(s.update(2.125f), 3);
+    CORRADE_COMPARE(count, 3);
+    CORRADE_COMPARE(s.tickCount(), 3);
+    CORRADE_COMPARE(s.droppedTickCount(), 5);
+    CORRADE_COMPARE(s.time(), 0.75f);
+    CORRADE_COMPARE(s.alpha(), 0.5f);
+
+    /* Next frame continues normally */
+    CORRADE_COMPARE(s.update(0.125f), 1);
+    CORRADE_COMPARE(s.alpha(), 0.0f);
+    CORRADE_COMPARE(s.droppedTickCount(), 5);
+}
+
+void FixedTimestepTest::setTickDuration() {
+    FixedTimestep s(0.25f);
+    CORRADE_COMPARE(s.update(0.625f), 2);
+
+    /* Simulation time and accumulated time is preserved */
+    s.setTickDuration(0.0625f);
+    CORRADE_COMPARE(s.time(), 0.5f);
+    CORRADE_COMPARE(s.update(0.0f), 2);
+    CORRADE_COMPARE(s.time(), 0.625f);
+    CORRADE_COMPARE(s.alpha(), 0.0f);
+}
+
+void FixedTimestepTest::reset() {
+    FixedTimestep s(0.25f);
+    s.setMaxTicksPerFrame(1);
+    s.update(1.125f);
+    CORRADE_COMPARE(s.tickCount(), 1);
+    CORRADE_COMPARE(s.droppedTickCount(), 3);
+
+    s.reset();
+    CORRADE_COMPARE(s.time(), 0.0f);
+    CORRADE_COMPARE(s.alpha(), 0.0f);
+    CORRADE_COMPARE(s.tickCount(), 0);
+    CORRADE_COMPARE(s.droppedTickCount(), 0);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::FixedTimestepTest)
@@ -22,7 +22,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <atomic>
+#include <chrono>
 #include <sstream>
+#include <thread>
 #include <TestSuite/Tester.h>
 
 #include "AbstractResourceLoader.h"
@@ -43,9 +46,18 @@ class ResourceManagerTest: public TestSuite::Tester {
         void residentPolicy();
         void referenceCountedPolicy();
         void manualPolicy();
+        void cachedPolicy();
+        void cachedPolicyLoader();
         void clear();
         void clearWhileReferenced();
+        void changeTracking();
+        void slotReuse();
         void loader();
+        void loaderAsync();
+        void loaderAsyncNoWorkers();
+        void loaderAsyncPriority();
+        void loaderAsyncPushPriority();
+        void loaderAsyncCancel();
 };
 
 class Data {
@@ -68,9 +80,18 @@ ResourceManagerTest::ResourceManagerTest() {
               &ResourceManagerTest::residentPolicy,
               &ResourceManagerTest::referenceCountedPolicy,
               &ResourceManagerTest::manualPolicy,
+              &ResourceManagerTest::cachedPolicy,
+              &ResourceManagerTest::cachedPolicyLoader,
               &ResourceManagerTest::clear,
               &ResourceManagerTest::clearWhileReferenced,
-              &ResourceManagerTest::loader});
+              &ResourceManagerTest::changeTracking,
+              &ResourceManagerTest::slotReuse,
+              &ResourceManagerTest::loader,
+              &ResourceManagerTest::loaderAsync,
+              &ResourceManagerTest::loaderAsyncNoWorkers,
+              &ResourceManagerTest::loaderAsyncPriority,
+              &ResourceManagerTest::loaderAsyncPushPriority,
+              &ResourceManagerTest::loaderAsyncCancel});
 }
 
 void ResourceManagerTest::state() {
@@ -229,6 +250,76 @@ void ResourceManagerTest::manualPolicy() {
     CORRADE_COMPARE(Data::count, 1);
 }
 
+void ResourceManagerTest::cachedPolicy() {
+    ResourceManager rm;
+    rm.setMemoryBudget<Data>(100);
+    CORRADE_COMPARE(rm.memoryBudget<Data>(), 100);
+
+    /* Unreferenced cached resources are kept */
+    {
+        Resource<Data> a = rm.get<Data>("a");
+        rm.set("a", new Data, ResourceDataState::Final, ResourcePolicy::Cached, 60);
+    }
+    rm.set("b", new Data, ResourceDataState::Final, ResourcePolicy::Cached, 30);
+    CORRADE_COMPARE(rm.count<Data>(), 2);
+    CORRADE_COMPARE(rm.memoryUsage<Data>(), 90);
+    CORRADE_COMPARE(Data::count, 2);
+
+    /* Over budget, least recently used unreferenced resource is evicted */
+    Resource<Data> a = rm.get<Data>("a");
+    CORRADE_COMPARE(a.state(), ResourceState::Final);
+    rm.set("c", new Data, ResourceDataState::Final, ResourcePolicy::Cached, 30);
+    CORRADE_COMPARE(rm.state<Data>("b"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.count<Data>(), 2);
+    CORRADE_COMPARE(rm.memoryUsage<Data>(), 90);
+    CORRADE_COMPARE(Data::count, 2);
+
+    /* Referenced resource is not evicted even if over budget */
+    rm.setMemoryBudget<Data>(50);
+    CORRADE_COMPARE(rm.state<Data>("c"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.state<Data>("a"), ResourceState::Final);
+    CORRADE_COMPARE(rm.memoryUsage<Data>(), 60);
+
+    /* ... until the last reference is gone */
+    a = Resource<Data>();
+    CORRADE_COMPARE(rm.count<Data>(), 0);
+    CORRADE_COMPARE(rm.memoryUsage<Data>(), 0);
+    CORRADE_COMPARE(Data::count, 0);
+
+    /* free() deletes unreferenced cached resources */
+    rm.set("d", new Data, ResourceDataState::Final, ResourcePolicy::Cached, 10);
+    CORRADE_COMPARE(rm.count<Data>(), 1);
+    rm.free();
+    CORRADE_COMPARE(rm.count<Data>(), 0);
+    CORRADE_COMPARE(rm.memoryUsage<Data>(), 0);
+}
+
+void ResourceManagerTest::cachedPolicyLoader() {
+    class CachedResourceLoader: public AbstractResourceLoader<Int> {
+        void doLoad(ResourceKey key) override {
+            set(key, 42, ResourceDataState::Final, ResourcePolicy::Cached, 4);
+        }
+    };
+
+    ResourceManager rm;
+    auto loader = new CachedResourceLoader;
+    rm.setLoader(loader);
+
+    CORRADE_COMPARE(*rm.get<Int>("a"), 42);
+    CORRADE_COMPARE(*rm.get<Int>("b"), 42);
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 8);
+
+    /* Dropped resource is not loaded again */
+    CORRADE_COMPARE(*rm.get<Int>("a"), 42);
+    CORRADE_COMPARE(loader->requestedCount(), 2);
+
+    /* Evicted resource is */
+    rm.setMemoryBudget<Int>(4);
+    CORRADE_COMPARE(rm.count<Int>(), 1);
+    CORRADE_COMPARE(*rm.get<Int>("b"), 42);
+    CORRADE_COMPARE(loader->requestedCount(), 3);
+}
+
 void ResourceManagerTest::clear() {
     ResourceManager rm;
 
@@ -258,6 +349,64 @@ void ResourceManagerTest::clearWhileReferenced() {
     CORRADE_COMPARE(out.str(), "ResourceManager: cleared/destroyed while data are still referenced\n");
 }
 
+void ResourceManagerTest::changeTracking() {
+    ResourceManager rm;
+
+    Resource<Int> a = rm.get<Int>("a");
+    Resource<Int> b = rm.get<Int>("b");
+    CORRADE_VERIFY(!a);
+
+    /* Change of other resource doesn't affect this one */
+    rm.set("b", 1, ResourceDataState::Mutable, ResourcePolicy::Resident);
+    CORRADE_VERIFY(!a);
+    CORRADE_COMPARE(*b, 1);
+
+    /* Fallback set afterwards is picked up */
+    rm.setFallback(-1);
+    CORRADE_COMPARE(a.state(), ResourceState::NotLoadedFallback);
+    CORRADE_COMPARE(*a, -1);
+
+    /* Copies see the changes too */
+    Resource<Int> a2 = a;
+    rm.set("a", 2, ResourceDataState::Mutable, ResourcePolicy::Resident);
+    CORRADE_COMPARE(*a, 2);
+    CORRADE_COMPARE(*a2, 2);
+    rm.set("a", 3, ResourceDataState::Final, ResourcePolicy::Resident);
+    CORRADE_COMPARE(a.state(), ResourceState::Final);
+    CORRADE_COMPARE(*a2, 3);
+}
+
+void ResourceManagerTest::slotReuse() {
+    ResourceManager rm;
+
+    {
+        Resource<Int> a = rm.get<Int>("a");
+        rm.set("a", 1, ResourceDataState::Mutable, ResourcePolicy::ReferenceCounted);
+        CORRADE_COMPARE(*a, 1);
+    }
+    CORRADE_COMPARE(rm.count<Int>(), 0);
+
+    /* New resource gets the released slot, but doesn't see the old data */
+    Resource<Int> b = rm.get<Int>("b");
+    CORRADE_COMPARE(rm.count<Int>(), 1);
+    CORRADE_COMPARE(b.state(), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.state<Int>("a"), ResourceState::NotLoaded);
+
+    rm.set("b", 2, ResourceDataState::Mutable, ResourcePolicy::Manual);
+    CORRADE_COMPARE(*b, 2);
+
+    /* Growing the storage doesn't affect existing resources */
+    for(Int i = 0; i != 100; ++i)
+        rm.set(std::to_string(i), i, ResourceDataState::Final, ResourcePolicy::Manual);
+    CORRADE_COMPARE(rm.count<Int>(), 101);
+    CORRADE_COMPARE(*b, 2);
+    CORRADE_COMPARE(*rm.get<Int>("42"), 42);
+
+    rm.free();
+    CORRADE_COMPARE(rm.count<Int>(), 1);
+    CORRADE_COMPARE(*b, 2);
+}
+
 void ResourceManagerTest::loader() {
     class IntResourceLoader: public AbstractResourceLoader<Int> {
         public:
@@ -316,6 +465,166 @@ void ResourceManagerTest::loader() {
     CORRADE_COMPARE(Data::count, 0);
 }
 
+namespace {
+
+/* Blocks the jobs while set, counts started jobs */
+std::atomic<bool> asyncGate(false);
+std::atomic<Int> asyncStarted(0);
+
+class AsyncResourceLoader: public AbstractResourceLoader<Int> {
+    public:
+        std::vector<Int> order;
+
+        /* Calls update() until everything is loaded or one second elapses */
+        bool finish() {
+            const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+            while(pendingCount()) {
+                if(std::chrono::steady_clock::now() > end) return false;
+                update();
+                std::this_thread::yield();
+            }
+            return true;
+        }
+
+    private:
+        void doLoad(ResourceKey key) override {
+            Int value = 0;
+            if(key == ResourceKey("one")) value = 1;
+            else if(key == ResourceKey("two")) value = 2;
+            else if(key == ResourceKey("three")) value = 3;
+
+            loadAsync(key, [this, key, value]() -> std::function<void()> {
+                ++asyncStarted;
+                while(asyncGate) std::this_thread::yield();
+                if(!value) return nullptr;
+
+                return [this, key, value]() {
+                    order.push_back(value);
+                    set(key, value, ResourceDataState::Final, ResourcePolicy::Resident);
+                };
+            });
+        }
+};
+
+}
+
+void ResourceManagerTest::loaderAsync() {
+    ResourceManager rm;
+    auto loader = new AsyncResourceLoader;
+    rm.setLoader(loader);
+    CORRADE_COMPARE(loader->workerCount(), 1);
+
+    Resource<Int> one = rm.get<Int>("one");
+    Resource<Int> two = rm.get<Int>("two");
+    Resource<Int> missing = rm.get<Int>("missing");
+    CORRADE_COMPARE(loader->requestedCount(), 3);
+
+    CORRADE_VERIFY(loader->finish());
+    CORRADE_COMPARE(one.state(), ResourceState::Final);
+    CORRADE_COMPARE(*one, 1);
+    CORRADE_COMPARE(*two, 2);
+    CORRADE_COMPARE(missing.state(), ResourceState::NotFound);
+    CORRADE_COMPARE(loader->loadedCount(), 2);
+    CORRADE_COMPARE(loader->notFoundCount(), 1);
+    CORRADE_COMPARE(loader->cancelledCount(), 0);
+}
+
+void ResourceManagerTest::loaderAsyncNoWorkers() {
+    ResourceManager rm;
+    auto loader = new AsyncResourceLoader;
+    loader->setWorkerCount(0);
+    rm.setLoader(loader);
+
+    /* Executed directly, but finished only in update() */
+    Resource<Int> one = rm.get<Int>("one");
+    Resource<Int> two = rm.get<Int>("two");
+    CORRADE_COMPARE(loader->pendingCount(), 2);
+    CORRADE_COMPARE(one.state(), ResourceState::Loading);
+
+    /* Zero budget finishes only one load */
+    CORRADE_COMPARE(loader->update(0.0f), 1);
+    CORRADE_COMPARE(loader->pendingCount(), 1);
+    CORRADE_COMPARE(*one, 1);
+    CORRADE_COMPARE(two.state(), ResourceState::Loading);
+
+    CORRADE_COMPARE(loader->update(), 1);
+    CORRADE_COMPARE(*two, 2);
+}
+
+void ResourceManagerTest::loaderAsyncPriority() {
+    ResourceManager rm;
+    auto loader = new AsyncResourceLoader;
+    rm.setLoader(loader);
+
+    /* The first job blocks the only worker */
+    asyncGate = true;
+    asyncStarted = 0;
+    Resource<Int> three = rm.get<Int>("three");
+    while(!asyncStarted) std::this_thread::yield();
+    Resource<Int> one = rm.get<Int>("one");
+    Resource<Int> two = rm.get<Int>("two");
+    Resource<Int> twoCopy1 = two, twoCopy2 = two;
+
+    /* More referenced resource is loaded first */
+    loader->update();
+    asyncGate = false;
+    CORRADE_VERIFY(loader->finish());
+    CORRADE_COMPARE(loader->order, (std::vector<Int>{3, 2, 1}));
+}
+
+void ResourceManagerTest::loaderAsyncPushPriority() {
+    ResourceManager rm;
+    auto loader = new AsyncResourceLoader;
+    rm.setLoader(loader);
+
+    asyncGate = true;
+    asyncStarted = 0;
+    Resource<Int> three = rm.get<Int>("three");
+    while(!asyncStarted) std::this_thread::yield();
+
+    /* Not referenced at the time of the request */
+    loader->load("one");
+    Resource<Int> one = rm.get<Int>("one");
+
+    /* Referenced already when requested, loaded first even without update() */
+    Resource<Int> two = rm.get<Int>("two");
+    asyncGate = false;
+    while(asyncStarted != 3) std::this_thread::yield();
+    CORRADE_VERIFY(loader->finish());
+    CORRADE_COMPARE(loader->order, (std::vector<Int>{3, 2, 1}));
+}
+
+void ResourceManagerTest::loaderAsyncCancel() {
+    ResourceManager rm;
+    auto loader = new AsyncResourceLoader;
+    rm.setLoader(loader);
+
+    asyncGate = true;
+    {
+        Resource<Int> three = rm.get<Int>("three");
+        rm.get<Int>("one");
+
+        /* Queued job of unreferenced resource is cancelled */
+        loader->update();
+        CORRADE_COMPARE(loader->cancelledCount(), 1);
+        CORRADE_COMPARE(rm.state<Int>("one"), ResourceState::NotLoaded);
+        CORRADE_COMPARE(rm.count<Int>(), 1);
+    }
+
+    /* Running job is cancelled when it finishes */
+    asyncGate = false;
+    CORRADE_VERIFY(loader->finish());
+    CORRADE_COMPARE(loader->cancelledCount(), 2);
+    CORRADE_COMPARE(loader->loadedCount(), 0);
+    CORRADE_COMPARE(rm.count<Int>(), 0);
+
+    /* Cancelled resource can be requested again */
+    Resource<Int> one = rm.get<Int>("one");
+    CORRADE_COMPARE(loader->requestedCount(), 3);
+    CORRADE_VERIFY(loader->finish());
+    CORRADE_COMPARE(*one, 1);
+}
+
 }}
 
 CORRADE_TEST_MAIN(Magnum::Test::ResourceManagerTest)
@@ -0,0 +1,71 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <TestSuite/Tester.h>
+
+#include "Magnum.h"
+#include "Timeline.h"
+
+namespace Magnum { namespace Test {
+
+class TimelineTest: public TestSuite::Tester {
+    public:
+        explicit TimelineTest();
+
+        void stopped();
+        void minimalFrameTime();
+};
+
+TimelineTest::TimelineTest() {
+    addTests({&TimelineTest::stopped,
+              &TimelineTest::minimalFrameTime});
+}
+
+void TimelineTest::stopped() {
+    Timeline t;
+    t.nextFrame();
+    CORRADE_COMPARE(t.previousFrameTime(), 0.0f);
+    CORRADE_COMPARE(t.previousFrameDuration(), 0.0f);
+}
+
+void TimelineTest::minimalFrameTime() {
+    Timeline t;
+    t.setMinimalFrameTime(0.005f)
+        .start();
+
+    const auto begin = std::chrono::high_resolution_clock::now();
+    for(std::size_t i = 0; i != 10; ++i) {
+        t.nextFrame();
+        CORRADE_VERIFY(t.previousFrameDuration() >= 0.005f);
+    }
+    const Float elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - begin).count()/1e6f;
+
+    CORRADE_VERIFY(t.previousFrameTime() >= 0.05f);
+    CORRADE_VERIFY(t.previousFrameTime() <= elapsed + 0.001f);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::TimelineTest)
@@ -24,8 +24,8 @@
 
 #include "Timeline.h"
 
+#include <thread>
 #include <Utility/Debug.h>
-#include <Utility/utilities.h>
 
 #include "Magnum.h"
 
@@ -33,6 +33,16 @@ using namespace std::chrono;
 
 namespace Magnum {
 
+namespace {
+    /* Remaining time which is spinned instead of slept, as the OS scheduler
+       might wake the thread up considerably later than requested */
+    #ifndef CORRADE_TARGET_WINDOWS
+    constexpr microseconds SpinTime{1000};
+    #else
+    constexpr microseconds SpinTime{2000};
+    #endif
+}
+
 void Timeline::start() {
     running = true;
     _startTime = high_resolution_clock::now();
@@ -51,15 +61,17 @@ void Timeline::nextFrame() {
     if(!running) return;
 
     auto now = high_resolution_clock::now();
-    auto duration = UnsignedInt(duration_cast<microseconds>(now-_previousFrameTime).count());
-    _previousFrameDuration = duration/1e6f;
 
-    if(_previousFrameDuration < _minimalFrameTime) {
-        Utility::sleep(std::size_t(_minimalFrameTime*1000) - duration/1000);
-        now = high_resolution_clock::now();
-        _previousFrameDuration = duration_cast<microseconds>(now-_previousFrameTime).count()/1e6f;
+    /* Sleep for most of the remaining frame time and spin the rest */
+    const auto deadline = _previousFrameTime + duration_cast<high_resolution_clock::duration>(duration<Float>(_minimalFrameTime));
+    if(now < deadline) {
+        if(deadline - now > SpinTime)
+            std::this_thread::sleep_for(deadline - now - SpinTime);
+        while((now = high_resolution_clock::now()) < deadline)
+            std::this_thread::yield();
     }
 
+    _previousFrameDuration = duration_cast<microseconds>(now-_previousFrameTime).count()/1e6f;
     _previousFrameTime = now;
 }
 
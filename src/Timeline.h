@@ -56,6 +56,8 @@ performed, after everything is properly initialized.
 
 In your draw event implementation don't forget to call nextFrame() after
 buffer swap. You can use previousFrameDuration() to compute animation speed.
+If the simulation needs to run at fixed rate independently of rendering, use
+@ref FixedTimestep.
 
 Example usage:
 @code
@@ -125,7 +127,10 @@ class MAGNUM_EXPORT Timeline {
          * @brief Advance to next frame
          *
          * If current frame time is smaller than minimal frame time, pauses
-         * the execution for remaining time.
+         * the execution for remaining time. To not overshoot the time due to
+         * coarse OS scheduler granularity, the thread sleeps only for most of
+         * the remaining time and busy-waits the last one or two milliseconds,
+         * depending on the platform.
          * @note This function does nothing if the timeline is stopped.
          * @see setMinimalFrameTime(), stop()
          */
@@ -24,10 +24,12 @@
 
 #include "AbstractImporter.h"
 
+#include <algorithm>
 #include <Containers/Array.h>
 #include <Utility/Assert.h>
 #include <Utility/Directory.h>
 
+#include "ImageReference.h"
 #include "Trade/AbstractMaterialData.h"
 #include "Trade/CameraData.h"
 #include "Trade/ImageData.h"
@@ -41,6 +43,17 @@
 
 namespace Magnum { namespace Trade {
 
+namespace {
+    template<UnsignedInt dimensions> std::optional<ImageData<dimensions>> copyImage(const std::optional<ImageReference<dimensions>>& image) {
+        if(!image) return std::nullopt;
+
+        const std::size_t size = image->pixelSize()*image->size().product();
+        unsigned char* const data = new unsigned char[size];
+        std::copy(image->data(), image->data() + size, data);
+        return ImageData<dimensions>(image->format(), image->type(), image->size(), data);
+    }
+}
+
 AbstractImporter::AbstractImporter() = default;
 
 AbstractImporter::AbstractImporter(PluginManager::AbstractManager& manager, std::string plugin): AbstractPlugin(manager, std::move(plugin)) {}
@@ -388,7 +401,17 @@ std::optional<ImageData1D> AbstractImporter::image1D(const UnsignedInt id) {
     return doImage1D(id);
 }
 
-std::optional<ImageData1D> AbstractImporter::doImage1D(UnsignedInt) { return std::nullopt; }
+std::optional<ImageData1D> AbstractImporter::doImage1D(const UnsignedInt id) {
+    return copyImage(doImage1DReference(id));
+}
+
+std::optional<ImageReference1D> AbstractImporter::image1DReference(const UnsignedInt id) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::image1DReference(): no file opened", {});
+    CORRADE_ASSERT(id < doImage1DCount(), "Trade::AbstractImporter::image1DReference(): index out of range", {});
+    return doImage1DReference(id);
+}
+
+std::optional<ImageReference1D> AbstractImporter::doImage1DReference(UnsignedInt) { return std::nullopt; }
 
 UnsignedInt AbstractImporter::image2DCount() const {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::image2DCount(): no file opened", {});
@@ -418,7 +441,17 @@ std::optional<ImageData2D> AbstractImporter::image2D(const UnsignedInt id) {
     return doImage2D(id);
 }
 
-std::optional<ImageData2D> AbstractImporter::doImage2D(UnsignedInt) { return std::nullopt; }
+std::optional<ImageData2D> AbstractImporter::doImage2D(const UnsignedInt id) {
+    return copyImage(doImage2DReference(id));
+}
+
+std::optional<ImageReference2D> AbstractImporter::image2DReference(const UnsignedInt id) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::image2DReference(): no file opened", {});
+    CORRADE_ASSERT(id < doImage2DCount(), "Trade::AbstractImporter::image2DReference(): index out of range", {});
+    return doImage2DReference(id);
+}
+
+std::optional<ImageReference2D> AbstractImporter::doImage2DReference(UnsignedInt) { return std::nullopt; }
 
 UnsignedInt AbstractImporter::image3DCount() const {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::image3DCount(): no file opened", {});
@@ -448,6 +481,16 @@ std::optional<ImageData3D> AbstractImporter::image3D(const UnsignedInt id) {
     return doImage3D(id);
 }
 
-std::optional<ImageData3D> AbstractImporter::doImage3D(UnsignedInt) { return std::nullopt; }
+std::optional<ImageData3D> AbstractImporter::doImage3D(const UnsignedInt id) {
+    return copyImage(doImage3DReference(id));
+}
+
+std::optional<ImageReference3D> AbstractImporter::image3DReference(const UnsignedInt id) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::image3DReference(): no file opened", {});
+    CORRADE_ASSERT(id < doImage3DCount(), "Trade::AbstractImporter::image3DReference(): index out of range", {});
+    return doImage3DReference(id);
+}
+
+std::optional<ImageReference3D> AbstractImporter::doImage3DReference(UnsignedInt) { return std::nullopt; }
 
 }}
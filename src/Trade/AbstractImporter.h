@@ -72,10 +72,23 @@ checked by the implementation:
 -   All `do*()` implementations taking data ID as parameter are called only if
     the ID is from valid range.
 
+@section AbstractImporter-references Zero-copy image access
+
+Functions image1DReference(), image2DReference() and image3DReference()
+return non-owning references to pixel data stored directly in the importer
+(e.g. in memory-mapped file), avoiding copying the data. The references are
+valid only until the file is closed. The plugin implements them in
+doImage1DReference(), doImage2DReference() and doImage3DReference() if the
+pixel data don't need to be decoded or converted. Default implementation of
+doImage1D(), doImage2D() and doImage3D() copies the data from these, so the
+plugin which can always return a reference doesn't need to implement the
+copying variant at all. The ownership is thus transferred only if the user
+explicitly asks for it by calling image1D(), image2D() or image3D().
+
 @todo How to handle casting from std::unique_ptr<> in more convenient way?
 */
 class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractPlugin {
-    CORRADE_PLUGIN_INTERFACE("cz.mosra.magnum.Trade.AbstractImporter/0.3")
+    CORRADE_PLUGIN_INTERFACE("cz.mosra.magnum.Trade.AbstractImporter/0.4")
 
     public:
         /**
@@ -407,9 +420,22 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractPlugin {
          * @param id        %Image ID, from range [0, image1DCount()).
          *
          * Returns given image or `std::nullopt` if importing failed.
+         * @see image1DReference()
          */
         std::optional<ImageData1D> image1D(UnsignedInt id);
 
+        /**
+         * @brief Reference to one-dimensional image data
+         * @param id        %Image ID, from range [0, image1DCount()).
+         *
+         * Unlike image1D() the pixel data are not copied, the returned
+         * reference is valid only until the file is closed. Returns
+         * `std::nullopt` if importing failed or if the data can't be
+         * referenced directly, use image1D() in that case.
+         * @see @ref AbstractImporter-references "Zero-copy image access"
+         */
+        std::optional<ImageReference1D> image1DReference(UnsignedInt id);
+
         /** @brief Two-dimensional image count */
         UnsignedInt image2DCount() const;
 
@@ -434,9 +460,22 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractPlugin {
          * @param id        %Image ID, from range [0, image2DCount()).
          *
          * Returns given image or `std::nullopt` if importing failed.
+         * @see image2DReference()
          */
         std::optional<ImageData2D> image2D(UnsignedInt id);
 
+        /**
+         * @brief Reference to two-dimensional image data
+         * @param id        %Image ID, from range [0, image2DCount()).
+         *
+         * Unlike image2D() the pixel data are not copied, the returned
+         * reference is valid only until the file is closed. Returns
+         * `std::nullopt` if importing failed or if the data can't be
+         * referenced directly, use image2D() in that case.
+         * @see @ref AbstractImporter-references "Zero-copy image access"
+         */
+        std::optional<ImageReference2D> image2DReference(UnsignedInt id);
+
         /** @brief Three-dimensional image count */
         UnsignedInt image3DCount() const;
 
@@ -461,9 +500,22 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractPlugin {
          * @param id        %Image ID, from range [0, image3DCount()).
          *
          * Returns given image or `std::nullopt` if importing failed.
+         * @see image3DReference()
          */
         std::optional<ImageData3D> image3D(UnsignedInt id);
 
+        /**
+         * @brief Reference to three-dimensional image data
+         * @param id        %Image ID, from range [0, image3DCount()).
+         *
+         * Unlike image3D() the pixel data are not copied, the returned
+         * reference is valid only until the file is closed. Returns
+         * `std::nullopt` if importing failed or if the data can't be
+         * referenced directly, use image3D() in that case.
+         * @see @ref AbstractImporter-references "Zero-copy image access"
+         */
+        std::optional<ImageReference3D> image3DReference(UnsignedInt id);
+
         /*@}*/
 
     #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -611,9 +663,17 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractPlugin {
         /** @brief Implementation for image1DName() */
         virtual std::string doImage1DName(UnsignedInt id);
 
-        /** @brief Implementation for image1D() */
+        /**
+         * @brief Implementation for image1D()
+         *
+         * Default implementation copies the data returned from
+         * doImage1DReference().
+         */
         virtual std::optional<ImageData1D> doImage1D(UnsignedInt id);
 
+        /** @brief Implementation for image1DReference() */
+        virtual std::optional<ImageReference1D> doImage1DReference(UnsignedInt id);
+
         /** @brief Implementation for image2DCount() */
         virtual UnsignedInt doImage2DCount() const;
 
@@ -623,9 +683,17 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractPlugin {
         /** @brief Implementation for image2DName() */
         virtual std::string doImage2DName(UnsignedInt id);
 
-        /** @brief Implementation for image2D() */
+        /**
+         * @brief Implementation for image2D()
+         *
+         * Default implementation copies the data returned from
+         * doImage2DReference().
+         */
         virtual std::optional<ImageData2D> doImage2D(UnsignedInt id);
 
+        /** @brief Implementation for image2DReference() */
+        virtual std::optional<ImageReference2D> doImage2DReference(UnsignedInt id);
+
         /** @brief Implementation for image3DCount() */
         virtual UnsignedInt doImage3DCount() const;
 
@@ -635,8 +703,16 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractPlugin {
         /** @brief Implementation for image3DName() */
         virtual std::string doImage3DName(UnsignedInt id);
 
-        /** @brief Implementation for image3D() */
+        /**
+         * @brief Implementation for image3D()
+         *
+         * Default implementation copies the data returned from
+         * doImage3DReference().
+         */
         virtual std::optional<ImageData3D> doImage3D(UnsignedInt id);
+
+        /** @brief Implementation for image3DReference() */
+        virtual std::optional<ImageReference3D> doImage3DReference(UnsignedInt id);
 };
 
 CORRADE_ENUMSET_OPERATORS(AbstractImporter::Features)
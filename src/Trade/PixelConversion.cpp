@@ -0,0 +1,182 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+*/
+
+#include "PixelConversion.h"
+
+#include <Utility/Assert.h>
+
+#include "Math/Swizzle.h"
+#include "Math/Vector4.h"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MAGNUM_TRADE_PIXELCONVERSION_NEON
+#endif
+
+namespace Magnum { namespace Trade {
+
+void swizzleBgrToRgb(const Containers::ArrayReference<const UnsignedByte> in, const Containers::ArrayReference<UnsignedByte> out) {
+    CORRADE_ASSERT(in.size() == out.size() && in.size()%3 == 0,
+        "Trade::swizzleBgrToRgb(): expected input and output of the same size divisible by 3, got" << in.size() << "and" << out.size(), );
+
+    std::size_t i = 0;
+
+    /* Shuffle five pixels at once, the sixteenth byte is kept as-is so it can
+       be safely written even if converting in place */
+    #if defined(__SSSE3__)
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+    for(; i + 16 <= in.size(); i += 15) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_shuffle_epi8(pixels, shuffle));
+    }
+
+    /* Deinterleave sixteen pixels into channels and interleave them back in
+       reverse order */
+    #elif defined(MAGNUM_TRADE_PIXELCONVERSION_NEON)
+    for(; i + 48 <= in.size(); i += 48) {
+        const uint8x16x3_t pixels = vld3q_u8(in + i);
+        const uint8x16x3_t swizzled = {{pixels.val[2], pixels.val[1], pixels.val[0]}};
+        vst3q_u8(out + i, swizzled);
+    }
+    #endif
+
+    for(; i != in.size(); i += 3) {
+        const UnsignedByte blue = in[i];
+        out[i + 1] = in[i + 1];
+        out[i] = in[i + 2];
+        out[i + 2] = blue;
+    }
+}
+
+void swizzleBgraToRgba(const Containers::ArrayReference<const UnsignedByte> in, const Containers::ArrayReference<UnsignedByte> out) {
+    CORRADE_ASSERT(in.size() == out.size() && in.size()%4 == 0,
+        "Trade::swizzleBgraToRgba(): expected input and output of the same size divisible by 4, got" << in.size() << "and" << out.size(), );
+
+    /* Whole sixteen-byte blocks are swizzled using a single byte shuffle if
+       SSSE3 or NEON is available */
+    Math::swizzle<'b', 'g', 'r', 'a'>(
+        Containers::ArrayReference<const Math::Vector4<UnsignedByte>>{reinterpret_cast<const Math::Vector4<UnsignedByte>*>(in.data()), in.size()/4},
+        {reinterpret_cast<Math::Vector4<UnsignedByte>*>(out.data()), out.size()/4});
+}
+
+void grayscaleToRgb(const Containers::ArrayReference<const UnsignedByte> in, const Containers::ArrayReference<UnsignedByte> out) {
+    CORRADE_ASSERT(in.size()*3 == out.size(),
+        "Trade::grayscaleToRgb(): expected output three times larger than input, got" << in.size() << "and" << out.size(), );
+
+    std::size_t i = 0;
+
+    /* Sixteen input pixels are spread into three output vectors */
+    #if defined(__SSSE3__)
+    const __m128i shuffle0 = _mm_setr_epi8(0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4, 4, 5);
+    const __m128i shuffle1 = _mm_setr_epi8(5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10);
+    const __m128i shuffle2 = _mm_setr_epi8(10, 11, 11, 11, 12, 12, 12, 13, 13, 13, 14, 14, 14, 15, 15, 15);
+    for(; i + 16 <= in.size(); i += 16) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i* const output = reinterpret_cast<__m128i*>(out + i*3);
+        _mm_storeu_si128(output + 0, _mm_shuffle_epi8(pixels, shuffle0));
+        _mm_storeu_si128(output + 1, _mm_shuffle_epi8(pixels, shuffle1));
+        _mm_storeu_si128(output + 2, _mm_shuffle_epi8(pixels, shuffle2));
+    }
+    #elif defined(MAGNUM_TRADE_PIXELCONVERSION_NEON)
+    for(; i + 16 <= in.size(); i += 16) {
+        const uint8x16_t pixels = vld1q_u8(in + i);
+        const uint8x16x3_t expanded = {{pixels, pixels, pixels}};
+        vst3q_u8(out + i*3, expanded);
+    }
+    #endif
+
+    for(; i != in.size(); ++i)
+        out[i*3] = out[i*3 + 1] = out[i*3 + 2] = in[i];
+}
+
+void grayscaleToRgba(const Containers::ArrayReference<const UnsignedByte> in, const Containers::ArrayReference<UnsignedByte> out) {
+    CORRADE_ASSERT(in.size()*4 == out.size(),
+        "Trade::grayscaleToRgba(): expected output four times larger than input, got" << in.size() << "and" << out.size(), );
+
+    std::size_t i = 0;
+
+    /* Sixteen input pixels are spread into four output vectors, the alpha
+       bytes are zeroed by the shuffle and then filled with 255 */
+    #if defined(__SSSE3__)
+    const __m128i alpha = _mm_set1_epi32(0xff000000);
+    const __m128i shuffle0 = _mm_setr_epi8(0, 0, 0, -1, 1, 1, 1, -1, 2, 2, 2, -1, 3, 3, 3, -1);
+    const __m128i shuffle1 = _mm_setr_epi8(4, 4, 4, -1, 5, 5, 5, -1, 6, 6, 6, -1, 7, 7, 7, -1);
+    const __m128i shuffle2 = _mm_setr_epi8(8, 8, 8, -1, 9, 9, 9, -1, 10, 10, 10, -1, 11, 11, 11, -1);
+    const __m128i shuffle3 = _mm_setr_epi8(12, 12, 12, -1, 13, 13, 13, -1, 14, 14, 14, -1, 15, 15, 15, -1);
+    for(; i + 16 <= in.size(); i += 16) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i* const output = reinterpret_cast<__m128i*>(out + i*4);
+        _mm_storeu_si128(output + 0, _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle0), alpha));
+        _mm_storeu_si128(output + 1, _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle1), alpha));
+        _mm_storeu_si128(output + 2, _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle2), alpha));
+        _mm_storeu_si128(output + 3, _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle3), alpha));
+    }
+    #elif defined(MAGNUM_TRADE_PIXELCONVERSION_NEON)
+    const uint8x16_t alpha = vdupq_n_u8(255);
+    for(; i + 16 <= in.size(); i += 16) {
+        const uint8x16_t pixels = vld1q_u8(in + i);
+        const uint8x16x4_t expanded = {{pixels, pixels, pixels, alpha}};
+        vst4q_u8(out + i*4, expanded);
+    }
+    #endif
+
+    for(; i != in.size(); ++i) {
+        out[i*4] = out[i*4 + 1] = out[i*4 + 2] = in[i];
+        out[i*4 + 3] = 255;
+    }
+}
+
+void expandTo16Bit(const Containers::ArrayReference<const UnsignedByte> in, const Containers::ArrayReference<UnsignedShort> out) {
+    CORRADE_ASSERT(in.size() == out.size(),
+        "Trade::expandTo16Bit(): expected input and output of the same size, got" << in.size() << "and" << out.size(), );
+
+    std::size_t i = 0;
+
+    /* Multiplying by 257 is the same as duplicating the byte, which is done by
+       interleaving the input with itself. Endianness doesn't matter. */
+    #if defined(__SSE2__)
+    for(; i + 16 <= in.size(); i += 16) {
+        const __m128i channels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i* const output = reinterpret_cast<__m128i*>(out + i);
+        _mm_storeu_si128(output + 0, _mm_unpacklo_epi8(channels, channels));
+        _mm_storeu_si128(output + 1, _mm_unpackhi_epi8(channels, channels));
+    }
+    #elif defined(MAGNUM_TRADE_PIXELCONVERSION_NEON)
+    for(; i + 16 <= in.size(); i += 16) {
+        const uint8x16_t channels = vld1q_u8(in + i);
+        const uint8x16x2_t expanded = {{channels, channels}};
+        vst2q_u8(reinterpret_cast<uint8_t*>(out + i), expanded);
+    }
+    #endif
+
+    for(; i != in.size(); ++i)
+        out[i] = in[i]*257;
+}
+
+}}
@@ -0,0 +1,90 @@
+#ifndef Magnum_Trade_PixelConversion_h
+#define Magnum_Trade_PixelConversion_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Trade::swizzleBgrToRgb(), @ref Magnum::Trade::swizzleBgraToRgba(), @ref Magnum::Trade::grayscaleToRgb(), @ref Magnum::Trade::grayscaleToRgba(), @ref Magnum::Trade::expandTo16Bit()
+ *
+ * Conversion kernels for importers and image converters, working on tightly
+ * packed 8-bit channels. If compiled with SSSE3 or NEON instructions enabled
+ * (e.g. `-mssse3` or `-mfpu=neon`), whole blocks of pixels are converted with
+ * single byte shuffles, the remaining pixels are converted with scalar code.
+ */
+
+#include <Containers/Array.h>
+
+#include "Magnum.h"
+#include "magnumVisibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Swizzle BGR pixels to RGB
+@param in       Input pixels
+@param out      Output pixels, must have the same size as @p in
+
+The conversion is symmetric, thus it can be used for converting RGB pixels to
+BGR as well. The input and output can be the same array.
+*/
+void MAGNUM_EXPORT swizzleBgrToRgb(Containers::ArrayReference<const UnsignedByte> in, Containers::ArrayReference<UnsignedByte> out);
+
+/**
+@brief Swizzle BGRA pixels to RGBA
+@param in       Input pixels
+@param out      Output pixels, must have the same size as @p in
+
+The conversion is symmetric, thus it can be used for converting RGBA pixels to
+BGRA as well. The input and output can be the same array.
+*/
+void MAGNUM_EXPORT swizzleBgraToRgba(Containers::ArrayReference<const UnsignedByte> in, Containers::ArrayReference<UnsignedByte> out);
+
+/**
+@brief Expand grayscale pixels to RGB
+@param in       Input pixels
+@param out      Output pixels, must be three times larger than @p in
+*/
+void MAGNUM_EXPORT grayscaleToRgb(Containers::ArrayReference<const UnsignedByte> in, Containers::ArrayReference<UnsignedByte> out);
+
+/**
+@brief Expand grayscale pixels to RGBA
+@param in       Input pixels
+@param out      Output pixels, must be four times larger than @p in
+
+Alpha channel is set to `255`.
+*/
+void MAGNUM_EXPORT grayscaleToRgba(Containers::ArrayReference<const UnsignedByte> in, Containers::ArrayReference<UnsignedByte> out);
+
+/**
+@brief Expand 8-bit channels to 16 bits
+@param in       Input channels
+@param out      Output channels, must have the same size as @p in
+
+The whole range is preserved, i.e. `255` is converted to `65535`.
+*/
+void MAGNUM_EXPORT expandTo16Bit(Containers::ArrayReference<const UnsignedByte> in, Containers::ArrayReference<UnsignedShort> out);
+
+}}
+
+#endif
@@ -26,7 +26,10 @@
 #include <TestSuite/Tester.h>
 #include <Utility/Directory.h>
 
+#include "ColorFormat.h"
+#include "ImageReference.h"
 #include "Trade/AbstractImporter.h"
+#include "Trade/ImageData.h"
 
 #include "testConfigure.h"
 
@@ -37,10 +40,14 @@ class AbstractImporterTest: public TestSuite::Tester {
         explicit AbstractImporterTest();
 
         void openFile();
+        void imageReference();
+        void imageReferenceNotAvailable();
 };
 
 AbstractImporterTest::AbstractImporterTest() {
-    addTests({&AbstractImporterTest::openFile});
+    addTests({&AbstractImporterTest::openFile,
+              &AbstractImporterTest::imageReference,
+              &AbstractImporterTest::imageReferenceNotAvailable});
 }
 
 void AbstractImporterTest::openFile() {
@@ -67,6 +74,56 @@ void AbstractImporterTest::openFile() {
     CORRADE_VERIFY(importer.isOpened());
 }
 
+namespace {
+
+class ReferenceImporter: public Trade::AbstractImporter {
+    public:
+        explicit ReferenceImporter(bool available): available(available) {}
+
+        const unsigned char data[6]{1, 2, 3, 4, 5, 6};
+
+    private:
+        Features doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 1; }
+        std::optional<ImageReference2D> doImage2DReference(UnsignedInt) override {
+            if(!available) return std::nullopt;
+            return ImageReference2D(ColorFormat::Red, ColorType::UnsignedByte, {2, 3}, data);
+        }
+
+        bool available;
+};
+
+}
+
+void AbstractImporterTest::imageReference() {
+    ReferenceImporter importer(true);
+
+    /* The reference points to importer data */
+    std::optional<ImageReference2D> reference = importer.image2DReference(0);
+    CORRADE_VERIFY(reference);
+    CORRADE_VERIFY(reference->data() == importer.data);
+    CORRADE_COMPARE(reference->size(), Vector2i(2, 3));
+
+    /* Default doImage2D() implementation makes a copy */
+    std::optional<ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(image->data() != importer.data);
+    CORRADE_COMPARE(image->format(), ColorFormat::Red);
+    CORRADE_COMPARE(image->type(), ColorType::UnsignedByte);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE(std::string(reinterpret_cast<const char*>(image->data()), 6),
+                    std::string(reinterpret_cast<const char*>(importer.data), 6));
+}
+
+void AbstractImporterTest::imageReferenceNotAvailable() {
+    ReferenceImporter importer(false);
+    CORRADE_VERIFY(!importer.image2DReference(0));
+    CORRADE_VERIFY(!importer.image2D(0));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::AbstractImporterTest)
@@ -0,0 +1,162 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <vector>
+#include <TestSuite/Tester.h>
+
+#include "Trade/PixelConversion.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+class PixelConversionTest: public TestSuite::Tester {
+    public:
+        explicit PixelConversionTest();
+
+        void bgrToRgb();
+        void bgrToRgbInPlace();
+        void bgraToRgba();
+        void bgraToRgbaInPlace();
+        void grayscaleToRgb();
+        void grayscaleToRgba();
+        void expandTo16Bit();
+};
+
+PixelConversionTest::PixelConversionTest() {
+    addTests({&PixelConversionTest::bgrToRgb,
+              &PixelConversionTest::bgrToRgbInPlace,
+              &PixelConversionTest::bgraToRgba,
+              &PixelConversionTest::bgraToRgbaInPlace,
+              &PixelConversionTest::grayscaleToRgb,
+              &PixelConversionTest::grayscaleToRgba,
+              &PixelConversionTest::expandTo16Bit});
+}
+
+namespace {
+    /* Odd pixel count to test both vectorized and scalar code paths */
+    constexpr std::size_t Count = 37;
+
+    std::vector<UnsignedByte> pixels(const std::size_t size) {
+        std::vector<UnsignedByte> out(size);
+        for(std::size_t i = 0; i != size; ++i) out[i] = UnsignedByte(i*7 + 3);
+        return out;
+    }
+}
+
+void PixelConversionTest::bgrToRgb() {
+    const std::vector<UnsignedByte> in = pixels(Count*3);
+    std::vector<UnsignedByte> expected(Count*3);
+    for(std::size_t i = 0; i != Count; ++i) {
+        expected[i*3 + 0] = in[i*3 + 2];
+        expected[i*3 + 1] = in[i*3 + 1];
+        expected[i*3 + 2] = in[i*3 + 0];
+    }
+
+    std::vector<UnsignedByte> out(Count*3);
+    Trade::swizzleBgrToRgb({in.data(), in.size()}, {out.data(), out.size()});
+    CORRADE_COMPARE(out, expected);
+}
+
+void PixelConversionTest::bgrToRgbInPlace() {
+    const std::vector<UnsignedByte> in = pixels(Count*3);
+    std::vector<UnsignedByte> data = in;
+
+    /* Converting twice gives back the original */
+    Trade::swizzleBgrToRgb({data.data(), data.size()}, {data.data(), data.size()});
+    CORRADE_VERIFY(data != in);
+    CORRADE_COMPARE(data[0], in[2]);
+    CORRADE_COMPARE(data[Count*3 - 1], in[Count*3 - 3]);
+    Trade::swizzleBgrToRgb({data.data(), data.size()}, {data.data(), data.size()});
+    CORRADE_COMPARE(data, in);
+}
+
+void PixelConversionTest::bgraToRgba() {
+    const std::vector<UnsignedByte> in = pixels(Count*4);
+    std::vector<UnsignedByte> expected(Count*4);
+    for(std::size_t i = 0; i != Count; ++i) {
+        expected[i*4 + 0] = in[i*4 + 2];
+        expected[i*4 + 1] = in[i*4 + 1];
+        expected[i*4 + 2] = in[i*4 + 0];
+        expected[i*4 + 3] = in[i*4 + 3];
+    }
+
+    std::vector<UnsignedByte> out(Count*4);
+    Trade::swizzleBgraToRgba({in.data(), in.size()}, {out.data(), out.size()});
+    CORRADE_COMPARE(out, expected);
+}
+
+void PixelConversionTest::bgraToRgbaInPlace() {
+    const std::vector<UnsignedByte> in = pixels(Count*4);
+    std::vector<UnsignedByte> data = in;
+
+    Trade::swizzleBgraToRgba({data.data(), data.size()}, {data.data(), data.size()});
+    CORRADE_VERIFY(data != in);
+    CORRADE_COMPARE(data[0], in[2]);
+    CORRADE_COMPARE(data[Count*4 - 2], in[Count*4 - 4]);
+    Trade::swizzleBgraToRgba({data.data(), data.size()}, {data.data(), data.size()});
+    CORRADE_COMPARE(data, in);
+}
+
+void PixelConversionTest::grayscaleToRgb() {
+    const std::vector<UnsignedByte> in = pixels(Count);
+    std::vector<UnsignedByte> expected(Count*3);
+    for(std::size_t i = 0; i != Count; ++i)
+        expected[i*3 + 0] = expected[i*3 + 1] = expected[i*3 + 2] = in[i];
+
+    std::vector<UnsignedByte> out(Count*3);
+    Trade::grayscaleToRgb({in.data(), in.size()}, {out.data(), out.size()});
+    CORRADE_COMPARE(out, expected);
+}
+
+void PixelConversionTest::grayscaleToRgba() {
+    const std::vector<UnsignedByte> in = pixels(Count);
+    std::vector<UnsignedByte> expected(Count*4);
+    for(std::size_t i = 0; i != Count; ++i) {
+        expected[i*4 + 0] = expected[i*4 + 1] = expected[i*4 + 2] = in[i];
+        expected[i*4 + 3] = 255;
+    }
+
+    std::vector<UnsignedByte> out(Count*4);
+    Trade::grayscaleToRgba({in.data(), in.size()}, {out.data(), out.size()});
+    CORRADE_COMPARE(out, expected);
+}
+
+void PixelConversionTest::expandTo16Bit() {
+    std::vector<UnsignedByte> in = pixels(Count);
+    in[0] = 0;
+    in[1] = 255;
+    std::vector<UnsignedShort> expected(Count);
+    for(std::size_t i = 0; i != Count; ++i)
+        expected[i] = UnsignedShort(in[i]*65535/255);
+
+    std::vector<UnsignedShort> out(Count);
+    Trade::expandTo16Bit({in.data(), in.size()}, {out.data(), out.size()});
+    CORRADE_COMPARE(out[0], 0);
+    CORRADE_COMPARE(out[1], 65535);
+    CORRADE_COMPARE(out, expected);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::PixelConversionTest)